@@ -0,0 +1,374 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_ADL_SERIALIZER_HPP
+#define JSONPP_ADL_SERIALIZER_HPP
+
+#include "json_fwd.hpp"
+#include "jsonexception.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jsonpp
+{
+    // A registered data member: its JSON name and a pointer to it
+    template <typename ClassT, typename MemberT>
+    struct json_field
+    {
+        using class_type = ClassT;
+        using member_type = MemberT;
+
+        std::string_view name;
+        MemberT ClassT::* member;
+    };
+
+    template <typename ClassT, typename MemberT>
+    constexpr json_field<ClassT, MemberT> make_json_field(std::string_view name, MemberT ClassT::* member) noexcept
+    {
+        return {name, member};
+    }
+
+    namespace details
+    {
+        // 在不含同名成员的作用域中做 ADL 查找 (adl_serializer 自己的 to_json/from_json 会遮蔽 ADL)
+        namespace adl_lookup
+        {
+            void to_json() = delete;
+            void from_json() = delete;
+            void jsonpp_fields() = delete;
+
+            template <typename JsonT, typename T>
+            auto call_to_json(JsonT& j, T&& value) -> decltype(to_json(j, std::forward<T>(value)))
+            {
+                return to_json(j, std::forward<T>(value));
+            }
+
+            template <typename JsonT, typename T>
+            auto call_from_json(JsonT const& j, T& value) -> decltype(from_json(j, value))
+            {
+                return from_json(j, value);
+            }
+
+            template <typename T>
+            constexpr auto fields_of() -> decltype(jsonpp_fields(static_cast<T const*>(nullptr)))
+            {
+                return jsonpp_fields(static_cast<T const*>(nullptr));
+            }
+        }
+    }
+
+    namespace traits
+    {
+        // Has T registered its members with JSONPP_FIELDS (or an ADL-visible jsonpp_fields(T const*))
+        template <typename T, typename = void>
+        struct has_json_fields : std::false_type {};
+
+        template <typename T>
+        struct has_json_fields<T, std::void_t<decltype(details::adl_lookup::fields_of<T>())>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool has_json_fields_v = has_json_fields<T>::value;
+
+        template <typename T>
+        struct is_optional : std::false_type {};
+
+        template <typename T>
+        struct is_optional<std::optional<T>> : std::true_type {};
+
+        // Associative containers keyed by strings
+        template <typename T, typename = void>
+        struct is_string_map : std::false_type {};
+
+        template <typename T>
+        struct is_string_map<T, std::void_t<typename T::key_type, typename T::mapped_type,
+            decltype(std::declval<T const&>().begin()), decltype(std::declval<T const&>().end())>>
+            : std::is_convertible<typename T::key_type const&, std::string_view> {};
+
+        // Containers with push_back, except strings
+        template <typename T, typename = void>
+        struct is_sequence_container : std::false_type {};
+
+        template <typename T>
+        struct is_sequence_container<T, std::void_t<typename T::value_type,
+            decltype(std::declval<T const&>().begin()), decltype(std::declval<T const&>().end()),
+            decltype(std::declval<T&>().push_back(std::declval<typename T::value_type>()))>>
+            : std::bool_constant<!std::is_convertible_v<T const&, std::string_view>> {};
+
+        template <typename SerializerT, typename JsonT, typename T, typename = void>
+        struct has_to_json : std::false_type {};
+
+        template <typename SerializerT, typename JsonT, typename T>
+        struct has_to_json<SerializerT, JsonT, T, std::void_t<
+            decltype(SerializerT::to_json(std::declval<JsonT&>(), std::declval<T>()))>> : std::true_type {};
+
+        template <typename SerializerT, typename JsonT, typename T>
+        inline constexpr bool has_to_json_v = has_to_json<SerializerT, JsonT, T>::value;
+
+        template <typename SerializerT, typename JsonT, typename T, typename = void>
+        struct has_from_json : std::false_type {};
+
+        template <typename SerializerT, typename JsonT, typename T>
+        struct has_from_json<SerializerT, JsonT, T, std::void_t<
+            decltype(SerializerT::from_json(std::declval<JsonT const&>(), std::declval<T&>()))>> : std::true_type {};
+
+        template <typename SerializerT, typename JsonT, typename T>
+        inline constexpr bool has_from_json_v = has_from_json<SerializerT, JsonT, T>::value;
+    }
+
+    namespace details
+    {
+        enum class SerializerKind : std::uint8_t { adl, fields, optional, map, sequence };
+
+        // 互斥的分类, 保证 adl_serializer 的偏特化不会歧义
+        template <typename T>
+        constexpr SerializerKind serializer_kind() noexcept
+        {
+            if constexpr (traits::has_json_fields_v<T>)
+                return SerializerKind::fields;
+            else if constexpr (traits::is_optional<T>::value)
+                return SerializerKind::optional;
+            else if constexpr (traits::is_string_map<T>::value)
+                return SerializerKind::map;
+            else if constexpr (traits::is_sequence_container<T>::value)
+                return SerializerKind::sequence;
+            else
+                return SerializerKind::adl;
+        }
+
+        template <typename T>
+        inline constexpr SerializerKind serializer_kind_v = serializer_kind<T>();
+    }
+
+    /*
+     * Default JSONSerializer of basic_json: converts T by calling to_json(json&, T const&) and
+     * from_json(json const&, T&) found by argument-dependent lookup. The partial specializations below
+     * handle structs registered with JSONPP_FIELDS, std::optional, string-keyed maps and sequence containers.
+     * Specialize it for types whose namespace you cannot add functions to.
+     */
+    template <typename T, typename SFINAE>
+    struct adl_serializer
+    {
+        template <typename JsonT, typename U>
+        static auto to_json(JsonT& j, U&& value)
+            -> decltype(details::adl_lookup::call_to_json(j, std::forward<U>(value)), void())
+        {
+            details::adl_lookup::call_to_json(j, std::forward<U>(value));
+        }
+
+        template <typename JsonT, typename U>
+        static auto from_json(JsonT const& j, U& value)
+            -> decltype(details::adl_lookup::call_from_json(j, value), void())
+        {
+            details::adl_lookup::call_from_json(j, value);
+        }
+    };
+
+    template <typename T>
+    struct adl_serializer<T, std::enable_if_t<details::serializer_kind_v<T> == details::SerializerKind::fields>>
+    {
+        template <typename JsonT>
+        static void to_json(JsonT& j, T const& value)
+        {
+            typename JsonT::object obj;
+            std::apply([&](auto const&... field)
+            {
+                (obj.emplace(typename JsonT::string(field.name), JsonT(value.*(field.member))), ...);
+            }, details::adl_lookup::fields_of<T>());
+            j = std::move(obj);
+        }
+
+        // 缺失的成员保持原值
+        template <typename JsonT>
+        static void from_json(JsonT const& j, T& value)
+        {
+            if (!j.get_if_object()) // get_if_* 对 raw 节点返回其解析结果中的容器
+                throw JsonTypeError("from_json: expected an object");
+            std::apply([&](auto const&... field)
+            {
+                auto const read = [&](auto const& f)
+                {
+                    if (auto const it = j.find(f.name); it != j.end())
+                        it->get_to(value.*(f.member));
+                };
+                (read(field), ...);
+            }, details::adl_lookup::fields_of<T>());
+        }
+    };
+
+    template <typename T>
+    struct adl_serializer<T, std::enable_if_t<details::serializer_kind_v<T> == details::SerializerKind::optional>>
+    {
+        template <typename JsonT>
+        static void to_json(JsonT& j, T const& value)
+        {
+            j = value ? JsonT(*value) : JsonT(null);
+        }
+
+        template <typename JsonT>
+        static void from_json(JsonT const& j, T& value)
+        {
+            if (j.is_null() || (j.is_raw() && j == JsonT(null)))
+                value.reset();
+            else
+                value = j.template get<typename T::value_type>();
+        }
+    };
+
+    template <typename T>
+    struct adl_serializer<T, std::enable_if_t<details::serializer_kind_v<T> == details::SerializerKind::map>>
+    {
+        template <typename JsonT>
+        static void to_json(JsonT& j, T const& value)
+        {
+            typename JsonT::object obj;
+            for (auto const& [key, item] : value)
+            {
+                std::string_view const name = key;
+                obj.emplace(typename JsonT::string(name), JsonT(item));
+            }
+            j = std::move(obj);
+        }
+
+        template <typename JsonT>
+        static void from_json(JsonT const& j, T& value)
+        {
+            auto const* obj = j.get_if_object();
+            if (!obj)
+                throw JsonTypeError("from_json: expected an object");
+            value.clear();
+            for (auto const& [key, item] : *obj)
+                value.emplace(typename T::key_type(key), item.template get<typename T::mapped_type>());
+        }
+    };
+
+    template <typename T>
+    struct adl_serializer<T, std::enable_if_t<details::serializer_kind_v<T> == details::SerializerKind::sequence>>
+    {
+        template <typename JsonT>
+        static void to_json(JsonT& j, T const& value)
+        {
+            typename JsonT::array arr;
+            for (auto const& item : value)
+                arr.emplace_back(item);
+            j = std::move(arr);
+        }
+
+        template <typename JsonT>
+        static void from_json(JsonT const& j, T& value)
+        {
+            auto const* arr = j.get_if_array();
+            if (!arr)
+                throw JsonTypeError("from_json: expected an array");
+            value.clear();
+            for (auto const& item : *arr)
+                value.push_back(item.template get<typename T::value_type>());
+        }
+    };
+}
+
+/*
+ * Registers the public data members of a struct for adl_serializer and parse_into(); the JSON names are the
+ * member names. Use it at namespace scope, in the namespace of the struct:
+ *
+ *     struct point { double x, y; };
+ *     JSONPP_FIELDS(point, x, y)
+ *
+ * For other names write the function yourself:
+ *     constexpr auto jsonpp_fields(point const*) { return std::make_tuple(jsonpp::make_json_field("X", &point::x)); }
+ */
+#define JSONPP_FIELDS(Type, ...) \
+    [[maybe_unused]] constexpr auto jsonpp_fields(Type const*) \
+    { return std::make_tuple(JSONPP_FOR_EACH_FIELD_(Type, __VA_ARGS__)); }
+
+#define JSONPP_FIELD_(Type, member) ::jsonpp::make_json_field(#member, &Type::member)
+
+// JSONPP_FOR_EACH_FIELD_(Type, a, b, ...) -> JSONPP_FIELD_(Type, a), JSONPP_FIELD_(Type, b), ... (up to 64 members)
+#define JSONPP_EXPAND_(x) x
+#define JSONPP_FE_1_(T, x) JSONPP_FIELD_(T, x)
+#define JSONPP_FE_2_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_1_(T, __VA_ARGS__))
+#define JSONPP_FE_3_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_2_(T, __VA_ARGS__))
+#define JSONPP_FE_4_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_3_(T, __VA_ARGS__))
+#define JSONPP_FE_5_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_4_(T, __VA_ARGS__))
+#define JSONPP_FE_6_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_5_(T, __VA_ARGS__))
+#define JSONPP_FE_7_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_6_(T, __VA_ARGS__))
+#define JSONPP_FE_8_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_7_(T, __VA_ARGS__))
+#define JSONPP_FE_9_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_8_(T, __VA_ARGS__))
+#define JSONPP_FE_10_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_9_(T, __VA_ARGS__))
+#define JSONPP_FE_11_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_10_(T, __VA_ARGS__))
+#define JSONPP_FE_12_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_11_(T, __VA_ARGS__))
+#define JSONPP_FE_13_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_12_(T, __VA_ARGS__))
+#define JSONPP_FE_14_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_13_(T, __VA_ARGS__))
+#define JSONPP_FE_15_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_14_(T, __VA_ARGS__))
+#define JSONPP_FE_16_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_15_(T, __VA_ARGS__))
+#define JSONPP_FE_17_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_16_(T, __VA_ARGS__))
+#define JSONPP_FE_18_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_17_(T, __VA_ARGS__))
+#define JSONPP_FE_19_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_18_(T, __VA_ARGS__))
+#define JSONPP_FE_20_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_19_(T, __VA_ARGS__))
+#define JSONPP_FE_21_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_20_(T, __VA_ARGS__))
+#define JSONPP_FE_22_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_21_(T, __VA_ARGS__))
+#define JSONPP_FE_23_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_22_(T, __VA_ARGS__))
+#define JSONPP_FE_24_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_23_(T, __VA_ARGS__))
+#define JSONPP_FE_25_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_24_(T, __VA_ARGS__))
+#define JSONPP_FE_26_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_25_(T, __VA_ARGS__))
+#define JSONPP_FE_27_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_26_(T, __VA_ARGS__))
+#define JSONPP_FE_28_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_27_(T, __VA_ARGS__))
+#define JSONPP_FE_29_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_28_(T, __VA_ARGS__))
+#define JSONPP_FE_30_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_29_(T, __VA_ARGS__))
+#define JSONPP_FE_31_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_30_(T, __VA_ARGS__))
+#define JSONPP_FE_32_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_31_(T, __VA_ARGS__))
+#define JSONPP_FE_33_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_32_(T, __VA_ARGS__))
+#define JSONPP_FE_34_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_33_(T, __VA_ARGS__))
+#define JSONPP_FE_35_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_34_(T, __VA_ARGS__))
+#define JSONPP_FE_36_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_35_(T, __VA_ARGS__))
+#define JSONPP_FE_37_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_36_(T, __VA_ARGS__))
+#define JSONPP_FE_38_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_37_(T, __VA_ARGS__))
+#define JSONPP_FE_39_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_38_(T, __VA_ARGS__))
+#define JSONPP_FE_40_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_39_(T, __VA_ARGS__))
+#define JSONPP_FE_41_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_40_(T, __VA_ARGS__))
+#define JSONPP_FE_42_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_41_(T, __VA_ARGS__))
+#define JSONPP_FE_43_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_42_(T, __VA_ARGS__))
+#define JSONPP_FE_44_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_43_(T, __VA_ARGS__))
+#define JSONPP_FE_45_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_44_(T, __VA_ARGS__))
+#define JSONPP_FE_46_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_45_(T, __VA_ARGS__))
+#define JSONPP_FE_47_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_46_(T, __VA_ARGS__))
+#define JSONPP_FE_48_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_47_(T, __VA_ARGS__))
+#define JSONPP_FE_49_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_48_(T, __VA_ARGS__))
+#define JSONPP_FE_50_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_49_(T, __VA_ARGS__))
+#define JSONPP_FE_51_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_50_(T, __VA_ARGS__))
+#define JSONPP_FE_52_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_51_(T, __VA_ARGS__))
+#define JSONPP_FE_53_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_52_(T, __VA_ARGS__))
+#define JSONPP_FE_54_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_53_(T, __VA_ARGS__))
+#define JSONPP_FE_55_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_54_(T, __VA_ARGS__))
+#define JSONPP_FE_56_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_55_(T, __VA_ARGS__))
+#define JSONPP_FE_57_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_56_(T, __VA_ARGS__))
+#define JSONPP_FE_58_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_57_(T, __VA_ARGS__))
+#define JSONPP_FE_59_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_58_(T, __VA_ARGS__))
+#define JSONPP_FE_60_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_59_(T, __VA_ARGS__))
+#define JSONPP_FE_61_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_60_(T, __VA_ARGS__))
+#define JSONPP_FE_62_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_61_(T, __VA_ARGS__))
+#define JSONPP_FE_63_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_62_(T, __VA_ARGS__))
+#define JSONPP_FE_64_(T, x, ...) JSONPP_FIELD_(T, x), JSONPP_EXPAND_(JSONPP_FE_63_(T, __VA_ARGS__))
+#define JSONPP_FE_SELECT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, NAME, ...) NAME
+#define JSONPP_FOR_EACH_FIELD_(T, ...) \
+    JSONPP_EXPAND_(JSONPP_FE_SELECT_(__VA_ARGS__, JSONPP_FE_64_, JSONPP_FE_63_, JSONPP_FE_62_, JSONPP_FE_61_, JSONPP_FE_60_, JSONPP_FE_59_, JSONPP_FE_58_, JSONPP_FE_57_, JSONPP_FE_56_, JSONPP_FE_55_, JSONPP_FE_54_, JSONPP_FE_53_, JSONPP_FE_52_, JSONPP_FE_51_, JSONPP_FE_50_, JSONPP_FE_49_, JSONPP_FE_48_, JSONPP_FE_47_, JSONPP_FE_46_, JSONPP_FE_45_, JSONPP_FE_44_, JSONPP_FE_43_, JSONPP_FE_42_, JSONPP_FE_41_, JSONPP_FE_40_, JSONPP_FE_39_, JSONPP_FE_38_, JSONPP_FE_37_, JSONPP_FE_36_, JSONPP_FE_35_, JSONPP_FE_34_, JSONPP_FE_33_, JSONPP_FE_32_, JSONPP_FE_31_, JSONPP_FE_30_, JSONPP_FE_29_, JSONPP_FE_28_, JSONPP_FE_27_, JSONPP_FE_26_, JSONPP_FE_25_, JSONPP_FE_24_, JSONPP_FE_23_, JSONPP_FE_22_, JSONPP_FE_21_, JSONPP_FE_20_, JSONPP_FE_19_, JSONPP_FE_18_, JSONPP_FE_17_, JSONPP_FE_16_, JSONPP_FE_15_, JSONPP_FE_14_, JSONPP_FE_13_, JSONPP_FE_12_, JSONPP_FE_11_, JSONPP_FE_10_, JSONPP_FE_9_, JSONPP_FE_8_, JSONPP_FE_7_, JSONPP_FE_6_, JSONPP_FE_5_, JSONPP_FE_4_, JSONPP_FE_3_, JSONPP_FE_2_, JSONPP_FE_1_)(T, __VA_ARGS__))
+
+#endif //JSONPP_ADL_SERIALIZER_HPP
@@ -19,24 +19,122 @@ limitations under the License.
 #define JSONPP_BASIC_JSON_HPP
 
 #include "json_fwd.hpp"
+#include "adl_serializer.hpp"
 #include "json_serializer.hpp"
+#include "json_parallel_serializer.hpp"
 #include "jsonexception.hpp"
 #include "json_stream_adaptor.hpp"
+#include "json_iterator.hpp"
+#include "json_pointer.hpp"
+#include "source_spans.hpp"
 #include "macro_def.hpp"
 #include "traits.hpp"
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <type_traits>
 #include <cstdint>
+#include <vector>
 
 namespace jsonpp
 {
     namespace details
     {
         struct EmptyBaseClass {};
+
+        /*
+         * A validated but unparsed JSON text fragment (Type::raw). dump() emits the text verbatim;
+         * non-const access parses it into a regular node in place. Const access parses it once into
+         * `parsed`, which is owned by the fragment and dropped when it is copied or assigned.
+         */
+        template <typename StringT, typename JsonT>
+        struct RawJson
+        {
+            StringT text;
+            mutable std::atomic<JsonT*> parsed{nullptr};
+
+            explicit RawJson(StringT t) noexcept: text(std::move(t)) {}
+            RawJson(RawJson const& other): text(other.text) {}
+            RawJson(RawJson&& other) noexcept: text(std::move(other.text)), parsed(other.parsed.exchange(nullptr)) {}
+            RawJson& operator=(RawJson const& other)
+            {
+                if (this != &other)
+                {
+                    text = other.text;
+                    delete parsed.exchange(nullptr);
+                }
+                return *this;
+            }
+            RawJson& operator=(RawJson&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    text = std::move(other.text);
+                    delete parsed.exchange(other.parsed.exchange(nullptr));
+                }
+                return *this;
+            }
+            ~RawJson() { delete parsed.load(std::memory_order_relaxed); }
+
+            bool operator==(RawJson const& other) const { return text == other.text; }
+        };
+
+        struct ParseOptions
+        {
+            // Arrays/objects nested at least this deep (the root is depth 0) are kept as raw fragments; 0 disables
+            std::size_t raw_depth = 0;
+            // Values at these RFC 6901 JSON Pointers (e.g. "/data/payload", "" for the root) are kept as raw fragments
+            std::vector<std::string> raw_paths;
+            // Record where every value starts and ends in the document into *source_spans, for dump_incremental()
+            SourceSpans* source_spans = nullptr;
+        };
+
+        template <typename StreamT, typename JsonT>
+        class Parser;
+        template <typename JsonT, typename SerializeHandlerT>
+        class CborWriter;
+        template <typename JsonT, typename SerializeHandlerT>
+        class MsgpackWriter;
+
+        /*
+         * Hash / equality for unordered objects that accept both the key type and std::string_view,
+         * so lookups by string_view or string literal need no temporary key (C++20 heterogeneous lookup).
+         */
+        struct TransparentStringHash
+        {
+            using is_transparent = void;
+
+            template <typename StringT>
+            std::size_t operator()(StringT const& key) const noexcept
+            {
+                return std::hash<std::string_view>{}(std::string_view(key.data(), key.size()));
+            }
+
+            std::size_t operator()(std::string_view key) const noexcept { return std::hash<std::string_view>{}(key); }
+            std::size_t operator()(PrehashedKey const& key) const noexcept { return key.hash; }
+        };
+
+        struct TransparentStringEqual
+        {
+            using is_transparent = void;
+
+            template <typename L, typename R>
+            bool operator()(L const& lhs, R const& rhs) const noexcept
+            {
+                return std::string_view(lhs.data(), lhs.size()) == std::string_view(rhs.data(), rhs.size());
+            }
+        };
     }
 
+    // Options of basic_json::parse(document, options) and the span table it fills for dump_incremental()
+    using ParseOptions = details::ParseOptions;
+    using SourceSpans = details::SourceSpans;
+    // Options of basic_json::dump_parallel()
+    using ParallelSerializeOptions = details::ParallelSerializeOptions;
+
     enum class Type: std::uint8_t
     {
         empty,
@@ -46,7 +144,8 @@ namespace jsonpp
         number_float,
         string,
         array,
-        object
+        object,
+        raw
     };
 
     BASIC_JSON_TEMPLATE
@@ -56,6 +155,8 @@ namespace jsonpp
         // * Internal Helper Types
         // =============================================================
     private:
+        using _base_t = std::conditional_t<std::is_same_v<CustomBaseClass, void>, details::EmptyBaseClass, CustomBaseClass>;
+
         static constexpr bool _is_std_map =
             traits::details_t::is_std_map_v<ObjectType>;
         static constexpr bool _is_std_unordered_map =
@@ -94,8 +195,8 @@ namespace jsonpp
             // assume it's a std::unordered_map-like container
             using type = ObjectType<StringType,
                                     basic_json,
-                                    std::hash<StringType>,
-                                    std::equal_to<StringType>,
+                                    details::TransparentStringHash,
+                                    details::TransparentStringEqual,
                                     _object_allocator_t>;
         };
 
@@ -109,7 +210,12 @@ namespace jsonpp
         using string = StringType;
         using array = ArrayType<basic_json, AllocatorType<basic_json>>;
         using object = typename _object_type_selector<_is_std_map, _is_std_unordered_map>::type;
+        using raw = details::RawJson<string, basic_json>;
+        using shared_array = details::SharedContainer<array>;
+        using shared_object = details::SharedContainer<object>;
         using json_t = BASIC_JSON_TYPE;
+        template <typename T>
+        using json_serializer = JSONSerializer<T, void>;
         using value_t = std::variant <
             std::monostate,
             null_t,
@@ -118,12 +224,15 @@ namespace jsonpp
             number_float,
             string,
             array,
-            object
+            object,
+            raw,
+            shared_array,  // reported as Type::array
+            shared_object  // reported as Type::object
         >;
 
         // Iterator Support
-        using iterator = null_t;
-        using const_iterator = null_t;
+        using iterator = details::JsonIterator<basic_json, false>;
+        using const_iterator = details::JsonIterator<basic_json, true>;
         using reverse_iterator = std::reverse_iterator<iterator>;
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
@@ -164,37 +273,65 @@ namespace jsonpp
         // Constructor for integral types (including char, which will be treated as an integer)
         template <typename T_Integer,
             std::enable_if_t<std::is_integral_v<T_Integer>, int> = 0>
-        basic_json(T_Integer val): m_value(val) {}
+        basic_json(T_Integer val): m_value(static_cast<number_int>(val)) {}
         basic_json(number_int val): m_value(val) {}
         // Constructor for floating-point types
         template <typename T_Float,
             std::enable_if_t<std::is_floating_point_v<T_Float>, int> = 0>
-        basic_json(T_Float val): m_value(val) {}
+        basic_json(T_Float val): m_value(static_cast<number_float>(val)) {}
         basic_json(number_float val): m_value(val) {}
         basic_json(string val): m_value(std::move(val)) {}
         basic_json(char const* val): m_value(val) {}
         explicit basic_json(std::string_view val): m_value(string(val)) {} // Explicit to prevent expensive, implicit copies from a non-owning string_view.
         basic_json(array val): m_value(std::move(val)) {}
         basic_json(object val): m_value(std::move(val)) {}
+        explicit basic_json(raw val): m_value(std::move(val)) {}
+        // Any other type with a JSONSerializer (to_json found by ADL, JSONPP_FIELDS, containers, std::optional)
+        template <typename T, typename U = std::decay_t<T>,
+            std::enable_if_t<!is_json_value_type<U> && !std::is_same_v<U, basic_json> &&
+                             traits::has_to_json_v<json_serializer<U>, basic_json, T>, int> = 0>
+        basic_json(T&& val) { json_serializer<U>::to_json(*this, std::forward<T>(val)); }
 
         // Copy and move
-        basic_json(basic_json const& other) = default;
-        basic_json(basic_json&& other) noexcept = default;
-        reference operator=(basic_json const& other) = default;
-        reference operator=(basic_json&& other) noexcept = default;
+        // The string hint and the span id describe the value and travel with it.
+        basic_json(basic_json const& other)
+            : _base_t(other), m_value(other.m_value), m_meta(other.load_meta() & VALUE_META) {}
+        basic_json(basic_json&& other) noexcept
+            : _base_t(std::move(static_cast<_base_t&>(other))), m_value(std::move(other.m_value)),
+              m_meta(other.load_meta() & VALUE_META) {}
+        reference operator=(basic_json const& other)
+        {
+            _base_t::operator=(other);
+            m_value = other.m_value;
+            copy_value_hints(other);
+            return *this;
+        }
+        reference operator=(basic_json&& other) noexcept
+        {
+            _base_t::operator=(std::move(static_cast<_base_t&>(other)));
+            m_value = std::move(other.m_value);
+            copy_value_hints(other);
+            return *this;
+        }
 
         // Templated assignment
         template <typename T,
             std::enable_if_t<is_json_value_type<std::decay_t<T>> &&
                             !std::is_same_v<std::decay_t<T>, basic_json>, int> = 0>
-        reference operator=(T&& val) { m_value = std::forward<T>(val); return *this; }
+        reference operator=(T&& val) { invalidate_value_hints(); m_value = std::forward<T>(val); return *this; }
 
         // =============================================================
         //  * Capacity & Property (查询状态)
         //  (新增：size, max_size, capacity, reserve, shrink_to_fit)
         // =============================================================
     public:
-        Type type() const noexcept { return static_cast<Type>(m_value.index()); }
+        Type type() const noexcept
+        {
+            auto const index = m_value.index();
+            if (index >= SHARED_ARRAY_INDEX)
+                return index == SHARED_ARRAY_INDEX ? Type::array : Type::object;
+            return static_cast<Type>(index);
+        }
 
         template <Type T>
         void set_type(bool clear_content = false);
@@ -202,7 +339,7 @@ namespace jsonpp
 
         // State Checkers
         bool empty() const noexcept { return std::holds_alternative<std::monostate>(m_value); }
-        size_type size() const noexcept;       // [New]
+        size_type size() const;                // [New] (raw: parses on first use)
         size_type max_size() const noexcept;   // [New]
         size_type capacity() const;            // [New] (Array only)
 
@@ -217,8 +354,9 @@ namespace jsonpp
         bool is_int() const noexcept { return std::holds_alternative<number_int>(m_value); }
         bool is_float() const noexcept { return std::holds_alternative<number_float>(m_value); }
         bool is_string() const noexcept { return std::holds_alternative<string>(m_value); }
-        bool is_array() const noexcept { return std::holds_alternative<array>(m_value); }
-        bool is_object() const noexcept { return std::holds_alternative<object>(m_value); }
+        bool is_array() const noexcept { return std::holds_alternative<array>(m_value) || std::holds_alternative<shared_array>(m_value); }
+        bool is_object() const noexcept { return std::holds_alternative<object>(m_value) || std::holds_alternative<shared_object>(m_value); }
+        bool is_raw() const noexcept { return std::holds_alternative<raw>(m_value); }
 
         // =============================================================
         //  * Element Access (获取数据)
@@ -230,11 +368,16 @@ namespace jsonpp
         value_type const& operator[](size_type index) const;
         reference at(size_type index);
         value_type const& at(size_type index) const;
-        // Object access
-        reference operator[](std::string const& key);
-        value_type const& operator[](std::string const& key) const;
-        reference at(std::string const& key);
-        value_type const& at(std::string const& key) const;
+        // Object access (keys are taken as string_view: literals and views never build a temporary string)
+        reference operator[](std::string_view key);
+        value_type const& operator[](std::string_view key) const;
+        reference at(std::string_view key);
+        value_type const& at(std::string_view key) const;
+
+        // JSON Pointer (RFC 6901) access; the pointer is parsed once, see json_pointer.hpp
+        reference at(json_pointer const& ptr);
+        const_reference at(json_pointer const& ptr) const;
+        bool contains(json_pointer const& ptr) const;
 
         // [New] Front & Back (Array only)
         reference front();
@@ -244,7 +387,18 @@ namespace jsonpp
 
         // [New] Value with Default (Object only)
         template <typename ValueType>
-        ValueType value(string const& key, ValueType const& default_value) const;
+        ValueType value(std::string_view key, ValueType const& default_value) const;
+        string value(std::string_view key, char const* default_value) const;
+        // default_value if the pointer does not resolve
+        template <typename ValueType>
+        ValueType value(json_pointer const& ptr, ValueType const& default_value) const;
+        string value(json_pointer const& ptr, char const* default_value) const;
+
+        // Conversion to T: JSON value types directly, anything else through JSONSerializer<T>::from_json
+        template <typename T>
+        T get() const { T result{}; get_to(result); return result; }
+        template <typename T>
+        T& get_to(T& out) const;
 
         // =============================================================
         //  * Lookup (Object 查找)
@@ -252,16 +406,17 @@ namespace jsonpp
         // =============================================================
     public:
         // [New] Find
-        iterator find(string const& key);
-        const_iterator find(string const& key) const;
+        iterator find(std::string_view key);
+        const_iterator find(std::string_view key) const;
 
         // [New] Count & Contains
-        size_type count(string const& key) const;
-        bool contains(string const& key) const;
+        size_type count(std::string_view key) const;
+        bool contains(std::string_view key) const;
 
         // =============================================================
         //  * Iterators
-        //  (待实现，先占位)
+        //  Arrays: elements; objects: member values (it.key() for the name); other types: empty range.
+        //  Non-const begin()/end() count as mutable access. Const iteration of a raw node walks its cached parse.
         // =============================================================
     public:
         iterator begin();
@@ -284,8 +439,14 @@ namespace jsonpp
     public:
         // General
         void clear() noexcept;
-        void swap(reference other) noexcept { m_value.swap(other.m_value); }
-        friend void swap(reference lhs, reference rhs) noexcept { lhs.m_value.swap(rhs.m_value); } // for ADL (Argument-Dependent Lookup)
+        void swap(reference other) noexcept
+        {
+            m_value.swap(other.m_value);
+            auto const meta = load_meta();
+            copy_value_hints(other);
+            other.set_value_meta(meta);
+        }
+        friend void swap(reference lhs, reference rhs) noexcept { lhs.swap(rhs); } // for ADL (Argument-Dependent Lookup)
 
         // Array Modifiers
         void push_back(basic_json&& val);
@@ -310,8 +471,9 @@ namespace jsonpp
         auto insert(std::pair<string, basic_json> const& pair);
         auto insert(std::pair<string, basic_json>&& pair);
 
-        // [New] Insert at pos (Array) - Blocked until iterator ready
+        // [New] Insert at pos (Array)
         iterator insert(const_iterator pos, const_reference val);
+        iterator insert(const_iterator pos, basic_json&& val);
 
         // Emplace (Object)
         template <typename... Args>
@@ -321,92 +483,263 @@ namespace jsonpp
 
         // Object/Array Erasure
         // [New] Erase by Key
-        size_type erase(string const& key);
+        size_type erase(std::string_view key);
         // [New] Erase by Index
         void erase(size_type index);
-        // [New] Erase by Iterator - Blocked
+        // [New] Erase by Iterator
         iterator erase(const_iterator pos);
         iterator erase(const_iterator first, const_iterator last);
 
         // Object Merge
-        // [New] Update
+        // [New] Update: copies the members of other into this object (null/empty becomes an object first).
+        // merge_objects merges members that are objects on both sides recursively instead of replacing them.
         void update(const_reference other, bool merge_objects = false);
+        void update(basic_json&& other, bool merge_objects = false); // moves members (and their keys) out of other
         void update(const_iterator first, const_iterator last, bool merge_objects = false);
 
+        // RFC 7396 JSON Merge Patch: null removes a member, objects merge recursively, anything else replaces
+        void merge_patch(const_reference patch);
+        void merge_patch(basic_json&& patch);
+
+        // RFC 6902 JSON Patch (see json_patch.hpp). Applied in place; if any operation fails the
+        // document is rolled back and JsonPatchError is thrown. The rvalue overload moves "value"s out of the patch.
+        void patch(const_reference operations);
+        void patch(basic_json&& operations);
+        // A patch that turns source into target
+        static basic_json diff(const_reference source, const_reference target);
+
         // =============================================================
         //  * Conversions (类型转换)
         // =============================================================
     public:
         // Pointers (Safe)
-        boolean const* get_if_bool() const noexcept { return std::get_if<boolean>(&m_value); }
-        boolean* get_if_bool() noexcept { return std::get_if<boolean>(&m_value); }
+        boolean const* get_if_bool() const { return std::get_if<boolean>(&resolved().m_value); }
+        boolean* get_if_bool() { prepare_mutable_access(); return std::get_if<boolean>(&m_value); }
 
-        number_int const* get_if_int() const noexcept { return std::get_if<number_int>(&m_value); }
-        number_int* get_if_int() noexcept { return std::get_if<number_int>(&m_value); }
+        number_int const* get_if_int() const { return std::get_if<number_int>(&resolved().m_value); }
+        number_int* get_if_int() { prepare_mutable_access(); return std::get_if<number_int>(&m_value); }
 
-        number_float const* get_if_float() const noexcept { return std::get_if<number_float>(&m_value); }
-        number_float* get_if_float() noexcept { return std::get_if<number_float>(&m_value); }
+        number_float const* get_if_float() const { return std::get_if<number_float>(&resolved().m_value); }
+        number_float* get_if_float() { prepare_mutable_access(); return std::get_if<number_float>(&m_value); }
 
-        std::string const* get_if_string() const noexcept { return std::get_if<string>(&m_value); }
-        string* get_if_string() noexcept { return std::get_if<string>(&m_value); }
+        // Mutable access drops the cached serialization hints and hash of this node. Do not keep the
+        // returned pointer/reference across a hash() and modify the value through it afterwards.
+        std::string const* get_if_string() const { return std::get_if<string>(&resolved().m_value); }
+        string* get_if_string() { prepare_mutable_access(); return std::get_if<string>(&m_value); }
 
-        array const* get_if_array() const noexcept { return std::get_if<array>(&m_value); }
-        array* get_if_array() noexcept { return std::get_if<array>(&m_value); }
+        array const* get_if_array() const { return array_storage(); }
+        array* get_if_array() { prepare_mutable_access(); return array_storage(); }
 
-        object const* get_if_object() const noexcept { return std::get_if<object>(&m_value); }
-        object* get_if_object() noexcept { return std::get_if<object>(&m_value); }
+        object const* get_if_object() const { return object_storage(); }
+        object* get_if_object() { prepare_mutable_access(); return object_storage(); }
 
         // References (Asserted)
-        boolean as_bool() const { return as_impl<boolean>(m_value, "bool"); }
-        boolean& as_bool() { return as_impl<boolean>(m_value, "bool"); }
+        boolean as_bool() const { return as_impl<boolean>(resolved().m_value, "bool"); }
+        boolean& as_bool() { prepare_mutable_access(); return as_impl<boolean>(m_value, "bool"); }
 
-        number_int as_int() const { return as_impl<number_int>(m_value, "int64"); }
-        number_int& as_int() { return as_impl<number_int>(m_value, "int64"); }
+        number_int as_int() const { return as_impl<number_int>(resolved().m_value, "int64"); }
+        number_int& as_int() { prepare_mutable_access(); return as_impl<number_int>(m_value, "int64"); }
 
-        number_float as_float() const { return as_impl<number_float>(m_value, "double"); }
-        number_float& as_float() { return as_impl<number_float>(m_value, "double"); }
+        number_float as_float() const { return as_impl<number_float>(resolved().m_value, "double"); }
+        number_float& as_float() { prepare_mutable_access(); return as_impl<number_float>(m_value, "double"); }
 
-        string const& as_string() const { return as_impl<string>(m_value, "string"); }
-        std::string& as_string() { return as_impl<string>(m_value, "string"); }
+        string const& as_string() const { return as_impl<string>(resolved().m_value, "string"); }
+        std::string& as_string() { prepare_mutable_access(); return as_impl<string>(m_value, "string"); }
 
-        array const& as_array() const { return as_impl<array>(m_value, "array"); }
-        array& as_array() { return as_impl<array>(m_value, "array"); }
+        array const& as_array() const { auto const* arr = array_storage(); return arr ? *arr : as_impl<array>(resolved().m_value, "array"); }
+        array& as_array() { prepare_mutable_access(); auto* arr = array_storage(); return arr ? *arr : as_impl<array>(m_value, "array"); }
 
-        object const& as_object() const { return as_impl<object>(m_value, "object"); }
-        object& as_object() { return as_impl<object>(m_value, "object"); }
+        object const& as_object() const { auto const* obj = object_storage(); return obj ? *obj : as_impl<object>(m_value, "object"); }
+        object& as_object() { prepare_mutable_access(); auto* obj = object_storage(); return obj ? *obj : as_impl<object>(m_value, "object"); }
 
         // =============================================================
         //  * Operators & Serialization
         // =============================================================
     public:
+        // Raw fragments
+        // Validates json_text and wraps it without parsing; throws JsonParseError if it is not a single JSON value
+        static basic_json from_raw(std::string_view json_text);
+        // Parses a raw node in place (no-op for other types); non-const accessors do this implicitly.
+        // Const accessors (as_array() const, size(), begin() const, ...) read a parse cached in the raw node;
+        // type() and the is_*() checks still report Type::raw.
+        void materialize();
+        // Value of a raw node parsed into a new basic_json; a copy of *this for other types
+        basic_json materialized() const;
+
+        // Copy-on-write sharing
+        // Moves every array and object of this subtree into reference-counted storage. Copies of shared
+        // values are O(1); a mutable access clones only the containers on the path to the change, one level
+        // at a time. Containers added afterwards are stored inline until share() is called again.
+        // As with any mutable access, do not keep a reference obtained before copying the value and write through it afterwards.
+        reference share();
+        bool is_shared() const noexcept { return m_value.index() >= SHARED_ARRAY_INDEX; }
+        // True if both values refer to the same shared container
+        bool shares_storage_with(const_reference other) const noexcept;
+        // share()s the subtree and makes equal arrays/objects within it use one container
+        reference deduplicate();
+
+        // Structural hash: equal values hash equally; object members are combined order-insensitively.
+        // Computed on every call: a cached value could not see writes through a reference obtained earlier.
+        std::size_t hash() const;
+
         bool operator==(const_reference other) const;
         bool operator!=(const_reference other) const { return !(*this == other); }
 
         static basic_json parse(std::string_view json_doc);
+        static basic_json parse(std::string_view json_doc, ParseOptions const& options);
         static basic_json parse(std::istream& json_istream);
         template <typename StreamT,
             std::enable_if_t<traits::is_json_stream_v<StreamT>, int> = 0>
         static basic_json parse(StreamT& stream);
 
+        // Appends to buffer, which grows geometrically; call buffer.reserve(serialized_size()) first for a single exact allocation.
+        // Documents estimated above ParallelSerializeOptions::min_parallel_bytes are serialized on several threads.
         void dump(std::string& buffer, bool pretty = false, std::string_view indent = "\t") const;
         void dump(std::ostream& os, bool pretty = false, std::string_view indent = "\t") const;
         template <typename SerializeHandlerT,
             std::enable_if_t<traits::is_json_serialize_handler_v<SerializeHandlerT>, int> = 0>
-        void dump(SerializeHandlerT& handler, bool pretty = false, std::string_view indent = "\t");
+        void dump(SerializeHandlerT& handler, bool pretty = false, std::string_view indent = "\t") const;
+
+        // Exact length of the output dump() would produce with the same arguments
+        size_type serialized_size(bool pretty = false, std::string_view indent = "\t") const;
+
+        // dump(buffer) with explicit thread count and size threshold; dump(buffer) itself switches to this for large documents
+        void dump_parallel(std::string& buffer, bool pretty = false, std::string_view indent = "\t",
+                           ParallelSerializeOptions const& options = {}) const;
+
+        /*
+         * Incremental re-serialization. For a document parsed from `source` with ParseOptions::source_spans = &spans,
+         * every node not accessed mutably since parse is copied from its byte range in `source`; only the changed
+         * nodes (and the containers on the way down to them) are serialized again, in the style given by `pretty`.
+         * Any non-const access counts as a change, even one that only reads. Nodes whose span is not in `spans`
+         * (new values, values copied from other documents) are serialized normally. `source` must be the exact
+         * text `spans` was recorded from.
+         */
+        void dump_incremental(std::string& buffer, std::string_view source, SourceSpans const& spans,
+                              bool pretty = false, std::string_view indent = "\t") const;
+        template <typename SerializeHandlerT,
+            std::enable_if_t<traits::is_json_serialize_handler_v<SerializeHandlerT>, int> = 0>
+        void dump_incremental(SerializeHandlerT& handler, std::string_view source, SourceSpans const& spans,
+                              bool pretty = false, std::string_view indent = "\t") const;
 
         std::string stringify() const;
         std::string pretty(std::string_view indent = "\t") const;
 
+        // CBOR (RFC 8949)
+        void to_cbor(std::string& buffer) const;
+        template <typename SerializeHandlerT,
+            std::enable_if_t<traits::is_json_serialize_handler_v<SerializeHandlerT>, int> = 0>
+        void to_cbor(SerializeHandlerT& handler) const;
+        std::string to_cbor() const;
+
+        static basic_json from_cbor(std::string_view data);
+        static basic_json from_cbor(std::uint8_t const* data, std::size_t size);
+        static basic_json from_cbor(std::istream& is);
+        template <typename StreamT,
+            std::enable_if_t<traits::is_json_stream_v<StreamT>, int> = 0>
+        static basic_json from_cbor(StreamT& stream);
+
+        // Memory-mappable snapshot, read back with snapshot_view (see json_snapshot.hpp)
+        void to_snapshot(std::string& buffer) const;
+        std::string to_snapshot() const;
+
+        // MessagePack; use msgpack_reader for a sequence of concatenated messages
+        void to_msgpack(std::string& buffer) const;
+        template <typename SerializeHandlerT,
+            std::enable_if_t<traits::is_json_serialize_handler_v<SerializeHandlerT>, int> = 0>
+        void to_msgpack(SerializeHandlerT& handler) const;
+        std::string to_msgpack() const;
+
+        static basic_json from_msgpack(std::string_view data);
+        static basic_json from_msgpack(std::uint8_t const* data, std::size_t size);
+        static basic_json from_msgpack(std::istream& is);
+        template <typename StreamT,
+            std::enable_if_t<traits::is_json_stream_v<StreamT>, int> = 0>
+        static basic_json from_msgpack(StreamT& stream);
+
         // =============================================================
         //  * Private Implementation
         // =============================================================
     private:
         template <typename JsonT, typename SerializeHandlerT>
         friend class details::JsonSerializer;
+        template <typename StreamT, typename JsonT>
+        friend class details::Parser;
+        template <typename JsonT, bool IsConst>
+        friend class details::JsonIterator;
+        template <typename JsonT>
+        friend class details::ParallelJsonSerializer;
+        template <typename JsonT, typename SerializeHandlerT>
+        friend class details::CborWriter;
+        template <typename JsonT, typename SerializeHandlerT>
+        friend class details::MsgpackWriter;
 
     private:
         value_t m_value;
 
+        /*
+         * Cached per-node metadata.
+         * HINT_STRING_CLEAN: the string value contains no character that needs escaping. Only set by the parser, before any
+         * reference to the value can exist, so a retained reference cannot make it stale.
+         * Keys carry no hint: a node handle (extract/insert) can change the key a node is stored under.
+         * The low 8 bits of m_meta hold the hints; the high 56 bits hold the id of the value's span in a SourceSpans
+         * table (0: none), only written by the parser. The value hints and the span id travel with the value on
+         * copy/move/swap.
+         * Every non-const accessor drops the value hints and the span id, since the value may change through the result.
+         * Atomic so that concurrent reads of the same const document are race-free.
+         */
+        static constexpr std::uint8_t HINT_STRING_CLEAN = 1;
+        static constexpr std::uint8_t VALUE_HINTS = HINT_STRING_CLEAN;
+        static constexpr unsigned SPAN_ID_SHIFT = 8;
+        static constexpr std::uint64_t VALUE_META = VALUE_HINTS | ~std::uint64_t(0xff);
+        mutable std::atomic<std::uint64_t> m_meta{0};
+
+        std::uint64_t load_meta() const noexcept { return m_meta.load(std::memory_order_acquire); }
+        std::uint8_t load_hints() const noexcept { return static_cast<std::uint8_t>(load_meta()); }
+        bool has_hint(std::uint8_t hint) const noexcept { return (load_hints() & hint) != 0; }
+        void add_hint(std::uint8_t hint) const noexcept { m_meta.fetch_or(hint, std::memory_order_release); }
+
+        void set_value_meta(std::uint64_t meta) noexcept
+        {
+            m_meta.store((load_meta() & ~VALUE_META) | (meta & VALUE_META), std::memory_order_release);
+        }
+
+        void copy_value_hints(basic_json const& other) noexcept { set_value_meta(other.load_meta()); }
+
+        std::uint64_t span_id() const noexcept { return load_meta() >> SPAN_ID_SHIFT; }
+        void set_span_id(std::uint64_t id) noexcept // id <= SourceSpans::MAX_ID
+        {
+            m_meta.store((load_meta() & 0xff) | (id << SPAN_ID_SHIFT), std::memory_order_release);
+        }
+
+        // Every non-const accessor: the value may change through the returned reference
+        void prepare_mutable_access()
+        {
+            if (is_raw())
+                materialize();
+            else if (m_value.index() >= SHARED_ARRAY_INDEX)
+                unshare();
+            invalidate_value_hints();
+        }
+
+        void invalidate_value_hints() noexcept
+        {
+            // 非 const 访问由调用者保证独占, 只在需要时写入, 避免每次访问都产生原子读改写
+            auto const meta = load_meta();
+            if (meta & VALUE_META)
+                m_meta.store(meta & ~VALUE_META, std::memory_order_relaxed);
+        }
+
+        // The parsed value of a raw node, parsed on first use and cached in it; *this for other types.
+        // The text was validated when the node was created, so only allocation can fail here; the getters that
+        // reach it (size(), get_if_*(), const container access) are therefore not noexcept.
+        basic_json const& resolved() const;
+
+        std::uint64_t hash64() const;
+        // hash64() of this node, given the hashes of its children (child_hash(child) -> std::uint64_t)
+        template <typename ChildHashT>
+        std::uint64_t hash_with(ChildHashT&& child_hash) const;
+
     private:
         // [To Implement] 必须存储 Allocator 实例，否则无法支持 Stateful Allocator
         // [[no_unique_address]] AllocatorType m_allocator = AllocatorType();
@@ -421,6 +754,42 @@ namespace jsonpp
         template <typename T>
         static T& as_impl(value_t& v, char const* typeName);
 
+        // Key lookup without materializing a key string where the container allows it
+        template <typename ObjectT>
+        static auto find_key(ObjectT& obj, std::string_view key) -> decltype(obj.find(std::declval<string const&>()));
+
+        template <typename ObjectT>
+        static auto find_key(ObjectT& obj, details::PrehashedKey const& key) -> decltype(obj.find(std::declval<string const&>()));
+
+        // Walks ptr from root; nullptr (or an exception if required) when it does not resolve.
+        // JsonRef is basic_json (mutable access along the path) or basic_json const.
+        template <typename JsonRef>
+        static JsonRef* resolve_pointer(JsonRef& root, json_pointer const& ptr, bool required);
+
+        template <typename ValueType>
+        static ValueType value_as(basic_json const& v);
+
+        static constexpr std::size_t SHARED_ARRAY_INDEX = 9;
+        static constexpr std::size_t SHARED_OBJECT_INDEX = 10;
+        static_assert(std::is_same_v<std::variant_alternative_t<SHARED_ARRAY_INDEX, value_t>, shared_array>);
+        static_assert(std::is_same_v<std::variant_alternative_t<SHARED_OBJECT_INDEX, value_t>, shared_object>);
+
+        // The container of an array/object node, inline or shared. The non-const overloads do not unshare:
+        // call them only after prepare_mutable_access()
+        array const* array_storage() const;
+        array* array_storage();
+        object const* object_storage() const;
+        object* object_storage();
+
+        // Clones shared storage that other values still reference
+        void unshare();
+
+        // Returns the hash of the node, computed bottom-up together with the merging
+        template <typename TableT>
+        std::uint64_t deduplicate_impl(TableT& seen);
+
+        static void update_member(object& obj, string const& key, basic_json const& value, bool merge_objects);
+
         template <typename T>
         static T const& as_impl(value_t const& v, char const* typeName);
 
@@ -437,4 +806,13 @@ namespace jsonpp
 
 } // namespace jsonpp
 
+namespace std
+{
+    BASIC_JSON_TEMPLATE
+    struct hash<jsonpp::BASIC_JSON_TYPE>
+    {
+        std::size_t operator()(jsonpp::BASIC_JSON_TYPE const& j) const { return j.hash(); }
+    };
+}
+
 #endif //JSONPP_BASIC_JSON_HPP
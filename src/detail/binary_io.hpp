@@ -0,0 +1,227 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_BINARY_IO_HPP
+#define JSONPP_BINARY_IO_HPP
+
+#include "macro_def.hpp"
+#include "traits.hpp"
+#include "jsonexception.hpp"
+#include "parser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace jsonpp::details
+{
+    /*
+     * Helpers shared by the binary formats (CBOR, MessagePack)
+     */
+    template <typename ToT, typename FromT>
+    ToT bit_cast(FromT const& from) noexcept
+    {
+        static_assert(sizeof(ToT) == sizeof(FromT));
+        ToT to;
+        std::memcpy(&to, &from, sizeof(ToT));
+        return to;
+    }
+
+    template <typename UIntT, typename SerializeHandlerT>
+    void write_big_endian(SerializeHandlerT& sh, UIntT value)
+    {
+        char buf[sizeof(UIntT)];
+        for (std::size_t i = 0; i < sizeof(UIntT); ++i)
+            buf[i] = static_cast<char>(value >> (8 * (sizeof(UIntT) - 1 - i)));
+        sh.append(buf, sizeof(UIntT));
+    }
+
+    // 从内存中读取 Size 字节的无符号整数; 移位写法会被编译器合并为一次加载 (必要时加字节交换)
+    template <std::size_t Size>
+    std::uint64_t load_uint(char const* p, bool little_endian) noexcept
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < Size; ++i)
+        {
+            auto const byte = static_cast<unsigned char>(p[little_endian ? Size - 1 - i : i]);
+            value = (value << 8) | byte;
+        }
+        return value;
+    }
+
+    // IEEE 754 binary16 -> double
+    inline double half_to_double(std::uint16_t half) noexcept
+    {
+        int const exponent = (half >> 10) & 0x1F;
+        int const mantissa = half & 0x3FF;
+        double value;
+        if (exponent == 0)
+            value = std::ldexp(mantissa, -24);
+        else if (exponent != 31)
+            value = std::ldexp(mantissa + 1024, exponent - 25);
+        else
+            value = mantissa == 0 ? HUGE_VAL : std::nan("");
+        return (half & 0x8000) ? -value : value;
+    }
+
+    // RFC 4648 base64url without padding: the JSON form of binary data (RFC 8949 section 6.1)
+    template <typename StringT>
+    StringT base64url_encode(std::string_view bytes)
+    {
+        static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        StringT out;
+        out.reserve((bytes.size() * 4 + 2) / 3);
+        std::size_t i = 0;
+        for (; i + 2 < bytes.size(); i += 3)
+        {
+            std::uint32_t const n = (std::uint32_t(std::uint8_t(bytes[i])) << 16)
+                | (std::uint32_t(std::uint8_t(bytes[i + 1])) << 8) | std::uint8_t(bytes[i + 2]);
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            out += alphabet[(n >> 6) & 63];
+            out += alphabet[n & 63];
+        }
+        if (i < bytes.size())
+        {
+            std::uint32_t n = std::uint32_t(std::uint8_t(bytes[i])) << 16;
+            if (i + 1 < bytes.size())
+                n |= std::uint32_t(std::uint8_t(bytes[i + 1])) << 8;
+            out += alphabet[(n >> 18) & 63];
+            out += alphabet[(n >> 12) & 63];
+            if (i + 1 < bytes.size())
+                out += alphabet[(n >> 6) & 63];
+        }
+        return out;
+    }
+
+    /*
+     * Byte-level input for the binary parsers. Contiguous streams read multi-byte fields
+     * and payloads straight from the buffer instead of byte by byte.
+     */
+    template <typename StreamT>
+    class BinaryParserBase : public ParserBase<StreamT>
+    {
+    protected:
+        JSONPP_IMPORT_PARSERBASE_MEMBERS_
+
+        char const* m_format; // 用于错误信息, 如 "CBOR"
+        int m_nesting_depth = 0;
+
+        [[noreturn]] void fail(char const* message, std::size_t pos) const
+        {
+            throw JsonParseError(std::string(m_format) + ": " + message, pos);
+        }
+
+        void enter()
+        {
+            if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                throw JsonDepthLimitExceeded(tell_pos());
+        }
+        void leave() noexcept { --m_nesting_depth; }
+
+        // Upper bound of the bytes left, used to reject impossible lengths before allocating
+        std::size_t remaining() const
+        {
+            if constexpr (is_sized_stream_v<StreamT>)
+                return size() - tell_pos();
+            else
+                return static_cast<std::size_t>(-1);
+        }
+
+        // Capacity to reserve for `count` declared items: the declared count of an unsized stream is not checked
+        // against the input, so only a bounded amount is reserved up front and the rest grows as items arrive
+        std::size_t reserve_size(std::size_t count) const noexcept
+        {
+            if constexpr (is_sized_stream_v<StreamT>)
+                return count;
+            else
+                return std::min<std::size_t>(count, 4096);
+        }
+
+        std::uint8_t read_byte()
+        {
+            if (eof())
+                fail("unexpected end of input", tell_pos());
+            return static_cast<std::uint8_t>(advance());
+        }
+
+        template <typename UIntT>
+        UIntT read_big_endian()
+        {
+            if constexpr (is_contiguous_stream_v<StreamT>)
+            {
+                if (remaining() < sizeof(UIntT))
+                    fail("unexpected end of input", tell_pos());
+                auto const chunk = get_chunk(tell_pos(), sizeof(UIntT));
+                seek(sizeof(UIntT));
+                return static_cast<UIntT>(load_uint<sizeof(UIntT)>(chunk.data(), false));
+            }
+            else
+            {
+                UIntT value = 0;
+                for (std::size_t i = 0; i < sizeof(UIntT); ++i)
+                    value = static_cast<UIntT>((value << 8) | read_byte());
+                return value;
+            }
+        }
+
+        // Appends the next `length` bytes to `out`
+        template <typename StringT>
+        void read_bytes(std::size_t length, StringT& out)
+        {
+            if (length > remaining())
+                fail("unexpected end of input", tell_pos());
+            if constexpr (is_contiguous_stream_v<StreamT>)
+            {
+                out.append(get_chunk(tell_pos(), length));
+                seek(length);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < length; ++i)
+                    out += static_cast<char>(read_byte());
+            }
+        }
+
+        // View of the next `length` bytes; contiguous streams return the input itself, others copy into `storage`
+        std::string_view read_view(std::size_t length, std::string& storage)
+        {
+            if constexpr (is_contiguous_stream_v<StreamT>)
+            {
+                if (length > remaining())
+                    fail("unexpected end of input", tell_pos());
+                auto const chunk = get_chunk(tell_pos(), length);
+                seek(length);
+                return chunk;
+            }
+            else
+            {
+                storage.clear();
+                read_bytes(length, storage);
+                return storage;
+            }
+        }
+
+        BinaryParserBase(StreamT& stream, char const* format): ParserBase<StreamT>(stream), m_format(format) {}
+    };
+}
+
+#endif //JSONPP_BINARY_IO_HPP
@@ -0,0 +1,445 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_CBOR_HPP
+#define JSONPP_CBOR_HPP
+
+#include "basic_json.hpp"
+#include "binary_io.hpp"
+#include "traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace jsonpp::details
+{
+    /*
+     * CBOR (RFC 8949) encoder. Integers and lengths use the shortest head, floats are written
+     * as single precision when that is exact. An empty basic_json is encoded as null.
+     */
+    template <typename JsonT, typename SerializeHandlerT>
+    class CborWriter
+    {
+        static_assert(traits::is_json_serialize_handler_v<SerializeHandlerT>, "SerializeHandlerT should be a JSON Serialize Handler.");
+
+        using number_int = typename JsonT::number_int;
+
+        SerializeHandlerT& m_sh;
+
+        void write_head(std::uint8_t major, std::uint64_t argument)
+        {
+            auto const initial = static_cast<std::uint8_t>(major << 5);
+            if (argument < 24)
+                m_sh.append(static_cast<char>(initial | argument));
+            else if (argument <= 0xFF)
+            {
+                m_sh.append(static_cast<char>(initial | 24));
+                m_sh.append(static_cast<char>(argument));
+            }
+            else if (argument <= 0xFFFF)
+            {
+                m_sh.append(static_cast<char>(initial | 25));
+                write_big_endian(m_sh, static_cast<std::uint16_t>(argument));
+            }
+            else if (argument <= 0xFFFFFFFF)
+            {
+                m_sh.append(static_cast<char>(initial | 26));
+                write_big_endian(m_sh, static_cast<std::uint32_t>(argument));
+            }
+            else
+            {
+                m_sh.append(static_cast<char>(initial | 27));
+                write_big_endian(m_sh, argument);
+            }
+        }
+
+        void write_string(std::string_view str)
+        {
+            write_head(3, str.size());
+            if constexpr (traits::is_zero_copy_serialize_handler_v<SerializeHandlerT>)
+                m_sh.append_reference(str.data(), str.size());
+            else
+                m_sh.append(str.data(), str.size());
+        }
+
+    public:
+        explicit CborWriter(SerializeHandlerT& handler): m_sh(handler) {}
+
+        void write(JsonT const& json)
+        {
+            switch (json.type())
+            {
+            case Type::empty:
+            case Type::null:
+                m_sh.append(static_cast<char>(0xF6));
+                break;
+            case Type::boolean:
+                m_sh.append(static_cast<char>(json.as_bool() ? 0xF5 : 0xF4));
+                break;
+            case Type::number_int:
+                {
+                    auto const value = json.as_int();
+                    if constexpr (std::is_signed_v<number_int>)
+                    {
+                        if (value < 0)
+                        {
+                            write_head(1, static_cast<std::uint64_t>(-1 - static_cast<std::int64_t>(value)));
+                            break;
+                        }
+                    }
+                    write_head(0, static_cast<std::uint64_t>(value));
+                    break;
+                }
+            case Type::number_float:
+                {
+                    auto const value = static_cast<double>(json.as_float());
+                    auto const single = static_cast<float>(value);
+                    if (static_cast<double>(single) == value || value != value) // 可无损表示为单精度 (或 NaN)
+                    {
+                        m_sh.append(static_cast<char>(0xFA));
+                        write_big_endian(m_sh, bit_cast<std::uint32_t>(single));
+                    }
+                    else
+                    {
+                        m_sh.append(static_cast<char>(0xFB));
+                        write_big_endian(m_sh, bit_cast<std::uint64_t>(value));
+                    }
+                    break;
+                }
+            case Type::string:
+                write_string(json.as_string());
+                break;
+            case Type::array:
+                {
+                    auto const& arr = json.as_array();
+                    write_head(4, arr.size());
+                    for (auto const& item : arr)
+                        write(item);
+                    break;
+                }
+            case Type::object:
+                {
+                    auto const& obj = json.as_object();
+                    write_head(5, obj.size());
+                    for (auto const& [key, value] : obj)
+                    {
+                        write_string(key);
+                        write(value);
+                    }
+                    break;
+                }
+            case Type::raw:
+                write(json.resolved()); // 解析结果缓存在节点中, 零拷贝输出引用的字符串与节点同寿命
+                break;
+            }
+        }
+    }; // class CborWriter
+
+    /*
+     * CBOR (RFC 8949) decoder producing a basic_json, following the CBOR-to-JSON rules of RFC 8949 section 6.1:
+     * undefined becomes null, byte strings become base64url strings and unknown tags are ignored.
+     * Typed arrays (RFC 8746, tags 64-86) are decoded in one pass over their payload into arrays of numbers.
+     * Integers outside the range of number_int become number_float.
+     */
+    template <typename StreamT, typename JsonT>
+    class CborParser : public BinaryParserBase<StreamT>
+    {
+    protected:
+        using ParserBase<StreamT>::peek;
+        using ParserBase<StreamT>::advance;
+        using ParserBase<StreamT>::tell_pos;
+        using ParserBase<StreamT>::eof;
+        using BinaryParserBase<StreamT>::fail;
+        using BinaryParserBase<StreamT>::enter;
+        using BinaryParserBase<StreamT>::leave;
+        using BinaryParserBase<StreamT>::remaining;
+        using BinaryParserBase<StreamT>::reserve_size;
+        using BinaryParserBase<StreamT>::read_byte;
+        using BinaryParserBase<StreamT>::read_bytes;
+        using BinaryParserBase<StreamT>::read_view;
+
+        using number_int = typename JsonT::number_int;
+        using number_float = typename JsonT::number_float;
+        using string = typename JsonT::string;
+        using array = typename JsonT::array;
+        using object = typename JsonT::object;
+
+        static constexpr std::uint8_t INDEFINITE = 31;
+        static constexpr int BREAK = 0xFF;
+
+    private:
+        std::string m_scratch; // 非连续流中类型化数组的临时缓冲
+
+        std::uint64_t read_argument(std::uint8_t additional, std::size_t start)
+        {
+            if (additional < 24)
+                return additional;
+            switch (additional)
+            {
+            case 24: return read_byte();
+            case 25: return this->template read_big_endian<std::uint16_t>();
+            case 26: return this->template read_big_endian<std::uint32_t>();
+            case 27: return this->template read_big_endian<std::uint64_t>();
+            default: fail("malformed initial byte", start);
+            }
+        }
+
+        std::size_t read_length(std::uint8_t additional, std::size_t start, std::size_t min_item_size)
+        {
+            auto const length = read_argument(additional, start);
+            if (length > remaining() / min_item_size)
+                fail("length exceeds the remaining input", start);
+            return static_cast<std::size_t>(length);
+        }
+
+        static JsonT make_integer(std::uint64_t magnitude, bool negative)
+        {
+            if constexpr (!std::is_signed_v<number_int>)
+            {
+                if (negative) // 无符号的 number_int 无法表示负数, 不静默回绕
+                    throw JsonOutOfRange(JsonOutOfRange::CBOR_NEGATIVE_MESSAGE);
+            }
+            constexpr auto max = static_cast<std::uint64_t>(std::numeric_limits<number_int>::max());
+            if (magnitude <= max)
+                return JsonT(negative ? static_cast<number_int>(-1 - static_cast<number_int>(magnitude))
+                                      : static_cast<number_int>(magnitude));
+            // 超出 number_int 的范围, 与文本解析器一样退化为浮点数
+            return JsonT(negative ? -1.0 - static_cast<number_float>(magnitude) : static_cast<number_float>(magnitude));
+        }
+
+        // Text (major 3) or byte (major 2) string contents, including indefinite-length chunks
+        void read_string_payload(std::uint8_t major, std::uint8_t additional, std::size_t start, string& out)
+        {
+            if (additional != INDEFINITE)
+                return read_bytes(read_length(additional, start, 1), out);
+
+            while (peek() != BREAK)
+            {
+                auto const chunk_start = tell_pos();
+                auto const initial = read_byte();
+                if ((initial >> 5) != major || (initial & 0x1F) == INDEFINITE)
+                    fail("invalid chunk in indefinite-length string", chunk_start);
+                read_bytes(read_length(initial & 0x1F, chunk_start, 1), out);
+            }
+            advance(); // 跳过 break
+        }
+
+        template <std::size_t Size>
+        static void decode_elements(std::string_view payload, bool is_float, bool is_signed, bool little_endian, array& out)
+        {
+            for (std::size_t pos = 0; pos < payload.size(); pos += Size)
+            {
+                std::uint64_t const bits = load_uint<Size>(payload.data() + pos, little_endian);
+                if (is_float)
+                {
+                    if constexpr (Size == 2)
+                        out.emplace_back(half_to_double(static_cast<std::uint16_t>(bits)));
+                    else if constexpr (Size == 4)
+                        out.emplace_back(static_cast<number_float>(bit_cast<float>(static_cast<std::uint32_t>(bits))));
+                    else if constexpr (Size == 8)
+                        out.emplace_back(static_cast<number_float>(bit_cast<double>(bits)));
+                }
+                else if (is_signed)
+                {
+                    constexpr unsigned shift = 64 - 8 * Size;
+                    auto const value = static_cast<std::int64_t>(bits << shift) >> shift;
+                    if constexpr (std::is_signed_v<number_int>)
+                        out.emplace_back(static_cast<number_int>(value));
+                    else
+                        out.push_back(make_integer(value < 0 ? static_cast<std::uint64_t>(-1 - value) : static_cast<std::uint64_t>(value), value < 0));
+                }
+                else
+                    out.push_back(make_integer(bits, false));
+            }
+        }
+
+        // RFC 8746 typed array: tag 64 + (float << 4) + (signed << 3) + (little_endian << 2) + size code
+        bool is_typed_array_tag(std::uint64_t tag) const noexcept
+        {
+            return tag >= 64 && tag <= 86 && tag != 76 && tag != 83; // 76: 保留, 83/87: binary128 无法表示
+        }
+
+        JsonT read_typed_array(std::uint64_t tag, std::size_t start)
+        {
+            auto const initial = read_byte();
+            if ((initial >> 5) != 2 || (initial & 0x1F) == INDEFINITE)
+                fail("typed array tag must enclose a definite-length byte string", start);
+
+            bool const is_float = (tag & 0x10) != 0;
+            bool const is_signed = !is_float && (tag & 0x08) != 0;
+            bool const little_endian = (tag & 0x04) != 0; // 对单字节元素无意义 (68: uint8, clamped)
+            std::size_t const element_size = is_float ? std::size_t(2) << (tag & 3) : std::size_t(1) << (tag & 3);
+
+            std::size_t const length = read_length(initial & 0x1F, start, 1);
+            if (length % element_size != 0)
+                fail("typed array length is not a multiple of its element size", start);
+            std::string_view const payload = read_view(length, m_scratch);
+
+            array arr;
+            arr.reserve(length / element_size);
+            switch (element_size)
+            {
+            case 1: decode_elements<1>(payload, is_float, is_signed, little_endian, arr); break;
+            case 2: decode_elements<2>(payload, is_float, is_signed, little_endian, arr); break;
+            case 4: decode_elements<4>(payload, is_float, is_signed, little_endian, arr); break;
+            default: decode_elements<8>(payload, is_float, is_signed, little_endian, arr); break;
+            }
+            return {std::move(arr)};
+        }
+
+        JsonT read_array(std::uint8_t additional, std::size_t start)
+        {
+            enter();
+            array arr;
+            if (additional == INDEFINITE)
+            {
+                while (peek() != BREAK)
+                    arr.push_back(parse_item());
+                advance();
+            }
+            else
+            {
+                std::size_t const length = read_length(additional, start, 1);
+                arr.reserve(reserve_size(length));
+                for (std::size_t i = 0; i < length; ++i)
+                    arr.push_back(parse_item());
+            }
+            leave();
+            return {std::move(arr)};
+        }
+
+        void read_member(object& obj)
+        {
+            auto const key_start = tell_pos();
+            auto const initial = read_byte();
+            if ((initial >> 5) != 3)
+                fail("map keys must be text strings", key_start);
+            string key;
+            read_string_payload(3, initial & 0x1F, key_start, key);
+            obj[std::move(key)] = parse_item();
+        }
+
+        JsonT read_map(std::uint8_t additional, std::size_t start)
+        {
+            enter();
+            object obj;
+            if (additional == INDEFINITE)
+            {
+                while (peek() != BREAK)
+                    read_member(obj);
+                advance();
+            }
+            else
+            {
+                std::size_t const length = read_length(additional, start, 2);
+                for (std::size_t i = 0; i < length; ++i)
+                    read_member(obj);
+            }
+            leave();
+            return {std::move(obj)};
+        }
+
+        JsonT read_simple(std::uint8_t additional, std::size_t start)
+        {
+            if (additional < 20)
+                return {null}; // 未分配的简单值: RFC 8949 §6.1 转换为 null
+            switch (additional)
+            {
+            case 20: return JsonT(false);
+            case 21: return JsonT(true);
+            case 22: // null
+            case 23: // undefined
+                return {null};
+            case 24:
+                if (read_byte() < 32) // 0~31 必须用单字节编码 (RFC 8949 §3.3)
+                    fail("malformed simple value", start);
+                return {null};
+            case 25: return JsonT(static_cast<number_float>(half_to_double(this->template read_big_endian<std::uint16_t>())));
+            case 26: return JsonT(static_cast<number_float>(bit_cast<float>(this->template read_big_endian<std::uint32_t>())));
+            case 27: return JsonT(static_cast<number_float>(bit_cast<double>(this->template read_big_endian<std::uint64_t>())));
+            case INDEFINITE: fail("unexpected break", start);
+            default: fail("malformed initial byte", start); // 28~30 保留
+            }
+        }
+
+        JsonT parse_item()
+        {
+            auto const start = tell_pos();
+            auto const initial = read_byte();
+            std::uint8_t const major = initial >> 5;
+            std::uint8_t const additional = initial & 0x1F;
+
+            switch (major)
+            {
+            case 0:
+            case 1:
+                if (additional == INDEFINITE)
+                    fail("malformed initial byte", start);
+                return make_integer(read_argument(additional, start), major == 1);
+            case 2:
+                {
+                    string bytes;
+                    read_string_payload(2, additional, start, bytes);
+                    return JsonT(base64url_encode<string>(bytes));
+                }
+            case 3:
+                {
+                    string text;
+                    read_string_payload(3, additional, start, text);
+                    return JsonT(std::move(text));
+                }
+            case 4:
+                return read_array(additional, start);
+            case 5:
+                return read_map(additional, start);
+            case 6:
+                {
+                    if (additional == INDEFINITE)
+                        fail("malformed initial byte", start);
+                    auto const tag = read_argument(additional, start);
+                    if (is_typed_array_tag(tag) && (peek() >> 5) == 2)
+                        return read_typed_array(tag, start);
+                    enter(); // 其余标签被忽略, 只解析其内容
+                    JsonT content = parse_item();
+                    leave();
+                    return content;
+                }
+            default:
+                return read_simple(additional, start);
+            }
+        }
+
+    public:
+        explicit CborParser(StreamT& stream): BinaryParserBase<StreamT>(stream, "CBOR") {}
+
+        // Decodes exactly one data item spanning the whole input
+        JsonT parse()
+        {
+            JsonT result = parse_item();
+            if (!eof())
+                fail("unexpected data after the top-level item", tell_pos());
+            return result;
+        }
+    }; // class CborParser
+}
+
+#endif //JSONPP_CBOR_HPP
@@ -0,0 +1,381 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_COLUMNS_HPP
+#define JSONPP_JSON_COLUMNS_HPP
+
+#include "jsonexception.hpp"
+#include "json_stream_adaptor.hpp"
+#include "typed_parser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonpp
+{
+    enum class column_type : std::uint8_t { int64, float64, boolean, string };
+
+    struct column_spec
+    {
+        std::string name;
+        column_type type;
+    };
+
+    /*
+     * One column in an Arrow-like layout: a validity bitmap (LSB first, bit set when the row has a value) and a
+     * value buffer of the column's type. Null rows still occupy a (zero) value slot. Booleans are bit-packed;
+     * string i is data[offsets[i], offsets[i + 1]).
+     */
+    struct json_column
+    {
+        std::string name;
+        column_type type = column_type::int64;
+        std::size_t length = 0;
+        std::size_t null_count = 0;
+        std::vector<std::uint8_t> validity;
+        std::vector<std::int64_t> int64_values;
+        std::vector<double> float64_values;
+        std::vector<std::uint8_t> boolean_values;
+        std::vector<std::int64_t> offsets;
+        std::string data;
+
+        bool is_valid(std::size_t row) const noexcept { return (validity[row / 8] >> (row % 8)) & 1; }
+        bool boolean_at(std::size_t row) const noexcept { return (boolean_values[row / 8] >> (row % 8)) & 1; }
+
+        std::string_view string_at(std::size_t row) const noexcept
+        {
+            auto const begin = static_cast<std::size_t>(offsets[row]);
+            return std::string_view(data).substr(begin, static_cast<std::size_t>(offsets[row + 1]) - begin);
+        }
+
+        void append_null()
+        {
+            push_bit(validity, false);
+            ++null_count;
+            switch (type)
+            {
+                case column_type::int64: int64_values.push_back(0); break;
+                case column_type::float64: float64_values.push_back(0); break;
+                case column_type::boolean: push_bit(boolean_values, false); break;
+                case column_type::string: push_offset(); break;
+            }
+            ++length;
+        }
+
+        void append_int64(std::int64_t value) { push_bit(validity, true); int64_values.push_back(value); ++length; }
+        void append_float64(double value) { push_bit(validity, true); float64_values.push_back(value); ++length; }
+        void append_boolean(bool value) { push_bit(validity, true); push_bit(boolean_values, value); ++length; }
+
+        void append_string(std::string_view value)
+        {
+            push_bit(validity, true);
+            data.append(value);
+            push_offset();
+            ++length;
+        }
+
+        // Removes the last entry
+        void pop_back()
+        {
+            --length;
+            if (!is_valid(length))
+                --null_count;
+            pop_bit(validity);
+            switch (type)
+            {
+                case column_type::int64: int64_values.pop_back(); break;
+                case column_type::float64: float64_values.pop_back(); break;
+                case column_type::boolean: pop_bit(boolean_values); break;
+                case column_type::string:
+                    offsets.pop_back();
+                    data.resize(static_cast<std::size_t>(offsets.back()));
+                    break;
+            }
+        }
+
+    private:
+        void push_bit(std::vector<std::uint8_t>& bitmap, bool bit)
+        {
+            if (length % 8 == 0)
+                bitmap.push_back(0);
+            if (bit)
+                bitmap.back() |= static_cast<std::uint8_t>(1u << (length % 8));
+        }
+
+        // 清除第 length 位; 该字节不再使用时一并移除
+        void pop_bit(std::vector<std::uint8_t>& bitmap)
+        {
+            if (length % 8 == 0)
+                bitmap.pop_back();
+            else
+                bitmap.back() &= static_cast<std::uint8_t>(~(1u << (length % 8)));
+        }
+
+        void push_offset()
+        {
+            if (offsets.empty())
+                offsets.push_back(0);
+            offsets.push_back(static_cast<std::int64_t>(data.size()));
+        }
+    };
+
+    struct json_columns
+    {
+        std::size_t rows = 0;
+        std::vector<json_column> columns; // in the order of the requested fields
+
+        json_column const& operator[](std::string_view name) const
+        {
+            for (auto const& column : columns)
+                if (column.name == name)
+                    return column;
+            throw JsonOutOfRange(JsonOutOfRange::KEY_NOT_FOUND_MESSAGE);
+        }
+    };
+
+    namespace details
+    {
+        // 按字段名查找列; 每行结束时为缺失的字段补 null
+        class ColumnTableBuilder
+        {
+            json_columns m_table;
+            std::vector<std::pair<std::string, std::size_t>> m_index; // 按名称排序
+
+        public:
+            static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+
+            explicit ColumnTableBuilder(std::vector<column_spec> const& fields)
+            {
+                m_table.columns.reserve(fields.size());
+                for (std::size_t i = 0; i < fields.size(); ++i)
+                {
+                    json_column column;
+                    column.name = fields[i].name;
+                    column.type = fields[i].type;
+                    if (column.type == column_type::string)
+                        column.offsets.push_back(0);
+                    m_table.columns.push_back(std::move(column));
+                    m_index.emplace_back(fields[i].name, i);
+                }
+                std::sort(m_index.begin(), m_index.end());
+                for (std::size_t i = 1; i < m_index.size(); ++i)
+                    if (m_index[i].first == m_index[i - 1].first)
+                        throw JsonException("to_columns: duplicate field \"" + m_index[i].first + "\"");
+            }
+
+            std::size_t find(std::string_view name) const noexcept
+            {
+                auto const it = std::lower_bound(m_index.begin(), m_index.end(), name,
+                    [](auto const& entry, std::string_view n) { return std::string_view(entry.first) < n; });
+                return it != m_index.end() && it->first == name ? it->second : NPOS;
+            }
+
+            json_column& column(std::size_t index) noexcept { return m_table.columns[index]; }
+            std::vector<json_column>& columns() noexcept { return m_table.columns; }
+            std::size_t rows() const noexcept { return m_table.rows; }
+
+            // 本行已经写入过该列 (重复的键)
+            bool filled(std::size_t index) const noexcept { return m_table.columns[index].length > m_table.rows; }
+
+            void end_row()
+            {
+                ++m_table.rows;
+                for (auto& column : m_table.columns)
+                    if (column.length < m_table.rows)
+                        column.append_null();
+            }
+
+            json_columns finish() { return std::move(m_table); }
+        };
+
+        /*
+         * Reads a top-level array of objects straight into columns, without basic_json nodes. Reuses the
+         * TypedParser primitives: keys and string values are taken in place from contiguous input, unknown
+         * members are validated and skipped.
+         */
+        template <typename StreamT, typename JsonT>
+        class ColumnParser : public TypedParser<StreamT, JsonT>
+        {
+            using Base = TypedParser<StreamT, JsonT>;
+
+            void read_cell(json_column& column)
+            {
+                if (this->peek() == 'n')
+                {
+                    this->parse_literal("null", 4);
+                    return column.append_null();
+                }
+                switch (column.type)
+                {
+                    case column_type::int64:
+                    {
+                        std::int64_t value{};
+                        this->read_number(value);
+                        return column.append_int64(value);
+                    }
+                    case column_type::float64:
+                    {
+                        double value{};
+                        this->read_number(value);
+                        return column.append_float64(value);
+                    }
+                    case column_type::boolean:
+                    {
+                        bool value{};
+                        this->read(value);
+                        return column.append_boolean(value);
+                    }
+                    case column_type::string:
+                        return column.append_string(this->read_string_view());
+                }
+            }
+
+        public:
+            explicit ColumnParser(StreamT& stream): Base(stream) {}
+
+            json_columns parse(std::vector<column_spec> const& fields)
+            {
+                ColumnTableBuilder builder(fields);
+                this->skip_whitespace();
+                if (this->eof())
+                    throw JsonParseError("Unexpected end of file");
+                this->read_array([&]
+                {
+                    this->read_object([&](std::string_view key)
+                    {
+                        auto const index = builder.find(key);
+                        if (index == ColumnTableBuilder::NPOS)
+                            return this->skip_value();
+                        if (builder.filled(index))
+                            builder.column(index).pop_back(); // 与 DOM 解析器一样, 重复的键以最后一个为准
+                        read_cell(builder.column(index));
+                    });
+                    builder.end_row();
+                });
+                this->skip_whitespace();
+                if (!this->eof())
+                    throw JsonParseError("Unexpected character(s) after JSON value");
+                return builder.finish();
+            }
+        }; // class ColumnParser
+
+        template <typename JsonT>
+        void append_cell(json_column& column, JsonT const& value, std::size_t row)
+        {
+            if (value.is_raw())
+                return append_cell(column, value.materialized(), row);
+            if (value.is_null())
+                return column.append_null();
+
+            auto const mismatch = [&](char const* expected)
+            {
+                return JsonTypeError("to_columns: row " + std::to_string(row) + ", field \"" + column.name
+                                     + "\": expected " + expected);
+            };
+            switch (column.type)
+            {
+                case column_type::int64:
+                    if (auto const* i = value.get_if_int())
+                        return column.append_int64(static_cast<std::int64_t>(*i));
+                    if (auto const* f = value.get_if_float(); f && *f == std::floor(*f)
+                        && *f >= -9223372036854775808.0 && *f < 9223372036854775808.0)
+                        return column.append_int64(static_cast<std::int64_t>(*f));
+                    throw mismatch("an integer");
+                case column_type::float64:
+                    if (auto const* i = value.get_if_int())
+                        return column.append_float64(static_cast<double>(*i));
+                    if (auto const* f = value.get_if_float())
+                        return column.append_float64(static_cast<double>(*f));
+                    throw mismatch("a number");
+                case column_type::boolean:
+                    if (auto const* b = value.get_if_bool())
+                        return column.append_boolean(*b);
+                    throw mismatch("a boolean");
+                case column_type::string:
+                    if (auto const* s = value.get_if_string())
+                        return column.append_string(std::string_view(s->data(), s->size()));
+                    throw mismatch("a string");
+            }
+        }
+    }
+
+    /*
+     * Extracts the given fields of an array of objects into typed columns. Missing members and nulls become
+     * null entries; integers are accepted by float64 columns and integral floats by int64 columns, any other
+     * mismatch throws JsonTypeError. Members not listed in fields are ignored.
+     */
+    template <typename JsonT>
+    json_columns to_columns(JsonT const& array_of_objects, std::vector<column_spec> const& fields)
+    {
+        if (!array_of_objects.is_array())
+            throw JsonTypeError("to_columns: expected an array of objects");
+        details::ColumnTableBuilder builder(fields);
+        auto const& rows = array_of_objects.as_array();
+        for (auto& column : builder.columns())
+        {
+            column.validity.reserve((rows.size() + 7) / 8);
+            if (column.type == column_type::int64)
+                column.int64_values.reserve(rows.size());
+            else if (column.type == column_type::float64)
+                column.float64_values.reserve(rows.size());
+        }
+
+        for (std::size_t r = 0; r < rows.size(); ++r)
+        {
+            JsonT const* row = &rows[r];
+            JsonT materialized;
+            if (row->is_raw())
+                row = &(materialized = row->materialized());
+            auto const* obj = row->get_if_object();
+            if (!obj)
+                throw JsonTypeError("to_columns: row " + std::to_string(r) + " is not an object");
+            for (auto& column : builder.columns())
+            {
+                auto const it = obj->find(column.name);
+                if (it != obj->end())
+                    details::append_cell(column, it->second, r);
+            }
+            builder.end_row();
+        }
+        return builder.finish();
+    }
+
+    // Same as to_columns(JsonT::parse(json_doc), fields), but reads the document straight into the columns
+    template <typename JsonT = json>
+    json_columns parse_columns(std::string_view json_doc, std::vector<column_spec> const& fields)
+    {
+        details::StringViewStream svs(json_doc);
+        return details::ColumnParser<details::StringViewStream, JsonT>(svs).parse(fields);
+    }
+
+    template <typename JsonT = json>
+    json_columns parse_columns(std::istream& json_istream, std::vector<column_spec> const& fields)
+    {
+        details::IStreamStream iss(json_istream);
+        return details::ColumnParser<details::IStreamStream, JsonT>(iss).parse(fields);
+    }
+}
+
+#endif //JSONPP_JSON_COLUMNS_HPP
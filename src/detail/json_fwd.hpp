@@ -30,6 +30,10 @@ namespace jsonpp
     using null_t = std::nullptr_t;
     constexpr null_t null = nullptr;
 
+    // Conversion between basic_json and T; see adl_serializer.hpp
+    template <typename T, typename SFINAE = void>
+    struct adl_serializer;
+
     template <
         template<typename U, typename V, typename... Args> class ObjectType = std::map,
         template<typename U, typename... Args> class ArrayType = std::vector,
@@ -38,7 +42,7 @@ namespace jsonpp
         typename NumberIntegerType = std::int64_t,
         typename NumberFloatType = double,
         template<typename U> class AllocatorType = std::allocator,
-        // template<typename T, typename SFINAE = void> class JSONSerializer = adl_serializer, // 待实现
+        template<typename T, typename SFINAE = void> class JSONSerializer = adl_serializer,
         // typename BinaryType = std::vector<std::uint8_t>, // 待实现
         typename CustomBaseClass = void
     >
@@ -47,5 +51,27 @@ namespace jsonpp
     using json = basic_json<>;
     using unordered_json = basic_json<std::unordered_map>;
 
+    namespace details
+    {
+        /*
+         * Reference-counted storage for an array or object after basic_json::share(). Copies share the container;
+         * mutable access clones it first when it is not uniquely owned (copy-on-write).
+         */
+        template <typename ContainerT>
+        struct SharedContainer
+        {
+            std::shared_ptr<ContainerT> ptr;
+
+            bool operator==(SharedContainer const& other) const { return ptr == other.ptr || *ptr == *other.ptr; }
+        };
+
+        // The container behind a variant alternative, whether it is stored inline or shared
+        template <typename T>
+        T const& unshared(T const& value) noexcept { return value; }
+
+        template <typename ContainerT>
+        ContainerT const& unshared(SharedContainer<ContainerT> const& value) noexcept { return *value.ptr; }
+    }
+
 }
 #endif //JSONPP_JSON_FWD_HPP
\ No newline at end of file
@@ -0,0 +1,233 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_ITERATOR_HPP
+#define JSONPP_JSON_ITERATOR_HPP
+
+#include "jsonexception.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace jsonpp::details
+{
+    /*
+     * Iterator over the elements of an array or the member values of an object (key() gives the member name).
+     * One type serves both, so it is declared bidirectional: ++ and -- are O(1) (amortized for unordered objects).
+     * The random-access operators are also provided and are O(1) over arrays, but walk over objects; standard
+     * algorithms that need random access, including the parallel ones, should use as_array().begin()/end().
+     * Other value types are empty ranges.
+     * As for standard iterators, comparing or subtracting iterators of different values is undefined.
+     */
+    template <typename JsonT, bool IsConst>
+    class JsonIterator
+    {
+        template <typename, bool>
+        friend class JsonIterator;
+        friend JsonT;
+
+        using array = typename JsonT::array;
+        using object = typename JsonT::object;
+        using array_iterator = std::conditional_t<IsConst, typename array::const_iterator, typename array::iterator>;
+        using object_iterator = std::conditional_t<IsConst, typename object::const_iterator, typename object::iterator>;
+        using json_pointer = std::conditional_t<IsConst, JsonT const*, JsonT*>;
+
+        static constexpr bool object_is_bidirectional = std::is_base_of_v<std::bidirectional_iterator_tag,
+            typename std::iterator_traits<object_iterator>::iterator_category>;
+
+        enum class Kind : std::uint8_t { none, array, object };
+
+        // 单向的对象迭代器第一次向后移动时记录全部成员的位置 (末尾为 end()), 之后按下标移动; 拷贝之间共享
+        struct ForwardOrder
+        {
+            std::shared_ptr<std::vector<object_iterator>> positions;
+            std::size_t index = 0;
+        };
+        struct NoOrder {};
+
+        json_pointer m_json = nullptr;
+        Kind m_kind = Kind::none;
+        array_iterator m_array{};
+        object_iterator m_object{};
+        std::conditional_t<object_is_bidirectional, NoOrder, ForwardOrder> m_order{};
+
+        object_iterator object_begin() const
+        {
+            if constexpr (IsConst)
+                return m_json->object_storage()->cbegin();
+            else
+                return m_json->object_storage()->begin();
+        }
+        typename object::const_iterator object_end() const { return m_json->object_storage()->cend(); }
+
+        // 从 from 走到 to; 在到达末尾前没有遇到 to, 说明 to 在 from 之前
+        std::ptrdiff_t object_distance(object_iterator from, object_iterator to) const
+        {
+            std::ptrdiff_t n = 0;
+            for (auto it = from; it != to; ++it, ++n)
+            {
+                if (it == object_end())
+                    return -object_distance(to, from);
+            }
+            return n;
+        }
+
+        void object_advance(std::ptrdiff_t n)
+        {
+            if constexpr (object_is_bidirectional)
+                std::advance(m_object, n);
+            else
+            {
+                if (n < 0 && !m_order.positions)
+                    record_order();
+                if (m_order.positions)
+                {
+                    m_order.index = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_order.index) + n);
+                    m_object = (*m_order.positions)[m_order.index];
+                }
+                else
+                    std::advance(m_object, n);
+            }
+        }
+
+        void record_order()
+        {
+            auto positions = std::make_shared<std::vector<object_iterator>>();
+            positions->reserve(m_json->object_storage()->size() + 1);
+            for (auto it = object_begin();; ++it)
+            {
+                if (it == m_object)
+                    m_order.index = positions->size();
+                positions->push_back(it);
+                if (it == object_end())
+                    break;
+            }
+            m_order.positions = std::move(positions);
+        }
+
+        void expect_same([[maybe_unused]] JsonIterator const& other) const noexcept
+        {
+            assert(m_json == other.m_json && "iterators of different basic_json values");
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = JsonT;
+        using difference_type = std::ptrdiff_t;
+        using pointer = json_pointer;
+        using reference = std::conditional_t<IsConst, JsonT const&, JsonT&>;
+
+        JsonIterator() = default;
+        JsonIterator(json_pointer json, array_iterator it): m_json(json), m_kind(Kind::array), m_array(it) {}
+        JsonIterator(json_pointer json, object_iterator it): m_json(json), m_kind(Kind::object), m_object(it) {}
+        explicit JsonIterator(json_pointer json): m_json(json) {}
+
+        // iterator -> const_iterator (成员位置表的元素类型不同, 不保留)
+        template <bool OtherConst, std::enable_if_t<IsConst && !OtherConst, int> = 0>
+        JsonIterator(JsonIterator<JsonT, OtherConst> const& other)
+            : m_json(other.m_json), m_kind(static_cast<Kind>(other.m_kind)), m_array(other.m_array), m_object(other.m_object) {}
+
+        reference operator*() const { return m_kind == Kind::object ? m_object->second : *m_array; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        // Member name (object iterators only)
+        typename object::key_type const& key() const
+        {
+            if (m_kind != Kind::object)
+                throw JsonTypeError("key() is only available on object iterators");
+            return m_object->first;
+        }
+        reference value() const { return **this; }
+
+        JsonIterator& operator++()
+        {
+            if (m_kind == Kind::array)
+                ++m_array;
+            else if (m_kind == Kind::object)
+            {
+                ++m_object;
+                if constexpr (!object_is_bidirectional)
+                    ++m_order.index;
+            }
+            return *this;
+        }
+        JsonIterator operator++(int) { auto old = *this; ++*this; return old; }
+        JsonIterator& operator--()
+        {
+            if (m_kind == Kind::array)
+                --m_array;
+            else if (m_kind == Kind::object)
+                object_advance(-1);
+            return *this;
+        }
+        JsonIterator operator--(int) { auto old = *this; --*this; return old; }
+
+        JsonIterator& operator+=(difference_type n)
+        {
+            if (m_kind == Kind::array)
+                m_array += n;
+            else if (m_kind == Kind::object)
+                object_advance(n);
+            return *this;
+        }
+        JsonIterator& operator-=(difference_type n) { return *this += -n; }
+        friend JsonIterator operator+(JsonIterator it, difference_type n) { return it += n; }
+        friend JsonIterator operator+(difference_type n, JsonIterator it) { return it += n; }
+        friend JsonIterator operator-(JsonIterator it, difference_type n) { return it -= n; }
+
+        difference_type operator-(JsonIterator const& other) const
+        {
+            expect_same(other);
+            if (m_kind == Kind::array)
+                return m_array - other.m_array;
+            if (m_kind == Kind::object)
+                return object_distance(other.m_object, m_object);
+            return 0;
+        }
+
+        // Precondition: both iterators belong to the same value
+        bool operator==(JsonIterator const& other) const noexcept
+        {
+            expect_same(other);
+            if (m_kind == Kind::array)
+                return m_array == other.m_array;
+            if (m_kind == Kind::object)
+                return m_object == other.m_object;
+            return true;
+        }
+        bool operator!=(JsonIterator const& other) const noexcept { return !(*this == other); }
+        bool operator<(JsonIterator const& other) const
+        {
+            expect_same(other);
+            if (m_kind == Kind::array)
+                return m_array < other.m_array;
+            return m_kind == Kind::object && (other - *this) > 0;
+        }
+        bool operator>(JsonIterator const& other) const { return other < *this; }
+        bool operator<=(JsonIterator const& other) const { return !(other < *this); }
+        bool operator>=(JsonIterator const& other) const { return !(*this < other); }
+    }; // class JsonIterator
+}
+
+#endif //JSONPP_JSON_ITERATOR_HPP
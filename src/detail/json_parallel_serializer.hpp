@@ -0,0 +1,382 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_PARALLEL_SERIALIZER_HPP
+#define JSONPP_JSON_PARALLEL_SERIALIZER_HPP
+
+#include "json_serialize_handler.hpp"
+#include "json_serializer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace jsonpp::details
+{
+    struct ParallelSerializeOptions
+    {
+        unsigned threads = 0;                          // 0: std::thread::hardware_concurrency()
+        std::size_t min_parallel_bytes = 1024 * 1024; // subtrees estimated to be smaller are serialized sequentially
+        bool escape_forward_slash = DEFAULT_ESCAPE_FORWARD_SLASH;
+    };
+
+    /*
+     * A fixed set of worker threads, started on first use and reused by every run_parallel() call.
+     * Jobs must not block waiting for other jobs; run_parallel() never does, since its caller
+     * works through the tasks itself and pool workers only help.
+     */
+    class ThreadPool
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::deque<std::function<void()>> m_jobs;
+        std::vector<std::thread> m_workers;
+        unsigned m_size;
+        bool m_stop = false;
+
+        void work()
+        {
+            for (;;)
+            {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+                    if (m_jobs.empty())
+                        return;
+                    job = std::move(m_jobs.front());
+                    m_jobs.pop_front();
+                }
+                job();
+            }
+        }
+
+    public:
+        explicit ThreadPool(unsigned size) noexcept: m_size(size) {}
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (auto& t : m_workers)
+                t.join();
+        }
+
+        unsigned size() const noexcept { return m_size; }
+
+        // Queues count copies of job; jobs must not throw
+        void submit(std::function<void()> const& job, std::size_t count)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_workers.size() < m_size)
+                {
+                    m_workers.reserve(m_size);
+                    for (auto i = m_workers.size(); i < m_size; ++i)
+                        m_workers.emplace_back([this] { work(); });
+                }
+                m_jobs.insert(m_jobs.end(), count, job);
+            }
+            if (count == 1)
+                m_wake.notify_one();
+            else
+                m_wake.notify_all();
+        }
+    };
+
+    // std::thread::hardware_concurrency(), queried once (0 is reported as 1)
+    inline unsigned hardware_threads() noexcept
+    {
+        static unsigned const count = std::max(1u, std::thread::hardware_concurrency());
+        return count;
+    }
+
+    // 进程内共享的线程池; 调用 run_parallel() 的线程自身也参与计算, 因此工作线程数为硬件线程数 - 1 (至少 1 个)
+    inline ThreadPool& default_thread_pool()
+    {
+        static ThreadPool pool(std::max(2u, hardware_threads()) - 1);
+        return pool;
+    }
+
+    /*
+     * Runs task(0) ... task(count - 1) on up to `threads` threads: the calling one plus helpers from
+     * default_thread_pool(). The caller claims tasks as well, so nested calls (a task calling run_parallel())
+     * make progress even when every pool worker is busy, and the total thread count stays bounded.
+     * The first exception thrown by a task is rethrown after all started tasks have finished.
+     */
+    template <typename TaskT>
+    void run_parallel(std::size_t count, unsigned threads, TaskT const& task)
+    {
+        auto& pool = default_thread_pool();
+        auto const helpers = std::min<std::size_t>({ std::max(threads, 1u) - std::size_t(1), count - std::min<std::size_t>(count, 1), pool.size() });
+        if (helpers == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                task(i);
+            return;
+        }
+
+        // 迟到的辅助任务可能在调用者返回后才运行, 因此共享状态放在堆上; task 只在认领到有效序号时访问
+        struct State
+        {
+            std::atomic<std::size_t> next{0};
+            std::atomic<bool> abandoned{false};
+            std::size_t done = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        auto state = std::make_shared<State>();
+
+        auto claim_all = [count, &task](State& st)
+        {
+            for (std::size_t i; (i = st.next.fetch_add(1, std::memory_order_relaxed)) < count;)
+            {
+                std::exception_ptr error;
+                if (!st.abandoned.load(std::memory_order_relaxed))
+                {
+                    try { task(i); }
+                    catch (...) { error = std::current_exception(); }
+                }
+                std::lock_guard<std::mutex> lock(st.mutex);
+                if (error && !st.error)
+                {
+                    st.error = error;
+                    st.abandoned.store(true, std::memory_order_relaxed); // 放弃剩余任务
+                }
+                if (++st.done == count)
+                    st.finished.notify_all();
+            }
+        };
+
+        pool.submit([state, claim_all] { claim_all(*state); }, helpers);
+        claim_all(*state);
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&] { return state->done == count; });
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+    /*
+     * Serializes large subtrees by splitting the children of big containers into contiguous ranges,
+     * serializing every range into its own buffer on the thread pool and joining the buffers in order.
+     * Subtrees whose estimated output is below min_parallel_bytes are written sequentially.
+     * The output is byte-identical to JsonSerializer::dump<Pretty>.
+     */
+    template <typename JsonT>
+    class ParallelJsonSerializer
+    {
+        using object = typename JsonT::object;
+        using raw = typename JsonT::raw;
+        using Serializer = JsonSerializer<JsonT, StringSerializeHandler>;
+
+        std::string& m_buffer;
+        StringSerializeHandler m_sh;
+        Serializer m_serializer;
+        ParallelSerializeOptions m_options;
+        unsigned m_threads;
+
+        // Writes one child of a container, preceded by its separator, indentation and key
+        template <bool Pretty, typename KeyT>
+        static void dump_child(Serializer& serializer, StringSerializeHandler& sh, KeyT const* key, JsonT const& child,
+                               bool first, std::string_view indent, int depth)
+        {
+            if (!first)
+                sh.append(',');
+            if constexpr (Pretty)
+                serializer.append_indent(indent, depth + 1);
+            if (key)
+            {
+                serializer.write_key(*key);
+                if constexpr (Pretty)
+                    sh.append(": ", 2);
+                else
+                    sh.append(':');
+            }
+            serializer.template dump<Pretty>(child, indent, depth + 1);
+        }
+
+        template <bool Pretty, typename KeyT>
+        void dump_children_parallel(std::vector<std::pair<KeyT const*, JsonT const*>> const& children,
+                                    std::string_view indent, int depth)
+        {
+            std::size_t const chunk_count = std::min<std::size_t>(children.size(), std::size_t(m_threads) * 4);
+            std::vector<std::string> chunks(chunk_count);
+
+            run_parallel(chunk_count, m_threads, [&](std::size_t chunk)
+            {
+                std::size_t const begin = children.size() * chunk / chunk_count;
+                std::size_t const end = children.size() * (chunk + 1) / chunk_count;
+                StringSerializeHandler sh(chunks[chunk]);
+                Serializer serializer(sh, m_options.escape_forward_slash);
+                for (std::size_t i = begin; i < end; ++i)
+                    dump_child<Pretty>(serializer, sh, children[i].first, *children[i].second, i == 0, indent, depth);
+            });
+
+            std::size_t total = m_buffer.size();
+            for (auto const& chunk : chunks)
+                total += chunk.size();
+            m_buffer.reserve(total);
+            for (auto& chunk : chunks)
+            {
+                m_buffer.append(chunk);
+                std::string().swap(chunk); // 尽早释放
+            }
+        }
+
+        // budget: 剩余可访问的节点数; 用完后未访问的样本按已访问样本的平均值外推
+        static std::size_t estimate_size(JsonT const& json, std::size_t limit, std::size_t& budget)
+        {
+            constexpr std::size_t SAMPLES = 8;
+            if (budget > 0)
+                --budget;
+            if (auto const* r = std::get_if<raw>(&json.m_value))
+                return std::min<std::size_t>(r->text.size(), limit);
+            if (auto const* str = json.get_if_string())
+                return std::min<std::size_t>(str->size() + 2, limit);
+            if (!json.is_array() && !json.is_object())
+                return 8;
+
+            std::size_t const size = json.size();
+            std::size_t const samples = std::min(size, SAMPLES);
+            std::size_t sum = 0, seen = 0;
+            auto const total = [&] { return 2 + (seen == 0 ? 8 : sum / seen) * size; };
+            if (auto const* arr = json.get_if_array())
+            {
+                for (; seen < samples && budget > 0 && total() < limit; ++seen)
+                    sum += 1 + estimate_size((*arr)[seen * size / samples], limit, budget);
+            }
+            else
+            {
+                // 对象不一定支持随机访问, 取前几个成员
+                auto it = json.get_if_object()->begin();
+                for (; seen < samples && budget > 0 && total() < limit; ++it, ++seen)
+                    sum += it->first.size() + 4 + estimate_size(it->second, limit, budget);
+            }
+            return std::min(total(), limit);
+        }
+
+        // estimate: 调用者已算出的 estimate_size(json), 每个节点只估计一次
+        template <bool Pretty>
+        void dump_impl(JsonT const& json, std::string_view indent, int depth, std::size_t estimate)
+        {
+            if ((!json.is_array() && !json.is_object()) || m_threads <= 1 || estimate < m_options.min_parallel_bytes)
+                return m_serializer.template dump<Pretty>(json, indent, depth);
+
+            bool const is_array = json.is_array();
+            std::size_t const size = json.size();
+            using key_type = typename object::key_type;
+            m_sh.append(is_array ? '[' : '{');
+            if (size >= std::size_t(m_threads) * 4)
+            {
+                // 子节点足够多: 按区间分给各线程
+                std::vector<std::pair<key_type const*, JsonT const*>> children;
+                children.reserve(size);
+                if (is_array)
+                    for (auto const& item : json.as_array())
+                        children.emplace_back(nullptr, &item);
+                else
+                    for (auto const& item : json.as_object())
+                        children.emplace_back(&item.first, &item.second);
+                dump_children_parallel<Pretty>(children, indent, depth);
+            }
+            else
+            {
+                // 子节点太少, 不足以分给各线程: 顺序写出, 在子节点中继续寻找大的子树
+                bool first = true;
+                auto dump_one = [&](key_type const* key, JsonT const& child)
+                {
+                    if (!first)
+                        m_sh.append(',');
+                    first = false;
+                    if constexpr (Pretty)
+                        m_serializer.append_indent(indent, depth + 1);
+                    if (key)
+                    {
+                        m_serializer.write_key(*key);
+                        if constexpr (Pretty)
+                            m_sh.append(": ", 2);
+                        else
+                            m_sh.append(':');
+                    }
+                    // 唯一的子节点几乎就是整个容器, 沿用其估计值; 窄而深的树因此不会在每一层重新估计
+                    dump_impl<Pretty>(child, indent, depth + 1,
+                                      size == 1 ? estimate : estimate_size(child, m_options.min_parallel_bytes));
+                };
+                if (is_array)
+                    for (auto const& item : json.as_array())
+                        dump_one(nullptr, item);
+                else
+                    for (auto const& item : json.as_object())
+                        dump_one(&item.first, item.second);
+            }
+            if constexpr (Pretty)
+                m_serializer.append_indent(indent, depth);
+            m_sh.append(is_array ? ']' : '}');
+        }
+
+    public:
+        ParallelJsonSerializer(std::string& buffer, ParallelSerializeOptions const& options)
+            : m_buffer(buffer), m_sh(buffer), m_serializer(m_sh, options.escape_forward_slash), m_options(options),
+              m_threads(options.threads != 0 ? options.threads : hardware_threads()) {}
+
+        static constexpr std::size_t ESTIMATE_NODE_BUDGET = 256;
+
+        /*
+         * Cheap estimate of a subtree's serialized size, capped at limit. Scalars are counted roughly and
+         * containers are extrapolated from a few sampled children; at most ESTIMATE_NODE_BUDGET nodes are visited.
+         */
+        static std::size_t estimate_size(JsonT const& json, std::size_t limit)
+        {
+            std::size_t budget = ESTIMATE_NODE_BUDGET;
+            return estimate_size(json, limit, budget);
+        }
+
+        template <bool Pretty = false>
+        void dump(JsonT const& json, std::string_view indent, std::size_t estimate)
+        {
+            dump_impl<Pretty>(json, indent, 0, estimate);
+        }
+
+        template <bool Pretty = false>
+        void dump(JsonT const& json, std::string_view indent = "\t")
+        {
+            dump_impl<Pretty>(json, indent, 0, estimate_size(json, m_options.min_parallel_bytes));
+        }
+    }; // class ParallelJsonSerializer
+
+}
+
+#endif //JSONPP_JSON_PARALLEL_SERIALIZER_HPP
@@ -0,0 +1,505 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_PATCH_HPP
+#define JSONPP_JSON_PATCH_HPP
+
+#include "macro_def.hpp"
+#include "basic_json.hpp"
+#include "jsonexception.hpp"
+#include "json_pointer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonpp::details
+{
+    /*
+     * Applies RFC 6902 operations to a document in place. Values are moved, never copied, except for "copy"
+     * and when the operations themselves are const. Every step records its inverse, so a failing operation
+     * rolls the document back to its original state before the exception propagates. Replaying the undo log
+     * re-inserts members and elements, which may allocate; if that fails, std::bad_alloc propagates instead and
+     * the document is left partially restored.
+     */
+    template <typename JsonT>
+    class JsonPatcher
+    {
+        using Tokens = std::vector<std::string>;
+
+        enum class UndoKind : std::uint8_t
+        {
+            remove,         // 删除 path 处的值 (放入 carry)
+            insert,         // 把 value 插回 path
+            insert_carried, // 把上一步取出的值 (carry) 插回 path, 用于 move
+            replace         // 把 path 处的值换回 value (换出的值放入 carry)
+        };
+
+        struct UndoRecord
+        {
+            UndoKind kind;
+            Tokens path;
+            JsonT value;
+        };
+
+        JsonT& m_root;
+        std::vector<UndoRecord> m_undo;
+        std::size_t m_operation = 0;
+
+        [[noreturn]] void fail(std::string const& msg) const { throw JsonPatchError(msg, m_operation); }
+
+        static std::string to_pointer(Tokens const& path, std::size_t depth)
+        {
+            std::string pointer;
+            for (std::size_t i = 0; i < depth; ++i)
+                append_json_pointer_token(pointer, path[i]);
+            return pointer;
+        }
+
+        JsonT& resolve(Tokens const& path, std::size_t depth)
+        {
+            JsonT* node = &m_root;
+            for (std::size_t i = 0; i < depth; ++i)
+            {
+                if (node->is_raw())
+                    node->materialize();
+                if (node->is_object())
+                {
+                    auto& obj = node->as_object();
+                    auto it = obj.find(path[i]);
+                    if (it == obj.end())
+                        fail("path \"" + to_pointer(path, i + 1) + "\" does not exist");
+                    node = &it->second;
+                }
+                else if (node->is_array())
+                {
+                    auto& arr = node->as_array();
+                    std::size_t index;
+                    if (!parse_json_pointer_index(path[i], index) || index >= arr.size())
+                        fail("path \"" + to_pointer(path, i + 1) + "\" does not exist");
+                    node = &arr[index];
+                }
+                else
+                    fail("path \"" + to_pointer(path, i + 1) + "\" does not exist");
+            }
+            return *node;
+        }
+
+        JsonT& parent_of(Tokens const& path)
+        {
+            auto& parent = resolve(path, path.size() - 1);
+            if (parent.is_raw())
+                parent.materialize();
+            if (!parent.is_object() && !parent.is_array())
+                fail("parent of \"" + to_pointer(path, path.size()) + "\" is not an array or an object");
+            return parent;
+        }
+
+        // "add": inserts into arrays, creates or overwrites object members. Returns the overwritten value, if any.
+        // An array "-" token in path is replaced with the index actually used.
+        std::optional<JsonT> place(Tokens& path, JsonT&& value)
+        {
+            if (path.empty())
+                return std::exchange(m_root, std::move(value));
+
+            auto& parent = parent_of(path);
+            if (parent.is_object())
+            {
+                auto& obj = parent.as_object();
+                auto it = obj.find(path.back());
+                if (it != obj.end())
+                    return std::exchange(it->second, std::move(value));
+                obj.emplace(path.back(), std::move(value));
+                return std::nullopt;
+            }
+
+            auto& arr = parent.as_array();
+            std::size_t index = arr.size();
+            if (path.back() != "-" && (!parse_json_pointer_index(path.back(), index) || index > arr.size()))
+                fail("array index \"" + path.back() + "\" is out of range for \"" + to_pointer(path, path.size() - 1) + "\"");
+            arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+            path.back() = std::to_string(index);
+            return std::nullopt;
+        }
+
+        // "remove"
+        JsonT take(Tokens const& path)
+        {
+            if (path.empty())
+                fail("the document root cannot be removed");
+
+            auto& parent = parent_of(path);
+            JsonT value;
+            if (parent.is_object())
+            {
+                auto& obj = parent.as_object();
+                auto it = obj.find(path.back());
+                if (it == obj.end())
+                    fail("path \"" + to_pointer(path, path.size()) + "\" does not exist");
+                value = std::move(it->second);
+                obj.erase(it);
+            }
+            else
+            {
+                auto& arr = parent.as_array();
+                std::size_t index;
+                if (!parse_json_pointer_index(path.back(), index) || index >= arr.size())
+                    fail("path \"" + to_pointer(path, path.size()) + "\" does not exist");
+                value = std::move(arr[index]);
+                arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(index));
+            }
+            return value;
+        }
+
+        // "replace": the target must exist
+        JsonT exchange(Tokens const& path, JsonT&& value)
+        {
+            return std::exchange(resolve(path, path.size()), std::move(value));
+        }
+
+        void record_place(Tokens&& path, std::optional<JsonT>&& replaced)
+        {
+            if (replaced)
+                m_undo.push_back({UndoKind::replace, std::move(path), std::move(*replaced)});
+            else
+                m_undo.push_back({UndoKind::remove, std::move(path), JsonT()});
+        }
+
+        // 重新插入成员/元素可能分配内存, 因此不是 noexcept
+        void rollback()
+        {
+            JsonT carry;
+            for (auto it = m_undo.rbegin(); it != m_undo.rend(); ++it)
+            {
+                switch (it->kind)
+                {
+                    case UndoKind::remove: carry = take(it->path); break;
+                    case UndoKind::insert: place(it->path, std::move(it->value)); break;
+                    case UndoKind::insert_carried: place(it->path, std::move(carry)); break;
+                    case UndoKind::replace: carry = exchange(it->path, std::move(it->value)); break;
+                }
+            }
+            m_undo.clear();
+        }
+
+        template <typename OpT>
+        static auto member(OpT& op, std::string_view key) -> decltype(op.at(key))
+        {
+            auto it = op.find(key);
+            if (it == op.end())
+                throw JsonPatchError("missing member \"" + std::string(key) + "\"");
+            return *it;
+        }
+
+        // Moves "value" out of a mutable operation, copies it out of a const one
+        template <typename OpT>
+        static JsonT value_member(OpT& op)
+        {
+            return JsonT(std::move(member(op, "value")));
+        }
+
+        template <typename OpT>
+        Tokens pointer_member(OpT& op, std::string_view key)
+        {
+            auto const& value = member(op, key);
+            if (!value.is_string())
+                fail("member \"" + std::string(key) + "\" must be a string");
+            return split_json_pointer(value.as_string());
+        }
+
+        template <typename OpT>
+        void apply_one(OpT& op)
+        {
+            if (!op.is_object())
+                fail("an operation must be an object");
+            auto const& name = member(op, "op");
+            if (!name.is_string())
+                fail("member \"op\" must be a string");
+            auto const& kind = name.as_string();
+            auto path = pointer_member(op, "path");
+
+            if (kind == "add")
+            {
+                auto replaced = place(path, value_member(op));
+                record_place(std::move(path), std::move(replaced));
+            }
+            else if (kind == "remove")
+            {
+                auto value = take(path);
+                m_undo.push_back({UndoKind::insert, std::move(path), std::move(value)});
+            }
+            else if (kind == "replace")
+            {
+                auto old = exchange(path, value_member(op));
+                m_undo.push_back({UndoKind::replace, std::move(path), std::move(old)});
+            }
+            else if (kind == "move")
+            {
+                auto from = pointer_member(op, "from");
+                if (from == path)
+                    return;
+                if (from.size() < path.size() && std::equal(from.begin(), from.end(), path.begin()))
+                    fail("a value cannot be moved into one of its children");
+                auto value = take(from);
+                m_undo.push_back({UndoKind::insert_carried, std::move(from), JsonT()});
+                auto replaced = place(path, std::move(value));
+                record_place(std::move(path), std::move(replaced));
+            }
+            else if (kind == "copy")
+            {
+                auto from = pointer_member(op, "from");
+                JsonT value = resolve(from, from.size());
+                auto replaced = place(path, std::move(value));
+                record_place(std::move(path), std::move(replaced));
+            }
+            else if (kind == "test")
+            {
+                if (!(resolve(path, path.size()) == member(op, "value")))
+                    fail("test failed for \"" + to_pointer(path, path.size()) + "\"");
+            }
+            else
+                fail("unknown operation \"" + std::string(kind) + "\"");
+        }
+
+    public:
+        explicit JsonPatcher(JsonT& root): m_root(root) {}
+
+        // OpsT is JsonT (values are moved out of the operations) or JsonT const (values are copied)
+        template <typename OpsT>
+        void apply(OpsT& operations)
+        {
+            if (!operations.is_array())
+                throw JsonPatchError("a patch must be an array of operations");
+            try
+            {
+                for (auto& op : operations)
+                {
+                    apply_one(op);
+                    ++m_operation;
+                }
+            }
+            catch (...)
+            {
+                rollback();
+                throw;
+            }
+            m_undo.clear();
+        }
+    }; // class JsonPatcher
+
+    /*
+     * Produces an RFC 6902 patch that turns source into target. Equal subtrees are skipped by identity or by
+     * comparison, which stops at the first difference; arrays are aligned with Myers' O((N+M)D) diff on element hashes after the
+     * common prefix and suffix are stripped, so localized edits stay cheap on large arrays.
+     */
+    template <typename JsonT>
+    class JsonDiffer
+    {
+        using array = typename JsonT::array;
+        using object = typename JsonT::object;
+
+        enum class Edit : std::uint8_t { keep, remove, insert };
+
+        // Beyond this many edits in one array, elements are paired positionally instead
+        static constexpr std::ptrdiff_t MAX_EDIT_DISTANCE = 1024;
+
+        JsonT& m_patch;
+        std::string m_path;
+
+        static bool same(JsonT const& a, JsonT const& b)
+        {
+            return &a == &b || a.shares_storage_with(b) || a == b;
+        }
+
+        void emit(char const* op, JsonT const* value)
+        {
+            object entry;
+            entry.emplace("op", JsonT(op));
+            entry.emplace("path", JsonT(m_path));
+            if (value)
+                entry.emplace("value", *value);
+            m_patch.push_back(JsonT(std::move(entry)));
+        }
+
+        void diff_object(object const& a, object const& b)
+        {
+            auto const mark = m_path.size();
+            for (auto const& [key, value] : a)
+            {
+                append_json_pointer_token(m_path, key);
+                auto it = b.find(key);
+                if (it == b.end())
+                    emit("remove", nullptr);
+                else
+                    diff(value, it->second);
+                m_path.resize(mark);
+            }
+            for (auto const& [key, value] : b)
+            {
+                if (a.find(key) != a.end())
+                    continue;
+                append_json_pointer_token(m_path, key);
+                emit("add", &value);
+                m_path.resize(mark);
+            }
+        }
+
+        static std::vector<Edit> edit_script(array const& a, std::size_t a_first, std::size_t a_last,
+                                             array const& b, std::size_t b_first, std::size_t b_last)
+        {
+            auto const n = static_cast<std::ptrdiff_t>(a_last - a_first);
+            auto const m = static_cast<std::ptrdiff_t>(b_last - b_first);
+            std::vector<Edit> script;
+            if (n != 0 && m != 0)
+            {
+                std::vector<std::size_t> ha(n), hb(m);
+                for (std::ptrdiff_t i = 0; i < n; ++i)
+                    ha[i] = a[a_first + i].hash();
+                for (std::ptrdiff_t j = 0; j < m; ++j)
+                    hb[j] = b[b_first + j].hash();
+                auto equal = [&](std::ptrdiff_t i, std::ptrdiff_t j)
+                {
+                    return ha[i] == hb[j] && a[a_first + i] == b[b_first + j];
+                };
+
+                // v[k + offset]: 对角线 k 上走得最远的 x; trace[d] 保存第 d 轮开始前 k ∈ [-d-1, d+1] 的 v
+                std::ptrdiff_t const max_d = std::min(n + m, MAX_EDIT_DISTANCE);
+                std::ptrdiff_t const offset = max_d + 1;
+                std::vector<std::ptrdiff_t> v(2 * max_d + 3, 0);
+                std::vector<std::vector<std::ptrdiff_t>> trace;
+                for (std::ptrdiff_t d = 0; d <= max_d; ++d)
+                {
+                    trace.emplace_back(v.begin() + (offset - d - 1), v.begin() + (offset + d + 2));
+                    for (std::ptrdiff_t k = -d; k <= d; k += 2)
+                    {
+                        std::ptrdiff_t x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]))
+                            ? v[offset + k + 1] : v[offset + k - 1] + 1;
+                        std::ptrdiff_t y = x - k;
+                        while (x < n && y < m && equal(x, y))
+                            ++x, ++y;
+                        v[offset + k] = x;
+                        if (x >= n && y >= m)
+                            return backtrack(trace, n, m);
+                    }
+                }
+            }
+            // 差异过大 (或一侧为空): 全部删除后全部插入, 调用方会按位置逐个配对
+            script.assign(static_cast<std::size_t>(n), Edit::remove);
+            script.insert(script.end(), static_cast<std::size_t>(m), Edit::insert);
+            return script;
+        }
+
+        static std::vector<Edit> backtrack(std::vector<std::vector<std::ptrdiff_t>> const& trace, std::ptrdiff_t x, std::ptrdiff_t y)
+        {
+            std::vector<Edit> script;
+            for (auto d = static_cast<std::ptrdiff_t>(trace.size()) - 1; d > 0; --d)
+            {
+                auto const& v = trace[d];
+                auto const at = [&](std::ptrdiff_t k) { return v[k + d + 1]; };
+                std::ptrdiff_t const k = x - y;
+                bool const down = k == -d || (k != d && at(k - 1) < at(k + 1));
+                std::ptrdiff_t const prev_k = down ? k + 1 : k - 1;
+                std::ptrdiff_t const prev_x = at(prev_k);
+                std::ptrdiff_t const snake_x = down ? prev_x : prev_x + 1;
+                for (; x > snake_x; --x, --y)
+                    script.push_back(Edit::keep);
+                script.push_back(down ? Edit::insert : Edit::remove);
+                x = prev_x;
+                y = prev_x - prev_k;
+            }
+            for (; x > 0; --x)
+                script.push_back(Edit::keep);
+            std::reverse(script.begin(), script.end());
+            return script;
+        }
+
+        void diff_array(array const& a, array const& b)
+        {
+            std::size_t const n = a.size(), m = b.size();
+            std::size_t prefix = 0;
+            while (prefix < n && prefix < m && same(a[prefix], b[prefix]))
+                ++prefix;
+            std::size_t suffix = 0;
+            while (suffix < n - prefix && suffix < m - prefix && same(a[n - 1 - suffix], b[m - 1 - suffix]))
+                ++suffix;
+
+            auto const script = edit_script(a, prefix, n - suffix, b, prefix, m - suffix);
+            auto const mark = m_path.size();
+            auto const at = [&](std::size_t index) { m_path.resize(mark); append_json_pointer_token(m_path, std::to_string(index)); };
+
+            // pos: 已应用前面操作后, 当前元素在目标数组中的下标
+            std::size_t pos = prefix, i = prefix, j = prefix;
+            for (std::size_t e = 0; e < script.size();)
+            {
+                if (script[e] == Edit::keep)
+                {
+                    ++pos, ++i, ++j, ++e;
+                    continue;
+                }
+                std::size_t removes = 0, inserts = 0;
+                for (; e < script.size() && script[e] != Edit::keep; ++e)
+                    ++(script[e] == Edit::remove ? removes : inserts);
+
+                // 被替换的元素递归比较, 通常只产生少量嵌套操作
+                std::size_t const paired = std::min(removes, inserts);
+                for (std::size_t p = 0; p < paired; ++p, ++pos)
+                {
+                    at(pos);
+                    diff(a[i + p], b[j + p]);
+                }
+                for (std::size_t p = paired; p < removes; ++p)
+                {
+                    at(pos);
+                    emit("remove", nullptr);
+                }
+                for (std::size_t p = paired; p < inserts; ++p, ++pos)
+                {
+                    at(pos);
+                    emit("add", &b[j + p]);
+                }
+                i += removes;
+                j += inserts;
+            }
+            m_path.resize(mark);
+        }
+
+    public:
+        explicit JsonDiffer(JsonT& patch): m_patch(patch) {}
+
+        void diff(JsonT const& source, JsonT const& target)
+        {
+            if (same(source, target))
+                return;
+            if (source.is_raw())
+                return diff(source.materialized(), target);
+            if (target.is_raw())
+                return diff(source, target.materialized());
+            if (source.is_object() && target.is_object())
+                return diff_object(source.as_object(), target.as_object());
+            if (source.is_array() && target.is_array())
+                return diff_array(source.as_array(), target.as_array());
+            emit("replace", &target);
+        }
+    }; // class JsonDiffer
+}
+
+#endif //JSONPP_JSON_PATCH_HPP
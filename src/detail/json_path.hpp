@@ -0,0 +1,1258 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_PATH_HPP
+#define JSONPP_JSON_PATH_HPP
+
+#include "macro_def.hpp"
+#include "jsonexception.hpp"
+#include "json_parallel_serializer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace jsonpp::details
+{
+    struct JsonPathOptions
+    {
+        unsigned threads = 1;                     // 0: std::thread::hardware_concurrency()
+        std::size_t min_parallel_elements = 4096; // 元素更少的数组在过滤时顺序求值
+    };
+
+    using JsonPathLiteral = std::variant<std::nullptr_t, bool, std::int64_t, double, std::string>;
+
+    // I-Regexp 没有反向引用, libstdc++ 可以使用不递归的执行器: 默认的执行器按主题字符串的长度递归, 长字符串会栈溢出
+    inline constexpr std::regex::flag_type JSONPATH_REGEX_FLAGS = std::regex::ECMAScript
+#if defined(__GLIBCXX__)
+        | std::regex_constants::__polynomial
+#endif
+        ;
+
+    struct JsonPathExpr;
+
+    struct JsonPathSelector
+    {
+        enum class Kind : std::uint8_t { name, wildcard, index, slice, filter };
+
+        Kind kind = Kind::wildcard;
+        std::string name;
+        std::int64_t index = 0;
+        std::optional<std::int64_t> start, end; // slice
+        std::int64_t step = 1;
+        std::shared_ptr<JsonPathExpr const> filter;
+    };
+
+    struct JsonPathSegment
+    {
+        bool descendant = false;
+        std::vector<JsonPathSelector> selectors;
+    };
+
+    struct JsonPathQuery
+    {
+        bool absolute = true; // '$' 或 '@'
+        bool singular = true; // 只含单个 name/index 选择器的子段: 最多选中一个节点
+        std::vector<JsonPathSegment> segments;
+    };
+
+    enum class JsonPathFunction : std::uint8_t { length, count, match, search, value };
+
+    struct JsonPathExpr
+    {
+        enum class Kind : std::uint8_t { logical_or, logical_and, logical_not, compare, exists, function, literal, query };
+        enum class Op : std::uint8_t { eq, ne, lt, le, gt, ge };
+        // RFC 9535 2.4.1 类型系统
+        enum class Type : std::uint8_t { value, logical, nodes };
+
+        Kind kind = Kind::literal;
+        Op op = Op::eq;
+        JsonPathFunction function = JsonPathFunction::length;
+        std::vector<JsonPathExpr> children; // 逻辑运算的操作数, 比较的两侧, 函数参数
+        JsonPathLiteral literal;
+        JsonPathQuery query;
+        std::shared_ptr<std::regex const> regex; // match()/search() 的字面量模式, 编译时构造一次
+        bool regex_invalid = false;
+
+        Type type() const noexcept
+        {
+            switch (kind)
+            {
+                case Kind::literal: return Type::value;
+                case Kind::query: return Type::nodes;
+                case Kind::function:
+                    return function == JsonPathFunction::match || function == JsonPathFunction::search ? Type::logical : Type::value;
+                default: return Type::logical;
+            }
+        }
+
+        // 可出现在需要 ValueType 的位置: 字面量, 单值查询, 返回 ValueType 的函数
+        bool is_value() const noexcept
+        {
+            return type() == Type::value || (kind == Kind::query && query.singular);
+        }
+    };
+
+    /*
+     * Recursive descent parser for the RFC 9535 grammar, including the well-typedness rules for function
+     * expressions (2.4.3). The whole expression is validated up front so evaluation never fails.
+     */
+    class JsonPathParser
+    {
+        static constexpr std::int64_t MAX_SAFE_INTEGER = (std::int64_t(1) << 53) - 1;
+
+        std::string_view m_text;
+        std::size_t m_pos = 0;
+        int m_nesting_depth = 0;
+
+        [[noreturn]] void fail(std::string const& msg) const { throw JsonPathError(msg, m_pos); }
+
+        // 括号, '!(', 嵌套的过滤查询与函数调用都会递归; 与文档解析器一样限制深度, 以免用户给出的查询耗尽栈
+        void enter()
+        {
+            if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                fail(JsonDepthLimitExceeded::DEPTH_LIMIT_EXCEEDED_MESSAGE);
+        }
+        void leave() noexcept { --m_nesting_depth; }
+        bool at_end() const noexcept { return m_pos >= m_text.size(); }
+        char peek(std::size_t ahead = 0) const noexcept { return m_pos + ahead < m_text.size() ? m_text[m_pos + ahead] : '\0'; }
+        static bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+        static bool is_alpha(char c) noexcept { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+        static bool is_name_first(char c) noexcept { return is_alpha(c) || c == '_' || static_cast<unsigned char>(c) >= 0x80; }
+
+        void skip_blank() noexcept
+        {
+            while (!at_end() && (peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r'))
+                ++m_pos;
+        }
+
+        bool consume(char c) noexcept
+        {
+            if (at_end() || peek() != c)
+                return false;
+            ++m_pos;
+            return true;
+        }
+
+        void expect(char c)
+        {
+            if (!consume(c))
+                fail(std::string("expected '") + c + "'");
+        }
+
+        // 跳过空白后若紧跟 token 则消耗之, 否则位置不变
+        bool consume_after_blank(std::string_view token) noexcept
+        {
+            auto const save = m_pos;
+            skip_blank();
+            if (m_text.substr(m_pos, token.size()) == token)
+            {
+                m_pos += token.size();
+                return true;
+            }
+            m_pos = save;
+            return false;
+        }
+
+        void append_utf8(std::string& out, std::uint32_t cp)
+        {
+            if (cp < 0x80)
+                out += static_cast<char>(cp);
+            else if (cp < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else if (cp < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        std::uint32_t parse_hex4()
+        {
+            std::uint32_t value = 0;
+            if (m_pos + 4 > m_text.size())
+                fail("incomplete \\u escape");
+            auto [ptr, ec] = std::from_chars(m_text.data() + m_pos, m_text.data() + m_pos + 4, value, 16);
+            if (ec != std::errc() || ptr != m_text.data() + m_pos + 4)
+                fail("invalid \\u escape");
+            m_pos += 4;
+            return value;
+        }
+
+        std::string parse_string_literal()
+        {
+            char const quote = m_text[m_pos++];
+            std::string out;
+            for (;;)
+            {
+                if (at_end())
+                    fail("unterminated string literal");
+                char const c = m_text[m_pos++];
+                if (c == quote)
+                    return out;
+                if (static_cast<unsigned char>(c) < 0x20)
+                    fail("control character in string literal");
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                char const e = peek();
+                ++m_pos;
+                switch (e)
+                {
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case '/': out += '/'; break;
+                    case '\\': out += '\\'; break;
+                    case 'u':
+                    {
+                        std::uint32_t cp = parse_hex4();
+                        if (cp >= 0xD800 && cp <= 0xDBFF)
+                        {
+                            if (!consume('\\') || !consume('u'))
+                                fail("expected low surrogate after high surrogate");
+                            std::uint32_t const low = parse_hex4();
+                            if (low < 0xDC00 || low > 0xDFFF)
+                                fail("expected low surrogate after high surrogate");
+                            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        else if (cp >= 0xDC00 && cp <= 0xDFFF)
+                            fail("unexpected low surrogate");
+                        append_utf8(out, cp);
+                        break;
+                    }
+                    default:
+                        if (e != quote) // 只能转义与外层相同的引号
+                        {
+                            --m_pos;
+                            fail("invalid escape in string literal");
+                        }
+                        out += e;
+                }
+            }
+        }
+
+        // int = "0" / (["-"] DIGIT1 *DIGIT), 且在 I-JSON 安全整数范围内
+        std::int64_t parse_int()
+        {
+            auto const begin = m_pos;
+            consume('-');
+            if (!is_digit(peek()) || (peek() == '0' && (m_pos != begin || is_digit(peek(1)))))
+                fail("invalid integer");
+            while (is_digit(peek()))
+                ++m_pos;
+            std::int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(m_text.data() + begin, m_text.data() + m_pos, value);
+            if (ec != std::errc() || value > MAX_SAFE_INTEGER || value < -MAX_SAFE_INTEGER)
+                fail("integer out of range");
+            return value;
+        }
+
+        JsonPathLiteral parse_number()
+        {
+            auto const begin = m_pos;
+            bool is_float = false;
+            consume('-');
+            if (peek() == '0')
+                ++m_pos;
+            else if (is_digit(peek()))
+                while (is_digit(peek()))
+                    ++m_pos;
+            else
+                fail("invalid number");
+            if (peek() == '.')
+            {
+                is_float = true;
+                ++m_pos;
+                if (!is_digit(peek()))
+                    fail("invalid number");
+                while (is_digit(peek()))
+                    ++m_pos;
+            }
+            if (peek() == 'e' || peek() == 'E')
+            {
+                is_float = true;
+                ++m_pos;
+                if (peek() == '+' || peek() == '-')
+                    ++m_pos;
+                if (!is_digit(peek()))
+                    fail("invalid number");
+                while (is_digit(peek()))
+                    ++m_pos;
+            }
+
+            char const* const first = m_text.data() + begin;
+            char const* const last = m_text.data() + m_pos;
+            if (!is_float)
+            {
+                std::int64_t value = 0;
+                auto [ptr, ec] = std::from_chars(first, last, value);
+                if (ec == std::errc())
+                    return value;
+            }
+            double value = 0;
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc())
+                fail("number out of range");
+            return value;
+        }
+
+        std::string parse_member_name()
+        {
+            if (!is_name_first(peek()))
+                fail("expected member name");
+            auto const begin = m_pos;
+            while (is_name_first(peek()) || is_digit(peek()))
+                ++m_pos;
+            return std::string(m_text.substr(begin, m_pos - begin));
+        }
+
+        static JsonPathSelector name_selector(std::string name)
+        {
+            JsonPathSelector selector;
+            selector.kind = JsonPathSelector::Kind::name;
+            selector.name = std::move(name);
+            return selector;
+        }
+
+        JsonPathSelector parse_selector()
+        {
+            JsonPathSelector selector;
+            char const c = peek();
+            if (c == '\'' || c == '"')
+                return name_selector(parse_string_literal());
+            if (consume('*'))
+                return selector;
+            if (consume('?'))
+            {
+                skip_blank();
+                auto filter = parse_logical_or();
+                selector.kind = JsonPathSelector::Kind::filter;
+                selector.filter = std::make_shared<JsonPathExpr const>(std::move(filter));
+                return selector;
+            }
+            if (c != ':' && c != '-' && !is_digit(c))
+                fail("invalid selector");
+
+            std::optional<std::int64_t> start;
+            if (c != ':')
+                start = parse_int();
+            if (!consume_after_blank(":"))
+            {
+                selector.kind = JsonPathSelector::Kind::index;
+                selector.index = *start;
+                return selector;
+            }
+            selector.kind = JsonPathSelector::Kind::slice;
+            selector.start = start;
+            skip_blank();
+            if (peek() == '-' || is_digit(peek()))
+                selector.end = parse_int();
+            if (consume_after_blank(":"))
+            {
+                skip_blank();
+                if (peek() == '-' || is_digit(peek()))
+                    selector.step = parse_int();
+            }
+            return selector;
+        }
+
+        std::vector<JsonPathSelector> parse_bracketed()
+        {
+            expect('[');
+            std::vector<JsonPathSelector> selectors;
+            for (;;)
+            {
+                skip_blank();
+                selectors.push_back(parse_selector());
+                skip_blank();
+                if (consume(','))
+                    continue;
+                expect(']');
+                return selectors;
+            }
+        }
+
+        void parse_segments(JsonPathQuery& query)
+        {
+            for (;;)
+            {
+                auto const save = m_pos;
+                skip_blank();
+                JsonPathSegment segment;
+                if (peek() == '[')
+                    segment.selectors = parse_bracketed();
+                else if (consume('.'))
+                {
+                    segment.descendant = consume('.');
+                    if (segment.descendant && peek() == '[')
+                        segment.selectors = parse_bracketed();
+                    else if (consume('*'))
+                        segment.selectors.emplace_back();
+                    else
+                        segment.selectors.push_back(name_selector(parse_member_name()));
+                }
+                else
+                {
+                    m_pos = save;
+                    return;
+                }
+
+                if (segment.descendant || segment.selectors.size() != 1 ||
+                    (segment.selectors[0].kind != JsonPathSelector::Kind::name &&
+                     segment.selectors[0].kind != JsonPathSelector::Kind::index))
+                    query.singular = false;
+                query.segments.push_back(std::move(segment));
+            }
+        }
+
+        void check_argument(JsonPathExpr const& arg, JsonPathExpr::Type param)
+        {
+            bool const ok = param == JsonPathExpr::Type::value ? arg.is_value() : arg.type() == param;
+            if (!ok)
+                fail("function argument has the wrong type");
+        }
+
+        JsonPathExpr parse_function()
+        {
+            auto const begin = m_pos;
+            while ((peek() >= 'a' && peek() <= 'z') || peek() == '_' || is_digit(peek()))
+                ++m_pos;
+            std::string_view const name = m_text.substr(begin, m_pos - begin);
+
+            JsonPathExpr expr;
+            expr.kind = JsonPathExpr::Kind::function;
+            std::vector<JsonPathExpr::Type> params;
+            using Type = JsonPathExpr::Type;
+            if (name == "length")
+                expr.function = JsonPathFunction::length, params = {Type::value};
+            else if (name == "count")
+                expr.function = JsonPathFunction::count, params = {Type::nodes};
+            else if (name == "match")
+                expr.function = JsonPathFunction::match, params = {Type::value, Type::value};
+            else if (name == "search")
+                expr.function = JsonPathFunction::search, params = {Type::value, Type::value};
+            else if (name == "value")
+                expr.function = JsonPathFunction::value, params = {Type::nodes};
+            else
+            {
+                m_pos = begin;
+                fail("unknown function \"" + std::string(name) + "\"");
+            }
+
+            expect('(');
+            skip_blank();
+            if (!consume(')'))
+            {
+                for (;;)
+                {
+                    expr.children.push_back(parse_argument());
+                    skip_blank();
+                    if (consume(','))
+                    {
+                        skip_blank();
+                        continue;
+                    }
+                    expect(')');
+                    break;
+                }
+            }
+            if (expr.children.size() != params.size())
+                fail("function \"" + std::string(name) + "\" takes " + std::to_string(params.size()) + " argument(s)");
+            for (std::size_t i = 0; i < params.size(); ++i)
+                check_argument(expr.children[i], params[i]);
+
+            // 字面量模式在编译时构造; 无效的 I-Regexp 按 RFC 9535 结果为 LogicalFalse
+            if (params.size() == 2 && expr.children[1].kind == JsonPathExpr::Kind::literal)
+            {
+                if (auto const* pattern = std::get_if<std::string>(&expr.children[1].literal))
+                {
+                    try { expr.regex = std::make_shared<std::regex const>(*pattern, JSONPATH_REGEX_FLAGS); }
+                    catch (std::regex_error const&) { expr.regex_invalid = true; }
+                }
+                else
+                    expr.regex_invalid = true;
+            }
+            return expr;
+        }
+
+        // 字面量, 查询或函数调用
+        JsonPathExpr parse_operand()
+        {
+            JsonPathExpr expr;
+            char const c = peek();
+            if (c == '@' || c == '$')
+            {
+                ++m_pos;
+                expr.kind = JsonPathExpr::Kind::query;
+                expr.query.absolute = c == '$';
+                parse_segments(expr.query);
+                return expr;
+            }
+            if (c == '\'' || c == '"')
+            {
+                expr.literal = parse_string_literal();
+                return expr;
+            }
+            if (c == '-' || is_digit(c))
+            {
+                expr.literal = parse_number();
+                return expr;
+            }
+            for (auto [keyword, value] : {std::pair<std::string_view, JsonPathLiteral>{"true", true},
+                                          {"false", false}, {"null", nullptr}})
+            {
+                if (m_text.substr(m_pos, keyword.size()) == keyword && !is_name_first(peek(keyword.size())) &&
+                    !is_digit(peek(keyword.size())))
+                {
+                    m_pos += keyword.size();
+                    expr.literal = std::move(value);
+                    return expr;
+                }
+            }
+            if (c >= 'a' && c <= 'z')
+            {
+                enter();
+                expr = parse_function();
+                leave();
+                return expr;
+            }
+            fail("expected a literal, query or function");
+        }
+
+        // 函数参数可以是独立的操作数 (查询作为 NodesType), 也可以是逻辑表达式
+        JsonPathExpr parse_argument()
+        {
+            auto const save = m_pos;
+            if (peek() != '!' && peek() != '(')
+            {
+                auto operand = parse_operand();
+                auto const after = m_pos;
+                skip_blank();
+                if (peek() == ',' || peek() == ')')
+                {
+                    m_pos = after;
+                    return operand;
+                }
+                m_pos = save;
+            }
+            return parse_logical_or();
+        }
+
+        std::optional<JsonPathExpr::Op> parse_comparison_op()
+        {
+            using Op = JsonPathExpr::Op;
+            for (auto [token, op] : {std::pair<std::string_view, Op>{"==", Op::eq}, {"!=", Op::ne}, {"<=", Op::le},
+                                     {">=", Op::ge}, {"<", Op::lt}, {">", Op::gt}})
+                if (consume_after_blank(token))
+                    return op;
+            return std::nullopt;
+        }
+
+        JsonPathExpr to_test(JsonPathExpr operand)
+        {
+            if (operand.kind == JsonPathExpr::Kind::query)
+                operand.kind = JsonPathExpr::Kind::exists;
+            else if (operand.type() != JsonPathExpr::Type::logical)
+                fail("expression cannot be used as a test");
+            return operand;
+        }
+
+        JsonPathExpr parse_basic()
+        {
+            if (consume('!'))
+            {
+                skip_blank();
+                JsonPathExpr expr;
+                expr.kind = JsonPathExpr::Kind::logical_not;
+                if (consume('('))
+                {
+                    skip_blank();
+                    expr.children.push_back(parse_logical_or());
+                    skip_blank();
+                    expect(')');
+                }
+                else
+                    expr.children.push_back(to_test(parse_operand()));
+                return expr;
+            }
+            if (consume('('))
+            {
+                skip_blank();
+                auto expr = parse_logical_or();
+                skip_blank();
+                expect(')');
+                return expr;
+            }
+
+            auto lhs = parse_operand();
+            auto const op = parse_comparison_op();
+            if (!op)
+                return to_test(std::move(lhs));
+            skip_blank();
+            auto rhs = parse_operand();
+            if (!lhs.is_value() || !rhs.is_value())
+                fail("comparison operands must be literals, singular queries or value functions");
+
+            JsonPathExpr expr;
+            expr.kind = JsonPathExpr::Kind::compare;
+            expr.op = *op;
+            expr.children.push_back(std::move(lhs));
+            expr.children.push_back(std::move(rhs));
+            return expr;
+        }
+
+        JsonPathExpr parse_logical_and()
+        {
+            auto expr = parse_basic();
+            while (consume_after_blank("&&"))
+            {
+                skip_blank();
+                if (expr.kind != JsonPathExpr::Kind::logical_and)
+                {
+                    JsonPathExpr conj;
+                    conj.kind = JsonPathExpr::Kind::logical_and;
+                    conj.children.push_back(std::move(expr));
+                    expr = std::move(conj);
+                }
+                expr.children.push_back(parse_basic());
+            }
+            return expr;
+        }
+
+        JsonPathExpr parse_logical_or()
+        {
+            enter();
+            auto expr = parse_logical_and();
+            while (consume_after_blank("||"))
+            {
+                skip_blank();
+                if (expr.kind != JsonPathExpr::Kind::logical_or)
+                {
+                    JsonPathExpr disj;
+                    disj.kind = JsonPathExpr::Kind::logical_or;
+                    disj.children.push_back(std::move(expr));
+                    expr = std::move(disj);
+                }
+                expr.children.push_back(parse_logical_and());
+            }
+            leave();
+            return expr;
+        }
+
+    public:
+        explicit JsonPathParser(std::string_view text): m_text(text) {}
+
+        JsonPathQuery parse()
+        {
+            if (!consume('$'))
+                fail("a query must start with '$'");
+            JsonPathQuery query;
+            parse_segments(query);
+            if (!at_end())
+                fail("unexpected character");
+            return query;
+        }
+    }; // class JsonPathParser
+
+    /*
+     * Runs a compiled query against a document. Filters over arrays with at least min_parallel_elements
+     * elements are evaluated in contiguous batches on worker threads; the results keep document order.
+     * Raw (lazily parsed) subtrees are opaque to the engine; materialize() them first.
+     */
+    template <typename JsonT>
+    class JsonPathEvaluator
+    {
+    public:
+        using Nodes = std::vector<JsonT const*>;
+        using Located = std::pair<JsonT const*, std::string>; // 节点及其规范化路径
+
+    private:
+        using Expr = JsonPathExpr;
+        using Selector = JsonPathSelector;
+
+        struct Value
+        {
+            enum class Kind : std::uint8_t { nothing, node, literal, integer };
+
+            Kind kind = Kind::nothing;
+            JsonT const* node = nullptr;
+            JsonPathLiteral const* literal = nullptr;
+            std::int64_t integer = 0;
+        };
+
+        // 比较时的统一视图
+        struct Scalar
+        {
+            enum class Kind : std::uint8_t { nothing, null, boolean, number, string, structured };
+
+            Kind kind = Kind::nothing;
+            bool boolean = false;
+            bool is_int = false;
+            std::int64_t integer = 0;
+            double number = 0;
+            std::string_view text;
+            JsonT const* node = nullptr;
+        };
+
+        JsonT const& m_root;
+        JsonPathOptions m_options;
+        unsigned m_threads;
+
+        static std::size_t normalize(std::int64_t index, std::size_t size) noexcept
+        {
+            return static_cast<std::size_t>(index >= 0 ? index : static_cast<std::int64_t>(size) + index);
+        }
+
+        static Scalar number_scalar(std::int64_t value) noexcept
+        {
+            Scalar s;
+            s.kind = Scalar::Kind::number;
+            s.is_int = true;
+            s.integer = value;
+            s.number = static_cast<double>(value);
+            return s;
+        }
+
+        static Scalar to_scalar(Value const& value)
+        {
+            Scalar s;
+            switch (value.kind)
+            {
+                case Value::Kind::nothing:
+                    return s;
+                case Value::Kind::integer:
+                    return number_scalar(value.integer);
+                case Value::Kind::literal:
+                    std::visit([&](auto const& lit)
+                    {
+                        using T = std::decay_t<decltype(lit)>;
+                        if constexpr (std::is_same_v<T, std::nullptr_t>)
+                            s.kind = Scalar::Kind::null;
+                        else if constexpr (std::is_same_v<T, bool>)
+                            s.kind = Scalar::Kind::boolean, s.boolean = lit;
+                        else if constexpr (std::is_same_v<T, std::int64_t>)
+                            s = number_scalar(lit);
+                        else if constexpr (std::is_same_v<T, double>)
+                            s.kind = Scalar::Kind::number, s.number = lit;
+                        else
+                            s.kind = Scalar::Kind::string, s.text = lit;
+                    }, *value.literal);
+                    return s;
+                case Value::Kind::node:
+                    break;
+            }
+
+            JsonT const& node = *value.node;
+            if (node.is_null())
+                s.kind = Scalar::Kind::null;
+            else if (auto const* b = node.get_if_bool())
+                s.kind = Scalar::Kind::boolean, s.boolean = *b;
+            else if (auto const* i = node.get_if_int())
+                s = number_scalar(static_cast<std::int64_t>(*i));
+            else if (auto const* f = node.get_if_float())
+                s.kind = Scalar::Kind::number, s.number = static_cast<double>(*f);
+            else if (auto const* str = node.get_if_string())
+                s.kind = Scalar::Kind::string, s.text = std::string_view(str->data(), str->size());
+            else
+                s.kind = Scalar::Kind::structured, s.node = &node;
+            return s;
+        }
+
+        static bool equal(Scalar const& a, Scalar const& b)
+        {
+            if (a.kind != b.kind)
+                return false;
+            switch (a.kind)
+            {
+                case Scalar::Kind::nothing:
+                case Scalar::Kind::null: return true;
+                case Scalar::Kind::boolean: return a.boolean == b.boolean;
+                case Scalar::Kind::number: return a.is_int && b.is_int ? a.integer == b.integer : a.number == b.number;
+                case Scalar::Kind::string: return a.text == b.text;
+                case Scalar::Kind::structured: return *a.node == *b.node;
+            }
+            return false;
+        }
+
+        // 只有数字和字符串之间有序; UTF-8 字节序即码点序
+        static bool less(Scalar const& a, Scalar const& b)
+        {
+            if (a.kind != b.kind)
+                return false;
+            if (a.kind == Scalar::Kind::number)
+                return a.is_int && b.is_int ? a.integer < b.integer : a.number < b.number;
+            if (a.kind == Scalar::Kind::string)
+                return a.text < b.text;
+            return false;
+        }
+
+        static bool compare(Expr::Op op, Scalar const& a, Scalar const& b)
+        {
+            switch (op)
+            {
+                case Expr::Op::eq: return equal(a, b);
+                case Expr::Op::ne: return !equal(a, b);
+                case Expr::Op::lt: return less(a, b);
+                case Expr::Op::le: return less(a, b) || equal(a, b);
+                case Expr::Op::gt: return less(b, a);
+                case Expr::Op::ge: return less(b, a) || equal(a, b);
+            }
+            return false;
+        }
+
+        static std::size_t utf8_length(std::string_view text) noexcept
+        {
+            return static_cast<std::size_t>(std::count_if(text.begin(), text.end(),
+                [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+        }
+
+        // 单值查询不分配节点列表
+        JsonT const* resolve_singular(JsonPathQuery const& query, JsonT const& current) const
+        {
+            JsonT const* node = query.absolute ? &m_root : &current;
+            for (auto const& segment : query.segments)
+            {
+                auto const& selector = segment.selectors.front();
+                if (selector.kind == Selector::Kind::name)
+                {
+                    auto const* obj = node->get_if_object();
+                    if (!obj)
+                        return nullptr;
+                    auto const it = obj->find(selector.name);
+                    if (it == obj->end())
+                        return nullptr;
+                    node = &it->second;
+                }
+                else
+                {
+                    auto const* arr = node->get_if_array();
+                    if (!arr)
+                        return nullptr;
+                    auto const i = normalize(selector.index, arr->size());
+                    if (i >= arr->size())
+                        return nullptr;
+                    node = &(*arr)[i];
+                }
+            }
+            return node;
+        }
+
+        Value value_of(Expr const& expr, JsonT const& current) const
+        {
+            Value value;
+            switch (expr.kind)
+            {
+                case Expr::Kind::literal:
+                    value.kind = Value::Kind::literal;
+                    value.literal = &expr.literal;
+                    break;
+                case Expr::Kind::query:
+                    value.node = resolve_singular(expr.query, current);
+                    if (value.node)
+                        value.kind = Value::Kind::node;
+                    break;
+                default: // 返回 ValueType 的函数
+                    value = call_value_function(expr, current);
+            }
+            return value;
+        }
+
+        Value call_value_function(Expr const& expr, JsonT const& current) const
+        {
+            Value result;
+            switch (expr.function)
+            {
+                case JsonPathFunction::length:
+                {
+                    auto const arg = value_of(expr.children[0], current);
+                    auto const s = to_scalar(arg);
+                    if (s.kind == Scalar::Kind::string)
+                        result.kind = Value::Kind::integer, result.integer = static_cast<std::int64_t>(utf8_length(s.text));
+                    else if (s.kind == Scalar::Kind::structured && (s.node->is_array() || s.node->is_object()))
+                        result.kind = Value::Kind::integer, result.integer = static_cast<std::int64_t>(s.node->size());
+                    break;
+                }
+                case JsonPathFunction::count:
+                    result.kind = Value::Kind::integer;
+                    result.integer = static_cast<std::int64_t>(run(expr.children[0].query, current).size());
+                    break;
+                case JsonPathFunction::value:
+                {
+                    auto const nodes = run(expr.children[0].query, current);
+                    if (nodes.size() == 1)
+                        result.kind = Value::Kind::node, result.node = nodes.front();
+                    break;
+                }
+                default:
+                    break;
+            }
+            return result;
+        }
+
+        bool call_regex_function(Expr const& expr, JsonT const& current) const
+        {
+            if (expr.regex_invalid)
+                return false;
+            auto const subject = to_scalar(value_of(expr.children[0], current));
+            if (subject.kind != Scalar::Kind::string)
+                return false;
+
+            auto const matches = [&](std::regex const& re)
+            {
+                auto const first = subject.text.data();
+                auto const last = first + subject.text.size();
+                return expr.function == JsonPathFunction::match ? std::regex_match(first, last, re)
+                                                                : std::regex_search(first, last, re);
+            };
+            if (expr.regex)
+                return matches(*expr.regex);
+
+            // 模式来自文档: 每次求值时编译
+            auto const pattern = to_scalar(value_of(expr.children[1], current));
+            if (pattern.kind != Scalar::Kind::string)
+                return false;
+            try { return matches(std::regex(pattern.text.data(), pattern.text.size(), JSONPATH_REGEX_FLAGS)); }
+            catch (std::regex_error const&) { return false; }
+        }
+
+        bool test(Expr const& expr, JsonT const& current) const
+        {
+            switch (expr.kind)
+            {
+                case Expr::Kind::logical_or:
+                    return std::any_of(expr.children.begin(), expr.children.end(),
+                                       [&](Expr const& e) { return test(e, current); });
+                case Expr::Kind::logical_and:
+                    return std::all_of(expr.children.begin(), expr.children.end(),
+                                       [&](Expr const& e) { return test(e, current); });
+                case Expr::Kind::logical_not:
+                    return !test(expr.children[0], current);
+                case Expr::Kind::compare:
+                    return compare(expr.op, to_scalar(value_of(expr.children[0], current)),
+                                   to_scalar(value_of(expr.children[1], current)));
+                case Expr::Kind::exists:
+                    return expr.query.singular ? resolve_singular(expr.query, current) != nullptr
+                                               : !run(expr.query, current).empty();
+                case Expr::Kind::function:
+                    return call_regex_function(expr, current);
+                default:
+                    return false;
+            }
+        }
+
+        // 选择器的输出: 只收集节点, 或同时由父节点的路径和子节点的位置构造规范化路径
+        struct NodeSink
+        {
+            Nodes& out;
+            template <typename PositionT>
+            void operator()(JsonT const* child, PositionT const&) const { out.push_back(child); }
+        };
+
+        struct PathSink
+        {
+            std::vector<Located>& out;
+            std::string const& parent;
+
+            void operator()(JsonT const* child, std::size_t index) const
+            {
+                out.emplace_back(child, parent + '[' + std::to_string(index) + ']');
+            }
+            template <typename KeyT>
+            void operator()(JsonT const* child, KeyT const& key) const
+            {
+                std::string path = parent;
+                append_normalized_name(path, std::string_view(key.data(), key.size()));
+                out.emplace_back(child, std::move(path));
+            }
+        };
+
+        // RFC 9535 2.7: 名称使用单引号, 只转义必须转义的字符
+        static void append_normalized_name(std::string& path, std::string_view name)
+        {
+            path += "['";
+            for (char const c : name)
+            {
+                switch (c)
+                {
+                    case '\b': path += "\\b"; break;
+                    case '\f': path += "\\f"; break;
+                    case '\n': path += "\\n"; break;
+                    case '\r': path += "\\r"; break;
+                    case '\t': path += "\\t"; break;
+                    case '\'': path += "\\'"; break;
+                    case '\\': path += "\\\\"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            path += "\\u00";
+                            path += "0123456789abcdef"[static_cast<unsigned char>(c) >> 4];
+                            path += "0123456789abcdef"[c & 0xF];
+                        }
+                        else
+                            path += c;
+                }
+            }
+            path += "']";
+        }
+
+        template <typename SinkT>
+        void filter_array(Expr const& filter, typename JsonT::array const& arr, SinkT const& sink) const
+        {
+            if (arr.size() < m_options.min_parallel_elements || m_threads <= 1)
+            {
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                    if (test(filter, arr[i]))
+                        sink(&arr[i], i);
+                return;
+            }
+
+            // 分批并行求值谓词, 再按原顺序收集; 批内的嵌套过滤顺序执行
+            std::vector<char> keep(arr.size());
+            std::size_t const batch_count = std::min<std::size_t>(arr.size(), std::size_t(m_threads) * 4);
+            JsonPathOptions sequential = m_options;
+            sequential.threads = 1;
+            JsonPathEvaluator const worker(m_root, sequential);
+            run_parallel(batch_count, m_threads, [&](std::size_t batch)
+            {
+                std::size_t const begin = arr.size() * batch / batch_count;
+                std::size_t const end = arr.size() * (batch + 1) / batch_count;
+                for (std::size_t i = begin; i < end; ++i)
+                    keep[i] = worker.test(filter, arr[i]);
+            });
+            for (std::size_t i = 0; i < arr.size(); ++i)
+                if (keep[i])
+                    sink(&arr[i], i);
+        }
+
+        template <typename SinkT>
+        void apply_selector(Selector const& selector, JsonT const& node, SinkT const& sink) const
+        {
+            auto const* arr = node.get_if_array();
+            auto const* obj = arr ? nullptr : node.get_if_object();
+            switch (selector.kind)
+            {
+                case Selector::Kind::name:
+                    if (obj)
+                        if (auto const it = obj->find(selector.name); it != obj->end())
+                            sink(&it->second, it->first);
+                    break;
+                case Selector::Kind::wildcard:
+                    if (arr)
+                        for (std::size_t i = 0; i < arr->size(); ++i)
+                            sink(&(*arr)[i], i);
+                    else if (obj)
+                        for (auto const& item : *obj)
+                            sink(&item.second, item.first);
+                    break;
+                case Selector::Kind::index:
+                    if (arr)
+                        if (auto const i = normalize(selector.index, arr->size()); i < arr->size())
+                            sink(&(*arr)[i], i);
+                    break;
+                case Selector::Kind::slice:
+                    if (arr)
+                        apply_slice(selector, *arr, sink);
+                    break;
+                case Selector::Kind::filter:
+                    if (arr)
+                        filter_array(*selector.filter, *arr, sink);
+                    else if (obj)
+                        for (auto const& item : *obj)
+                            if (test(*selector.filter, item.second))
+                                sink(&item.second, item.first);
+                    break;
+            }
+        }
+
+        // RFC 9535 2.3.4.2.2
+        template <typename SinkT>
+        static void apply_slice(Selector const& selector, typename JsonT::array const& arr, SinkT const& sink)
+        {
+            auto const len = static_cast<std::int64_t>(arr.size());
+            auto const step = selector.step;
+            if (step == 0)
+                return;
+            auto const norm = [len](std::int64_t i) { return i >= 0 ? i : len + i; };
+            if (step > 0)
+            {
+                auto const lower = std::clamp<std::int64_t>(norm(selector.start.value_or(0)), 0, len);
+                auto const upper = std::clamp<std::int64_t>(norm(selector.end.value_or(len)), 0, len);
+                for (auto i = lower; i < upper; i += step)
+                    sink(&arr[static_cast<std::size_t>(i)], static_cast<std::size_t>(i));
+            }
+            else
+            {
+                auto const upper = std::clamp<std::int64_t>(norm(selector.start.value_or(len - 1)), -1, len - 1);
+                auto const lower = std::clamp<std::int64_t>(norm(selector.end.value_or(-len - 1)), -1, len - 1);
+                for (auto i = upper; lower < i; i += step)
+                    sink(&arr[static_cast<std::size_t>(i)], static_cast<std::size_t>(i));
+            }
+        }
+
+        // 先序遍历: 节点先于其后代, 数组元素按顺序
+        void apply_descendant(JsonPathSegment const& segment, JsonT const& node, Nodes& out) const
+        {
+            for (auto const& selector : segment.selectors)
+                apply_selector(selector, node, NodeSink{out});
+            if (auto const* arr = node.get_if_array())
+                for (auto const& item : *arr)
+                    apply_descendant(segment, item, out);
+            else if (auto const* obj = node.get_if_object())
+                for (auto const& item : *obj)
+                    apply_descendant(segment, item.second, out);
+        }
+
+        void locate_descendant(JsonPathSegment const& segment, Located const& located, std::vector<Located>& out) const
+        {
+            auto const& [node, path] = located;
+            for (auto const& selector : segment.selectors)
+                apply_selector(selector, *node, PathSink{out, path});
+            std::vector<Located> children;
+            apply_selector(Selector{}, *node, PathSink{children, path}); // 通配符: 按顺序的全部子节点
+            for (auto const& child : children)
+                locate_descendant(segment, child, out);
+        }
+
+    public:
+        JsonPathEvaluator(JsonT const& root, JsonPathOptions const& options)
+            : m_root(root), m_options(options),
+              m_threads(options.threads != 0 ? options.threads : hardware_threads()) {}
+
+        Nodes run(JsonPathQuery const& query, JsonT const& current) const
+        {
+            Nodes nodes{query.absolute ? &m_root : &current};
+            Nodes next;
+            for (auto const& segment : query.segments)
+            {
+                next.clear();
+                for (auto const* node : nodes)
+                {
+                    if (segment.descendant)
+                        apply_descendant(segment, *node, next);
+                    else
+                        for (auto const& selector : segment.selectors)
+                            apply_selector(selector, *node, NodeSink{next});
+                }
+                nodes.swap(next);
+                if (nodes.empty())
+                    break;
+            }
+            return nodes;
+        }
+
+        // 与 run() 相同的节点列表, 同时给出每个节点的规范化路径 (RFC 9535 2.7)
+        std::vector<Located> locate(JsonPathQuery const& query) const
+        {
+            std::vector<Located> nodes;
+            nodes.emplace_back(&m_root, "$");
+            std::vector<Located> next;
+            for (auto const& segment : query.segments)
+            {
+                next.clear();
+                for (auto const& located : nodes)
+                {
+                    if (segment.descendant)
+                        locate_descendant(segment, located, next);
+                    else
+                        for (auto const& selector : segment.selectors)
+                            apply_selector(selector, *located.first, PathSink{next, located.second});
+                }
+                nodes.swap(next);
+                if (nodes.empty())
+                    break;
+            }
+            return nodes;
+        }
+    }; // class JsonPathEvaluator
+}
+
+namespace jsonpp
+{
+    /*
+     * A JSONPath (RFC 9535) query compiled once and run against any number of documents.
+     * Supports name/index/wildcard/slice/filter selectors, descendant segments and the
+     * length(), count(), match(), search() and value() functions. match()/search() use
+     * std::regex (ECMAScript) as an approximation of I-Regexp: '.' excludes \n and \r as in I-Regexp,
+     * but matches a single byte rather than a code point.
+     *
+     *     jsonpp::json_path const cheap("$.store.book[?@.price < 10].title");
+     *     for (auto const* title : cheap.select(doc)) ...
+     */
+    class json_path
+    {
+        details::JsonPathQuery m_query;
+
+    public:
+        explicit json_path(std::string_view expression)
+            : m_query(details::JsonPathParser(expression).parse()) {}
+
+        // 最多选中一个节点 (只含 name/index 子段)
+        bool is_singular() const noexcept { return m_query.singular; }
+
+        // 结果指向 document 内部, 按 RFC 9535 的节点列表顺序, 可能包含重复节点
+        template <typename JsonT>
+        std::vector<JsonT const*> select(JsonT const& document, details::JsonPathOptions const& options = {}) const
+        {
+            return details::JsonPathEvaluator<JsonT>(document, options).run(m_query, document);
+        }
+
+        // Normalized Paths (RFC 9535 2.7) of the selected nodes, e.g. "$['store']['book'][0]", in select() order
+        template <typename JsonT>
+        std::vector<std::string> select_paths(JsonT const& document, details::JsonPathOptions const& options = {}) const
+        {
+            std::vector<std::string> paths;
+            for (auto& located : details::JsonPathEvaluator<JsonT>(document, options).locate(m_query))
+                paths.push_back(std::move(located.second));
+            return paths;
+        }
+
+        template <typename JsonT>
+        JsonT const* select_first(JsonT const& document, details::JsonPathOptions const& options = {}) const
+        {
+            auto const nodes = select(document, options);
+            return nodes.empty() ? nullptr : nodes.front();
+        }
+    }; // class json_path
+}
+
+#endif //JSONPP_JSON_PATH_HPP
@@ -0,0 +1,190 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_POINTER_HPP
+#define JSONPP_JSON_POINTER_HPP
+
+#include "jsonexception.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonpp::details
+{
+    // RFC 6901: "" 表示根, 否则每个引用标记以 '/' 开头, "~1" 表示 '/', "~0" 表示 '~'
+    inline std::vector<std::string> split_json_pointer(std::string_view pointer)
+    {
+        std::vector<std::string> tokens;
+        if (pointer.empty())
+            return tokens;
+        if (pointer.front() != '/')
+            throw JsonException("Invalid JSON Pointer \"" + std::string(pointer) + "\": must be empty or start with '/'");
+
+        for (std::size_t i = 1; ; ++i)
+        {
+            std::string token;
+            for (; i < pointer.size() && pointer[i] != '/'; ++i)
+            {
+                if (pointer[i] != '~')
+                    token += pointer[i];
+                else if (i + 1 < pointer.size() && (pointer[i + 1] == '0' || pointer[i + 1] == '1'))
+                    token += pointer[++i] == '0' ? '~' : '/';
+                else
+                    throw JsonException("Invalid JSON Pointer \"" + std::string(pointer) + "\": '~' must be followed by '0' or '1'");
+            }
+            tokens.push_back(std::move(token));
+            if (i >= pointer.size())
+                break;
+        }
+        return tokens;
+    }
+
+    // Appends "/" and the escaped reference token to a JSON Pointer
+    inline void append_json_pointer_token(std::string& pointer, std::string_view token)
+    {
+        pointer += '/';
+        for (char ch : token)
+        {
+            if (ch == '~')
+                pointer += "~0";
+            else if (ch == '/')
+                pointer += "~1";
+            else
+                pointer += ch;
+        }
+    }
+
+    // Array index token: "0" or digits without a leading zero. Returns false for anything else (including "-")
+    inline bool parse_json_pointer_index(std::string_view token, std::size_t& index) noexcept
+    {
+        if (token.empty() || (token.size() > 1 && token.front() == '0'))
+            return false;
+        std::size_t value = 0;
+        for (char ch : token)
+        {
+            if (ch < '0' || ch > '9')
+                return false;
+            auto const digit = static_cast<std::size_t>(ch - '0');
+            if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+                return false;
+            value = value * 10 + digit;
+        }
+        index = value;
+        return true;
+    }
+
+    // An object key with its hash computed in advance (see TransparentStringHash)
+    struct PrehashedKey
+    {
+        std::string_view key;
+        std::size_t hash;
+
+        char const* data() const noexcept { return key.data(); }
+        std::size_t size() const noexcept { return key.size(); }
+    };
+}
+
+namespace jsonpp
+{
+    /*
+     * An RFC 6901 JSON Pointer, split into reference tokens once. Array indices and key hashes are computed
+     * up front, so basic_json::at(json_pointer) and value(json_pointer, ...) walk the tree without parsing or allocating.
+     */
+    class json_pointer
+    {
+    public:
+        struct token
+        {
+            std::string key;          // unescaped reference token
+            std::size_t hash = 0;     // std::hash<std::string_view> of key
+            std::size_t index = 0;    // valid if is_index
+            bool is_index = false;    // "0", "1", ... without leading zeros
+            bool is_append = false;   // "-": the position after the last array element
+
+            details::PrehashedKey prehashed() const noexcept { return { key, hash }; }
+            bool operator==(token const& other) const noexcept { return key == other.key; }
+            bool operator!=(token const& other) const noexcept { return key != other.key; }
+        };
+
+        using const_iterator = std::vector<token>::const_iterator;
+
+        // The whole document ("")
+        json_pointer() = default;
+        explicit json_pointer(std::string_view pointer)
+        {
+            for (auto& key : details::split_json_pointer(pointer))
+                m_tokens.push_back(make_token(std::move(key)));
+        }
+
+        std::string to_string() const
+        {
+            std::string pointer;
+            for (auto const& t : m_tokens)
+                details::append_json_pointer_token(pointer, t.key);
+            return pointer;
+        }
+
+        bool empty() const noexcept { return m_tokens.empty(); }
+        std::size_t size() const noexcept { return m_tokens.size(); }
+        token const& operator[](std::size_t i) const noexcept { return m_tokens[i]; }
+        token const& back() const noexcept { return m_tokens.back(); }
+        const_iterator begin() const noexcept { return m_tokens.begin(); }
+        const_iterator end() const noexcept { return m_tokens.end(); }
+
+        json_pointer parent() const
+        {
+            json_pointer result;
+            if (!m_tokens.empty())
+                result.m_tokens.assign(m_tokens.begin(), m_tokens.end() - 1);
+            return result;
+        }
+
+        json_pointer& push_back(std::string key)
+        {
+            m_tokens.push_back(make_token(std::move(key)));
+            return *this;
+        }
+        json_pointer& push_back(std::size_t index) { return push_back(std::to_string(index)); }
+        void pop_back() { m_tokens.pop_back(); }
+
+        friend json_pointer operator/(json_pointer lhs, std::string key) { return std::move(lhs.push_back(std::move(key))); }
+        friend json_pointer operator/(json_pointer lhs, std::size_t index) { return std::move(lhs.push_back(index)); }
+
+        bool operator==(json_pointer const& other) const noexcept { return m_tokens == other.m_tokens; }
+        bool operator!=(json_pointer const& other) const noexcept { return !(*this == other); }
+
+    private:
+        std::vector<token> m_tokens;
+
+        static token make_token(std::string key)
+        {
+            token t;
+            t.hash = std::hash<std::string_view>{}(key);
+            t.is_index = details::parse_json_pointer_index(key, t.index);
+            t.is_append = key == "-";
+            t.key = std::move(key);
+            return t;
+        }
+    }; // class json_pointer
+}
+
+#endif //JSONPP_JSON_POINTER_HPP
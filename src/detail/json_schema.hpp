@@ -0,0 +1,670 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_SCHEMA_HPP
+#define JSONPP_JSON_SCHEMA_HPP
+
+#include "macro_def.hpp"
+#include "jsonexception.hpp"
+#include "json_fwd.hpp"
+#include "json_pointer.hpp"
+#include "json_stream_adaptor.hpp"
+#include "parser.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jsonpp
+{
+    namespace details
+    {
+        // One compiled (sub)schema; children are referenced by index into SchemaProgram::nodes
+        template <typename JsonT>
+        struct SchemaNode
+        {
+            static constexpr std::uint32_t NONE = 0xFFFFFFFF; // 不受约束的子值
+
+            enum TypeBits : std::uint8_t
+            {
+                T_NULL = 1, T_BOOLEAN = 2, T_INTEGER = 4, T_FRACTION = 8, // "number" = T_INTEGER | T_FRACTION
+                T_STRING = 16, T_ARRAY = 32, T_OBJECT = 64, T_ANY = 127
+            };
+
+            bool trivial = true; // 没有任何约束: 校验直接通过, 融合解析时交给普通解析器
+            std::uint8_t types = T_ANY;
+            std::optional<double> minimum, maximum, exclusive_minimum, exclusive_maximum;
+            std::optional<std::size_t> min_length, max_length, min_items, max_items, min_properties, max_properties;
+            std::shared_ptr<std::regex const> pattern;
+            std::vector<std::pair<std::string, std::uint32_t>> properties; // 按名称排序
+            std::vector<std::string> required;                              // 排序, 去重
+            std::uint32_t items = NONE;
+            std::uint32_t additional_properties = NONE;
+            std::optional<std::vector<JsonT>> enum_values; // enum 与 const
+
+            std::uint32_t property(std::string_view name) const noexcept
+            {
+                auto const it = std::lower_bound(properties.begin(), properties.end(), name,
+                    [](auto const& p, std::string_view n) { return std::string_view(p.first) < n; });
+                if (it != properties.end() && it->first == name)
+                    return it->second;
+                return additional_properties;
+            }
+        };
+
+        struct SchemaFailure
+        {
+            std::string message;
+            std::string location; // JSON Pointer, 失败后逐层向外补全
+
+            bool fail(std::string msg) { message = std::move(msg); return false; }
+
+            bool prefix(std::string_view token)
+            {
+                std::string p;
+                append_json_pointer_token(p, token);
+                location.insert(0, p);
+                return false;
+            }
+        };
+
+        /*
+         * A JSON Schema (draft 2020-12 subset) compiled into a flat node array. Immutable after construction,
+         * so one program can validate on any number of threads.
+         */
+        template <typename JsonT>
+        class SchemaProgram
+        {
+        public:
+            using Node = SchemaNode<JsonT>;
+            static constexpr std::uint32_t NONE = Node::NONE;
+
+        private:
+            std::vector<Node> m_nodes;
+
+            [[noreturn]] static void invalid(std::string const& keyword, char const* what)
+            {
+                throw JsonSchemaError("invalid schema: \"" + keyword + "\" " + what);
+            }
+
+            static double number_of(std::string const& keyword, JsonT const& value)
+            {
+                if (auto const* i = value.get_if_int())
+                    return static_cast<double>(*i);
+                if (auto const* f = value.get_if_float())
+                    return static_cast<double>(*f);
+                invalid(keyword, "must be a number");
+            }
+
+            static std::size_t count_of(std::string const& keyword, JsonT const& value)
+            {
+                auto const* i = value.get_if_int();
+                if (!i || *i < 0)
+                    invalid(keyword, "must be a non-negative integer");
+                return static_cast<std::size_t>(*i);
+            }
+
+            static std::uint8_t type_bit(std::string const& name)
+            {
+                if (name == "null") return Node::T_NULL;
+                if (name == "boolean") return Node::T_BOOLEAN;
+                if (name == "integer") return Node::T_INTEGER;
+                if (name == "number") return Node::T_INTEGER | Node::T_FRACTION;
+                if (name == "string") return Node::T_STRING;
+                if (name == "array") return Node::T_ARRAY;
+                if (name == "object") return Node::T_OBJECT;
+                invalid("type", "names an unknown type");
+            }
+
+            std::uint32_t compile(JsonT const& schema)
+            {
+                auto const index = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes.emplace_back();
+                if (auto const* b = schema.get_if_bool())
+                {
+                    if (!*b)
+                        m_nodes[index].trivial = false, m_nodes[index].types = 0;
+                    return index;
+                }
+                if (!schema.is_object())
+                    throw JsonSchemaError("invalid schema: a schema must be an object or a boolean");
+
+                Node node;
+                for (auto const& [keyword, value] : schema.as_object())
+                {
+                    if (keyword == "type")
+                    {
+                        node.types = 0;
+                        if (value.is_string())
+                            node.types = type_bit(value.as_string());
+                        else if (value.is_array())
+                            for (auto const& t : value.as_array())
+                            {
+                                if (!t.is_string())
+                                    invalid(keyword, "must be a string or an array of strings");
+                                node.types |= type_bit(t.as_string());
+                            }
+                        else
+                            invalid(keyword, "must be a string or an array of strings");
+                    }
+                    else if (keyword == "minimum") node.minimum = number_of(keyword, value);
+                    else if (keyword == "maximum") node.maximum = number_of(keyword, value);
+                    else if (keyword == "exclusiveMinimum") node.exclusive_minimum = number_of(keyword, value);
+                    else if (keyword == "exclusiveMaximum") node.exclusive_maximum = number_of(keyword, value);
+                    else if (keyword == "minLength") node.min_length = count_of(keyword, value);
+                    else if (keyword == "maxLength") node.max_length = count_of(keyword, value);
+                    else if (keyword == "minItems") node.min_items = count_of(keyword, value);
+                    else if (keyword == "maxItems") node.max_items = count_of(keyword, value);
+                    else if (keyword == "minProperties") node.min_properties = count_of(keyword, value);
+                    else if (keyword == "maxProperties") node.max_properties = count_of(keyword, value);
+                    else if (keyword == "pattern")
+                    {
+                        if (!value.is_string())
+                            invalid(keyword, "must be a string");
+                        try { node.pattern = std::make_shared<std::regex const>(value.as_string(), std::regex::ECMAScript); }
+                        catch (std::regex_error const&) { invalid(keyword, "is not a valid regular expression"); }
+                    }
+                    else if (keyword == "enum")
+                    {
+                        if (!value.is_array())
+                            invalid(keyword, "must be an array");
+                        node.enum_values.emplace(value.as_array().begin(), value.as_array().end());
+                    }
+                    else if (keyword == "const")
+                        node.enum_values.emplace(1, value);
+                    else if (keyword == "required")
+                    {
+                        if (!value.is_array())
+                            invalid(keyword, "must be an array of strings");
+                        for (auto const& name : value.as_array())
+                        {
+                            if (!name.is_string())
+                                invalid(keyword, "must be an array of strings");
+                            node.required.emplace_back(name.as_string());
+                        }
+                        std::sort(node.required.begin(), node.required.end());
+                        node.required.erase(std::unique(node.required.begin(), node.required.end()), node.required.end());
+                    }
+                    else if (keyword == "properties")
+                    {
+                        if (!value.is_object())
+                            invalid(keyword, "must be an object");
+                        for (auto const& [name, sub] : value.as_object())
+                            node.properties.emplace_back(name, compile(sub));
+                        std::sort(node.properties.begin(), node.properties.end());
+                    }
+                    else if (keyword == "items")
+                    {
+                        if (!value.is_object() && !value.is_bool())
+                            invalid(keyword, "must be a schema (use prefixItems for tuples)");
+                        node.items = compile(value);
+                    }
+                    else if (keyword == "additionalProperties")
+                        node.additional_properties = compile(value);
+                    else if (keyword == "$ref" || keyword == "$dynamicRef" || keyword == "allOf" || keyword == "anyOf" ||
+                             keyword == "oneOf" || keyword == "not" || keyword == "if" || keyword == "then" ||
+                             keyword == "else" || keyword == "prefixItems" || keyword == "contains" ||
+                             keyword == "patternProperties" || keyword == "propertyNames" ||
+                             keyword == "dependentSchemas" || keyword == "dependentRequired" ||
+                             keyword == "unevaluatedItems" || keyword == "unevaluatedProperties" ||
+                             keyword == "multipleOf" || keyword == "uniqueItems")
+                        throw JsonSchemaError("unsupported keyword \"" + keyword + "\"");
+                    // 其余关键字 ($schema, title, description, format, ...) 只是注解
+                }
+
+                // 子 schema 若全部不受约束, 视为 NONE, 运行时不必再查看
+                auto const constrained = [this](std::uint32_t i) { return i != NONE && !m_nodes[i].trivial; };
+                if (!constrained(node.items))
+                    node.items = NONE;
+                if (!constrained(node.additional_properties))
+                    node.additional_properties = NONE;
+                node.properties.erase(std::remove_if(node.properties.begin(), node.properties.end(),
+                    [&](auto const& p) { return !constrained(p.second) && node.additional_properties == NONE; }),
+                    node.properties.end());
+
+                node.trivial = node.types == Node::T_ANY && !node.minimum && !node.maximum && !node.exclusive_minimum &&
+                    !node.exclusive_maximum && !node.min_length && !node.max_length && !node.min_items && !node.max_items &&
+                    !node.min_properties && !node.max_properties && !node.pattern && node.properties.empty() &&
+                    node.required.empty() && node.items == NONE && node.additional_properties == NONE && !node.enum_values;
+                m_nodes[index] = std::move(node);
+                return index;
+            }
+
+            // JSON Schema 的相等: 数字按数值比较 (1 == 1.0)
+            static bool equal(JsonT const& a, JsonT const& b)
+            {
+                if (a.is_number() && b.is_number())
+                {
+                    if (a.is_int() && b.is_int())
+                        return a.as_int() == b.as_int();
+                    return number_value(a) == number_value(b);
+                }
+                if (a.type() != b.type())
+                    return false;
+                if (a.is_array())
+                {
+                    auto const& x = a.as_array();
+                    auto const& y = b.as_array();
+                    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), equal);
+                }
+                if (a.is_object())
+                {
+                    auto const& x = a.as_object();
+                    auto const& y = b.as_object();
+                    if (x.size() != y.size())
+                        return false;
+                    for (auto const& [key, value] : x)
+                    {
+                        auto const it = y.find(key);
+                        if (it == y.end() || !equal(value, it->second))
+                            return false;
+                    }
+                    return true;
+                }
+                return a == b;
+            }
+
+            static double number_value(JsonT const& v)
+            {
+                if (auto const* i = v.get_if_int())
+                    return static_cast<double>(*i);
+                return static_cast<double>(v.as_float());
+            }
+
+            static std::size_t utf8_length(std::string_view text) noexcept
+            {
+                return static_cast<std::size_t>(std::count_if(text.begin(), text.end(),
+                    [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+            }
+
+            static std::string type_names(std::uint8_t types)
+            {
+                static constexpr std::pair<std::uint8_t, char const*> names[] = {
+                    {Node::T_NULL, "null"}, {Node::T_BOOLEAN, "boolean"}, {Node::T_INTEGER | Node::T_FRACTION, "number"},
+                    {Node::T_INTEGER, "integer"}, {Node::T_STRING, "string"}, {Node::T_ARRAY, "array"}, {Node::T_OBJECT, "object"}};
+                if (types == 0)
+                    return "nothing (false schema)";
+                std::string out;
+                for (auto const& [bits, name] : names)
+                {
+                    if ((types & bits) != bits)
+                        continue;
+                    types &= static_cast<std::uint8_t>(~bits);
+                    out += out.empty() ? "" : " or ";
+                    out += name;
+                }
+                return out;
+            }
+
+        public:
+            explicit SchemaProgram(JsonT const& schema) { compile(schema); }
+
+            Node const& node(std::uint32_t index) const noexcept { return m_nodes[index]; }
+
+            static std::uint8_t type_bits(JsonT const& v) noexcept
+            {
+                switch (v.type())
+                {
+                    case Type::null: return Node::T_NULL;
+                    case Type::boolean: return Node::T_BOOLEAN;
+                    case Type::number_int: return Node::T_INTEGER;
+                    case Type::number_float:
+                    {
+                        auto const f = static_cast<double>(*v.get_if_float());
+                        return std::isfinite(f) && f == std::floor(f) ? Node::T_INTEGER : Node::T_FRACTION;
+                    }
+                    case Type::string: return Node::T_STRING;
+                    case Type::array: return Node::T_ARRAY;
+                    case Type::object: return Node::T_OBJECT;
+                    default: return 0;
+                }
+            }
+
+            static bool check_type(Node const& node, std::uint8_t bits, SchemaFailure& failure)
+            {
+                return (node.types & bits) != 0 || failure.fail("expected " + type_names(node.types));
+            }
+
+            // 只检查 v 自身 (不含子值) 的约束; v 的类型已检查过
+            static bool check_local(Node const& node, JsonT const& v, SchemaFailure& failure)
+            {
+                if (v.is_number())
+                {
+                    double const d = number_value(v);
+                    if (node.minimum && d < *node.minimum)
+                        return failure.fail("value is less than minimum");
+                    if (node.maximum && d > *node.maximum)
+                        return failure.fail("value is greater than maximum");
+                    if (node.exclusive_minimum && d <= *node.exclusive_minimum)
+                        return failure.fail("value is not greater than exclusiveMinimum");
+                    if (node.exclusive_maximum && d >= *node.exclusive_maximum)
+                        return failure.fail("value is not less than exclusiveMaximum");
+                }
+                else if (auto const* s = v.get_if_string())
+                {
+                    if (node.min_length || node.max_length)
+                    {
+                        auto const length = utf8_length(*s);
+                        if (node.min_length && length < *node.min_length)
+                            return failure.fail("string is shorter than minLength");
+                        if (node.max_length && length > *node.max_length)
+                            return failure.fail("string is longer than maxLength");
+                    }
+                    if (node.pattern && !std::regex_search(s->begin(), s->end(), *node.pattern))
+                        return failure.fail("string does not match pattern");
+                }
+                else if (v.is_array())
+                {
+                    if (node.min_items && v.size() < *node.min_items)
+                        return failure.fail("array has fewer items than minItems");
+                    if (node.max_items && v.size() > *node.max_items)
+                        return failure.fail("array has more items than maxItems");
+                }
+                else if (auto const* obj = v.get_if_object())
+                {
+                    if (node.min_properties && obj->size() < *node.min_properties)
+                        return failure.fail("object has fewer properties than minProperties");
+                    if (node.max_properties && obj->size() > *node.max_properties)
+                        return failure.fail("object has more properties than maxProperties");
+                    for (auto const& name : node.required)
+                        if (obj->find(name) == obj->end())
+                            return failure.fail("missing required property \"" + name + "\"");
+                }
+                if (node.enum_values && std::none_of(node.enum_values->begin(), node.enum_values->end(),
+                                                     [&](JsonT const& e) { return equal(e, v); }))
+                    return failure.fail("value is not one of the enum values");
+                return true;
+            }
+
+            bool validate(std::uint32_t index, JsonT const& v, SchemaFailure& failure) const
+            {
+                if (index == NONE)
+                    return true;
+                auto const& node = m_nodes[index];
+                if (node.trivial)
+                    return true;
+                if (v.is_raw())
+                    return validate(index, v.materialized(), failure);
+                if (!check_type(node, type_bits(v), failure) || !check_local(node, v, failure))
+                    return false;
+
+                if (auto const* arr = v.get_if_array(); arr && node.items != NONE)
+                {
+                    for (std::size_t i = 0; i < arr->size(); ++i)
+                        if (!validate(node.items, (*arr)[i], failure))
+                            return failure.prefix(std::to_string(i));
+                }
+                else if (auto const* obj = v.get_if_object(); obj && (!node.properties.empty() || node.additional_properties != NONE))
+                {
+                    for (auto const& [key, value] : *obj)
+                    {
+                        std::string_view const name(key.data(), key.size());
+                        if (!validate(node.property(name), value, failure))
+                            return failure.prefix(name);
+                    }
+                }
+                return true;
+            }
+        }; // class SchemaProgram
+
+        struct SchemaViolation
+        {
+            SchemaFailure failure;
+            std::size_t pos;
+        };
+
+        /*
+         * Parses a document while validating it against a SchemaProgram: the expected type is checked at the first
+         * character of every value, members and items are validated as soon as they are complete and maxItems/
+         * maxProperties as soon as they are exceeded, so an invalid document stops parsing at the first violation.
+         * Subtrees without constraints are handed to the regular Parser.
+         */
+        template <typename StreamT, typename JsonT>
+        class SchemaParser : public ParserBase<StreamT>
+        {
+        protected:
+            JSONPP_IMPORT_PARSERBASE_MEMBERS_
+
+        private:
+            using Program = SchemaProgram<JsonT>;
+            using Node = typename Program::Node;
+
+            Program const& m_program;
+            int m_nesting_depth = 0;
+
+            void skip_whitespace() noexcept
+            {
+                while (peek() == ' ' || peek() == '\n' || peek() == '\r' || peek() == '\t')
+                    advance();
+            }
+
+            [[noreturn]] static void violation(SchemaFailure failure, std::size_t pos) { throw SchemaViolation{std::move(failure), pos}; }
+
+            static std::uint8_t bits_from_first_char(int ch) noexcept
+            {
+                switch (ch)
+                {
+                    case '{': return Node::T_OBJECT;
+                    case '[': return Node::T_ARRAY;
+                    case '\"': return Node::T_STRING;
+                    case 't': case 'f': return Node::T_BOOLEAN;
+                    case 'n': return Node::T_NULL;
+                    default: // 非法字符留给 Parser 报告语法错误
+                        return (ch >= '0' && ch <= '9') || ch == '-' ? Node::T_INTEGER | Node::T_FRACTION : Node::T_ANY;
+                }
+            }
+
+            JsonT parse_array(Node const& node)
+            {
+                if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                    throw JsonDepthLimitExceeded(tell_pos());
+
+                typename JsonT::array arr;
+                auto const start = tell_pos();
+                advance(); // 跳过左 [
+                skip_whitespace();
+                while (!eof() && peek() != ']')
+                {
+                    try { arr.push_back(parse_value(node.items)); }
+                    catch (SchemaViolation& v)
+                    {
+                        v.failure.prefix(std::to_string(arr.size()));
+                        throw;
+                    }
+                    if (node.max_items && arr.size() > *node.max_items)
+                    {
+                        SchemaFailure failure;
+                        failure.fail("array has more items than maxItems");
+                        violation(std::move(failure), tell_pos());
+                    }
+                    skip_whitespace();
+
+                    if (peek() == ']')
+                        break;
+                    else if (peek() != ',')
+                    {
+                        JSONPP_CHECK_EOF_("array", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance(); // 跳过 ','
+                    skip_whitespace();
+                    if (peek() == ']')
+                        throw JsonParseError("Expected value after comma, but found ']' instead", tell_pos());
+                }
+                JSONPP_CHECK_EOF_("array", start);
+
+                advance(); // 跳过右 ]
+                --m_nesting_depth;
+                return {std::move(arr)};
+            }
+
+            JsonT parse_object(Node const& node)
+            {
+                if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                    throw JsonDepthLimitExceeded(tell_pos());
+
+                typename JsonT::object obj;
+                auto const start = tell_pos();
+                advance(); // 跳过左 {
+                skip_whitespace();
+                while (!eof() && peek() != '}')
+                {
+                    if (peek() != '\"') [[unlikely]]
+                        throw JsonParseError("Key of an object must be string", tell_pos());
+                    auto key = JSONStringParser<StreamT, JsonT>(m_stream, tell_pos()).parse();
+
+                    skip_whitespace();
+                    if (peek() != ':')
+                    {
+                        JSONPP_CHECK_EOF_("object", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance();
+                    skip_whitespace();
+
+                    std::string_view const name(key.data(), key.size());
+                    JsonT value;
+                    try { value = parse_value(node.property(name)); }
+                    catch (SchemaViolation& v)
+                    {
+                        v.failure.prefix(name);
+                        throw;
+                    }
+                    obj[std::move(key)] = std::move(value);
+                    if (node.max_properties && obj.size() > *node.max_properties)
+                    {
+                        SchemaFailure failure;
+                        failure.fail("object has more properties than maxProperties");
+                        violation(std::move(failure), tell_pos());
+                    }
+                    skip_whitespace();
+
+                    if (peek() == '}')
+                        break;
+                    else if (peek() != ',')
+                    {
+                        JSONPP_CHECK_EOF_("object", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance(); // skip comma
+                    skip_whitespace();
+                    if (peek() == '}')
+                        throw JsonParseError("Expected value after comma, but found '}' instead", tell_pos());
+                }
+                JSONPP_CHECK_EOF_("object", start);
+
+                advance(); // 跳过右 }
+                --m_nesting_depth;
+                return {std::move(obj)};
+            }
+
+            JsonT parse_value(std::uint32_t index)
+            {
+                if (eof())
+                    throw JsonParseError("Unexpected end of file");
+                if (index == Program::NONE || m_program.node(index).trivial)
+                    return Parser<StreamT, JsonT>(m_stream).parse_one();
+
+                auto const& node = m_program.node(index);
+                std::size_t const pos = tell_pos();
+                int const ch = peek();
+                SchemaFailure failure;
+                if (!Program::check_type(node, bits_from_first_char(ch), failure)) // 值的第一个字符已决定类型
+                    violation(std::move(failure), pos);
+
+                JsonT value = ch == '{' ? parse_object(node)
+                            : ch == '[' ? parse_array(node)
+                            : Parser<StreamT, JsonT>(m_stream).parse_one();
+                if (!Program::check_type(node, Program::type_bits(value), failure) || !Program::check_local(node, value, failure))
+                    violation(std::move(failure), pos);
+                return value;
+            }
+
+        public:
+            SchemaParser(StreamT& stream, Program const& program): ParserBase<StreamT>(stream), m_program(program) {}
+
+            JsonT parse()
+            {
+                skip_whitespace();
+                JsonT result;
+                try { result = parse_value(0); }
+                catch (SchemaViolation& v)
+                {
+                    throw JsonSchemaError(v.failure.message, v.failure.location, v.pos);
+                }
+                skip_whitespace();
+                if (!eof())
+                    throw JsonParseError("Unexpected character(s) after JSON value");
+                return result;
+            }
+        }; // class SchemaParser
+    }
+
+    /*
+     * A JSON Schema (draft 2020-12 subset) compiled once and reused, also concurrently from many threads.
+     * Supported: boolean schemas, type, enum, const, minimum, maximum, exclusiveMinimum, exclusiveMaximum,
+     * minLength, maxLength, pattern (std::regex ECMAScript), items, minItems, maxItems, properties,
+     * additionalProperties, required, minProperties, maxProperties. Other applicators (and $ref) throw
+     * JsonSchemaError at construction instead of being silently ignored; annotations are ignored.
+     */
+    template <typename JsonT = json>
+    class json_schema
+    {
+        details::SchemaProgram<JsonT> m_program;
+
+    public:
+        explicit json_schema(JsonT const& schema): m_program(schema) {}
+
+        bool is_valid(JsonT const& instance) const
+        {
+            details::SchemaFailure failure;
+            return m_program.validate(0, instance, failure);
+        }
+
+        // Throws JsonSchemaError describing the first violation
+        void validate(JsonT const& instance) const
+        {
+            details::SchemaFailure failure;
+            if (!m_program.validate(0, instance, failure))
+                throw JsonSchemaError(failure.message, failure.location);
+        }
+
+        // Parses and validates in one pass; stops at the first syntax error (JsonParseError) or violation (JsonSchemaError)
+        JsonT parse(std::string_view json_doc) const
+        {
+            details::StringViewStream svs(json_doc);
+            return details::SchemaParser<details::StringViewStream, JsonT>(svs, m_program).parse();
+        }
+
+        JsonT parse(std::istream& json_istream) const
+        {
+            details::IStreamStream iss(json_istream);
+            return details::SchemaParser<details::IStreamStream, JsonT>(iss, m_program).parse();
+        }
+    }; // class json_schema
+}
+
+#endif //JSONPP_JSON_SCHEMA_HPP
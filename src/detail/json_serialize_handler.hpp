@@ -18,9 +18,24 @@ limitations under the License.
 #ifndef JSONPP_JSON_SERIALIZE_HANDLER_HPP
 #define JSONPP_JSON_SERIALIZE_HANDLER_HPP
 
+#include "macro_def.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <ostream>
+#include <vector>
+
+#if JSONPP_HAS_POSIX_IO
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 namespace jsonpp::details
 {
@@ -75,6 +90,398 @@ namespace jsonpp::details
         }
     };
 
+    /*
+     * Counts the bytes a serialization would produce without writing them anywhere.
+     */
+    class SizeCountingSerializeHandler
+    {
+        std::size_t m_size = 0;
+
+    public:
+        void append(char) noexcept { ++m_size; }
+        void append(std::string_view str) noexcept { m_size += str.size(); }
+        void append(char const*, std::size_t length) noexcept { m_size += length; }
+
+        std::size_t size() const noexcept { return m_size; }
+    };
+
+    /*
+     * Writes into a caller-provided buffer of fixed capacity. Output beyond the capacity is dropped,
+     * but still counted, so size() always reports the length the complete serialization requires
+     * (like std::snprintf).
+     */
+    class FixedBufferSerializeHandler
+    {
+        char* m_buffer;
+        std::size_t m_capacity;
+        std::size_t m_size = 0;
+
+    public:
+        FixedBufferSerializeHandler(char* buffer, std::size_t capacity) noexcept
+            : m_buffer(buffer), m_capacity(capacity) {}
+
+        template <std::size_t N>
+        explicit FixedBufferSerializeHandler(char (&buffer)[N]) noexcept
+            : m_buffer(buffer), m_capacity(N) {}
+
+        void append(char ch) noexcept
+        {
+            if (m_size < m_capacity)
+                m_buffer[m_size] = ch;
+            ++m_size;
+        }
+
+        void append(std::string_view str) noexcept
+        {
+            append(str.data(), str.size());
+        }
+
+        void append(char const* cstr, std::size_t length) noexcept
+        {
+            if (m_size < m_capacity)
+                std::memcpy(m_buffer + m_size, cstr, std::min(length, m_capacity - m_size));
+            m_size += length;
+        }
+
+        // 实际写入缓冲区的字节数
+        std::size_t written() const noexcept { return std::min(m_size, m_capacity); }
+        // 完整输出所需的字节数 (可能大于容量)
+        std::size_t size() const noexcept { return m_size; }
+        bool truncated() const noexcept { return m_size > m_capacity; }
+        std::string_view view() const noexcept { return { m_buffer, written() }; }
+    };
+
+    /*
+     * Sinks for BufferedSerializeHandler.
+     * write(head, tail) must write both pieces in order and return false on failure;
+     * error() reports an errno-style code for the last failure (0 if unknown).
+     */
+    class OStreamSink
+    {
+        std::ostream& m_out;
+
+    public:
+        explicit OStreamSink(std::ostream& os) noexcept: m_out(os) {}
+
+        bool write(std::string_view head, std::string_view tail)
+        {
+            m_out.write(head.data(), static_cast<std::streamsize>(head.size()));
+            m_out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+            return !m_out.bad();
+        }
+
+        bool flush() { return !m_out.flush().bad(); }
+        int error() const noexcept { return 0; }
+    };
+
+    class CFileSink
+    {
+        std::FILE* m_file;
+        int m_error = 0;
+
+        bool write_all(std::string_view data) noexcept
+        {
+            if (data.empty() || std::fwrite(data.data(), 1, data.size(), m_file) == data.size())
+                return true;
+            m_error = errno;
+            return false;
+        }
+
+    public:
+        explicit CFileSink(std::FILE* file) noexcept: m_file(file) {}
+
+        bool write(std::string_view head, std::string_view tail) noexcept
+        {
+            return write_all(head) && write_all(tail);
+        }
+
+        bool flush() noexcept
+        {
+            if (std::fflush(m_file) == 0)
+                return true;
+            m_error = errno;
+            return false;
+        }
+
+        int error() const noexcept { return m_error; }
+    };
+
+#if JSONPP_HAS_POSIX_IO
+    /*
+     * Writes all of iov[0, count) to fd, retrying on EINTR and partial writes and splitting
+     * the list into IOV_MAX-sized batches. The iovec array is modified. Returns 0 or an errno value.
+     */
+    inline int writev_all(int fd, iovec* iov, std::size_t count) noexcept
+    {
+#ifdef IOV_MAX
+        constexpr std::size_t max_batch = IOV_MAX;
+#else
+        constexpr std::size_t max_batch = 1024;
+#endif
+        while (count > 0)
+        {
+            // 跳过已写完的部分
+            if (iov->iov_len == 0)
+            {
+                ++iov;
+                --count;
+                continue;
+            }
+            ssize_t n = ::writev(fd, iov, static_cast<int>(std::min(count, max_batch)));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return errno;
+            }
+            auto written = static_cast<std::size_t>(n);
+            while (count > 0 && written >= iov->iov_len)
+            {
+                written -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) // 调整被部分写入的 iovec
+            {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+                iov->iov_len -= written;
+            }
+        }
+        return 0;
+    }
+
+    // 直接写入文件描述符; 一次 write 的两段数据由同一个 writev() 调用写出
+    class FdSink
+    {
+        int m_fd;
+        int m_error = 0;
+
+    public:
+        explicit FdSink(int fd) noexcept: m_fd(fd) {}
+
+        bool write(std::string_view head, std::string_view tail) noexcept
+        {
+            iovec iov[2] = {
+                { const_cast<char*>(head.data()), head.size() },
+                { const_cast<char*>(tail.data()), tail.size() }
+            };
+            m_error = writev_all(m_fd, iov, 2);
+            return m_error == 0;
+        }
+
+        bool flush() noexcept { return true; }
+        int error() const noexcept { return m_error; }
+    };
+#endif
+
+    /*
+     * Collects output in a buffer and hands it to SinkT in large blocks. The buffer is either allocated
+     * (buffer_size bytes) or supplied by the caller, e.g. on the stack; a caller-supplied buffer must be
+     * non-empty and outlive the handler.
+     * Once a write fails, bad() becomes true and further output is discarded.
+     * The destructor hands remaining output to the sink but swallows errors; call drain() or flush() to observe them.
+     */
+    template <typename SinkT>
+    class BufferedSerializeHandler
+    {
+        SinkT m_sink;
+        std::unique_ptr<char[]> m_storage;
+        char* m_buffer;
+        std::size_t m_capacity;
+        std::size_t m_size = 0;
+        bool m_bad = false;
+
+        void write_through(std::string_view tail)
+        {
+            if (!m_bad && !m_sink.write({ m_buffer, m_size }, tail))
+                m_bad = true;
+            m_size = 0;
+        }
+
+    public:
+        static constexpr std::size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+        explicit BufferedSerializeHandler(SinkT sink, std::size_t buffer_size = DEFAULT_BUFFER_SIZE)
+            : m_sink(std::move(sink)),
+              m_storage(new char[std::max<std::size_t>(buffer_size, 1)]),
+              m_buffer(m_storage.get()),
+              m_capacity(std::max<std::size_t>(buffer_size, 1)) {}
+
+        BufferedSerializeHandler(SinkT sink, char* buffer, std::size_t buffer_size) noexcept
+            : m_sink(std::move(sink)), m_buffer(buffer), m_capacity(buffer_size) {}
+
+        BufferedSerializeHandler(BufferedSerializeHandler const&) = delete;
+        BufferedSerializeHandler& operator=(BufferedSerializeHandler const&) = delete;
+
+        ~BufferedSerializeHandler()
+        {
+            try { write_through({}); }
+            catch (...) {} // 例如启用了异常的 ostream
+        }
+
+        void append(char ch)
+        {
+            if (m_size == m_capacity)
+                write_through({});
+            m_buffer[m_size++] = ch;
+        }
+
+        void append(std::string_view str)
+        {
+            append(str.data(), str.size());
+        }
+
+        void append(char const* cstr, std::size_t length)
+        {
+            if (length <= m_capacity - m_size)
+            {
+                std::memcpy(m_buffer + m_size, cstr, length);
+                m_size += length;
+            }
+            else if (length >= m_capacity)
+                write_through({ cstr, length }); // 大块数据不经缓冲区, 与缓冲内容一起写出
+            else
+            {
+                write_through({});
+                std::memcpy(m_buffer, cstr, length);
+                m_size = length;
+            }
+        }
+
+        // 将缓冲区中的全部输出交给 sink, 但不 flush sink; 出错时返回 false
+        bool drain()
+        {
+            if (m_size > 0)
+                write_through({});
+            return !m_bad;
+        }
+
+        // 同 drain(), 之后再 flush sink
+        bool flush()
+        {
+            write_through({});
+            if (!m_bad && !m_sink.flush())
+                m_bad = true;
+            return !m_bad;
+        }
+
+        bool bad() const noexcept { return m_bad; }
+        int error() const noexcept { return m_sink.error(); }
+        std::size_t buffered() const noexcept { return m_size; }
+    };
+
+    /*
+     * Produces the output as a list of segments instead of one contiguous buffer.
+     * Punctuation, numbers and escape sequences are copied into a staging buffer, while runs of
+     * string content that need no escaping and are at least reference_threshold bytes long are
+     * referenced in place (JsonSerializer passes them through append_reference()).
+     * Referenced segments point into the serialized basic_json, which must therefore stay alive
+     * and unmodified until the segments have been consumed.
+     */
+    class ScatterGatherSerializeHandler
+    {
+        struct Segment
+        {
+            char const* external; // nullptr 表示该段位于 m_staging 的 offset 处
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        std::string m_staging;
+        std::vector<Segment> m_segments;
+        std::size_t m_threshold;
+        std::size_t m_size = 0;
+#if JSONPP_HAS_POSIX_IO
+        int m_error = 0;
+#endif
+
+        void append_staged(char const* cstr, std::size_t length)
+        {
+            if (length == 0)
+                return;
+            if (!m_segments.empty() && m_segments.back().external == nullptr)
+                m_segments.back().length += length; // staging 只在末尾追加, 与上一段连续
+            else
+                m_segments.push_back({ nullptr, m_staging.size(), length });
+            m_staging.append(cstr, length);
+            m_size += length;
+        }
+
+    public:
+        static constexpr std::size_t DEFAULT_REFERENCE_THRESHOLD = 256;
+
+        explicit ScatterGatherSerializeHandler(std::size_t reference_threshold = DEFAULT_REFERENCE_THRESHOLD)
+            : m_threshold(std::max<std::size_t>(reference_threshold, 1)) {}
+
+        void append(char ch) { append_staged(&ch, 1); }
+        void append(std::string_view str) { append_staged(str.data(), str.size()); }
+        void append(char const* cstr, std::size_t length) { append_staged(cstr, length); }
+
+        // 生命周期长于输出使用期的数据可直接引用而不复制
+        void append_reference(char const* cstr, std::size_t length)
+        {
+            if (length < m_threshold)
+                return append_staged(cstr, length);
+            m_segments.push_back({ cstr, 0, length });
+            m_size += length;
+        }
+
+        std::vector<std::string_view> segments() const
+        {
+            std::vector<std::string_view> result;
+            result.reserve(m_segments.size());
+            for (auto const& seg : m_segments)
+                result.emplace_back(seg.external ? seg.external : m_staging.data() + seg.offset, seg.length);
+            return result;
+        }
+
+        std::size_t size() const noexcept { return m_size; }
+        std::size_t segment_count() const noexcept { return m_segments.size(); }
+
+        // 拼接所有段
+        std::string str() const
+        {
+            std::string result;
+            result.reserve(m_size);
+            for (auto seg : segments())
+                result.append(seg);
+            return result;
+        }
+
+        void clear() noexcept
+        {
+            m_staging.clear();
+            m_segments.clear();
+            m_size = 0;
+        }
+
+#if JSONPP_HAS_POSIX_IO
+        std::vector<iovec> iovecs() const
+        {
+            std::vector<iovec> result;
+            result.reserve(m_segments.size());
+            for (auto seg : segments())
+                result.push_back({ const_cast<char*>(seg.data()), seg.size() });
+            return result;
+        }
+
+        // 用 writev() 将所有段写入 fd (文件, 管道或 socket); 出错时返回 false
+        bool write_to(int fd)
+        {
+            auto iov = iovecs();
+            m_error = writev_all(fd, iov.data(), iov.size());
+            return m_error == 0;
+        }
+
+        int error() const noexcept { return m_error; }
+#endif
+    };
+
+    using BufferedOStreamSerializeHandler = BufferedSerializeHandler<OStreamSink>;
+    using BufferedCFileSerializeHandler = BufferedSerializeHandler<CFileSink>;
+#if JSONPP_HAS_POSIX_IO
+    using BufferedFdSerializeHandler = BufferedSerializeHandler<FdSink>;
+#endif
 }
 
 
@@ -20,15 +20,51 @@ limitations under the License.
 
 #include "json_fwd.hpp"
 #include "json_serialize_handler.hpp"
+#include "source_spans.hpp"
+#include "macro_def.hpp"
 #include "traits.hpp"
 
 #include <algorithm>
 #include <array>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <variant>
 
+#if JSONPP_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace jsonpp::details
 {
+    /*
+     * 转义表: 0 表示无需转义, 'u' 表示输出 \u00XX, 其余为反斜杠后紧跟的字符.
+     * '/' 仅在启用 escape_forward_slash 时才会被转义.
+     */
+    inline constexpr std::array<char, 256> ESCAPE_TABLE = []
+    {
+        std::array<char, 256> table{};
+        for (int i = 0; i < 0x20; ++i)
+            table[i] = 'u';
+        table['\b'] = 'b';
+        table['\f'] = 'f';
+        table['\n'] = 'n';
+        table['\r'] = 'r';
+        table['\t'] = 't';
+        table['\"'] = '\"';
+        table['\\'] = '\\';
+        table['/'] = '/';
+        return table;
+    }();
+
+    inline constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+#ifdef ESCAPE_FORWARD_SLASH
+    inline constexpr bool DEFAULT_ESCAPE_FORWARD_SLASH = true;
+#else
+    inline constexpr bool DEFAULT_ESCAPE_FORWARD_SLASH = false;
+#endif
+
     template <typename JsonT, typename SerializeHandlerT>
     class JsonSerializer
     {
@@ -41,16 +77,138 @@ namespace jsonpp::details
         using string = typename JsonT::string;
         using array = typename JsonT::array;
         using object = typename JsonT::object;
+        using raw = typename JsonT::raw;
 
         SerializeHandlerT& m_sh;
+        bool m_escape_slash;
+        std::string_view m_source; // m_spans 非空时, 源区间在其中的节点直接复制源文本 (dump_incremental)
+        SourceSpans const* m_spans = nullptr;
 
-        static bool needs_escaping(char ch)
+        template <bool EscapeSlash>
+        static bool needs_escaping(char ch) noexcept
         {
-            return ch == '\"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20
-#ifdef ESCAPE_FORWARD_SLASH
-            || ch == '/'
+            auto const uch = static_cast<unsigned char>(ch);
+            return ESCAPE_TABLE[uch] != 0 && (EscapeSlash || uch != '/');
+        }
+
+        // 返回 [str, str + length) 中第一个需要转义的字符的下标, 不存在时返回 length
+        template <bool EscapeSlash>
+        static std::size_t find_escape(char const* str, std::size_t length) noexcept
+        {
+            std::size_t i = 0;
+#if JSONPP_HAS_SSE2
+            __m128i const quote = _mm_set1_epi8('\"');
+            __m128i const backslash = _mm_set1_epi8('\\');
+            __m128i const slash = _mm_set1_epi8('/');
+            __m128i const ctrl_max = _mm_set1_epi8(0x1F);
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(str + i));
+                __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+                // unsigned chunk <= 0x1F  <=>  min(chunk, 0x1F) == chunk
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_min_epu8(chunk, ctrl_max), chunk));
+                if constexpr (EscapeSlash)
+                    hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, slash));
+                if (int const mask = _mm_movemask_epi8(hits))
+                    return i + JSONPP_CTZ_(static_cast<unsigned>(mask));
+            }
+#else
+            // SWAR: 每次检查 8 字节, 命中后再逐字节定位
+            constexpr std::uint64_t ones = 0x0101010101010101ULL;
+            constexpr std::uint64_t highs = 0x8080808080808080ULL;
+            auto has_zero = [](std::uint64_t v) { return (v - ones) & ~v & highs; };
+            for (; i + 8 <= length; i += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, str + i, sizeof(word));
+                std::uint64_t hits = has_zero(word ^ (ones * '\"'))
+                    | has_zero(word ^ (ones * '\\'))
+                    | ((word - ones * 0x20) & ~word & highs); // 小于 0x20 的字节
+                if constexpr (EscapeSlash)
+                    hits |= has_zero(word ^ (ones * '/'));
+                if (hits)
+                    break;
+            }
 #endif
-                ;
+            for (; i < length; ++i)
+            {
+                if (needs_escaping<EscapeSlash>(str[i]))
+                    return i;
+            }
+            return length;
+        }
+
+        // 返回字符串是否无需任何转义
+        template <bool EscapeSlash, bool MayReference>
+        bool escape_string_impl(std::string_view sv)
+        {
+            bool clean = true;
+            char const* chunkBegin = sv.data();
+            std::size_t remaining = sv.size();
+            while (remaining > 0)
+            {
+                auto chunkLength = find_escape<EscapeSlash>(chunkBegin, remaining);
+                if (chunkLength > 0)
+                    append_clean<MayReference>({ chunkBegin, chunkLength }); // 零拷贝 handler 原样引用 JSON 节点中的字符串内容
+                if (chunkLength == remaining)
+                    break; // 到达字符串结尾, 停止处理
+                clean = false;
+
+                // 下面处理转义
+                auto const uch = static_cast<unsigned char>(chunkBegin[chunkLength]);
+                char const escaped = ESCAPE_TABLE[uch];
+                if (escaped == 'u')
+                {
+                    char const buf[6] = { '\\', 'u', '0', '0', HEX_DIGITS[uch >> 4], HEX_DIGITS[uch & 0xF] };
+                    m_sh.append(buf, 6); // \uXXXX一定是6字符
+                }
+                else
+                {
+                    char const buf[2] = { '\\', escaped };
+                    m_sh.append(buf, 2);
+                }
+                chunkBegin += chunkLength + 1; // 跳过已写入的块和被转义的字符
+                remaining -= chunkLength + 1;
+            }
+            return clean;
+        }
+
+        template <bool MayReference>
+        void append_clean(std::string_view sv)
+        {
+            if constexpr (MayReference && traits::is_zero_copy_serialize_handler_v<SerializeHandlerT>)
+                m_sh.append_reference(sv.data(), sv.size());
+            else
+                m_sh.append(sv.data(), sv.size());
+        }
+
+        /*
+         * Writes a string value stored in a basic_json, using the node's "needs no escaping" hint.
+         * Hints are only used without forward-slash escaping, since they do not track '/'.
+         * Hints come from the parser only: a string reference obtained before a dump() may still
+         * be written through afterwards, so a hint cached here could go stale.
+         */
+        void write_hinted_string(string const& str, JsonT const& node)
+        {
+            if (!m_escape_slash && node.has_hint(JsonT::HINT_STRING_CLEAN))
+            {
+                m_sh.append('\"');
+                append_clean<true>(str); // 已知无需转义: 整段一次写出
+                m_sh.append('\"');
+            }
+            else
+                escape_string(str);
+        }
+
+    public:
+        explicit JsonSerializer(SerializeHandlerT& handler, bool escape_forward_slash = DEFAULT_ESCAPE_FORWARD_SLASH)
+            : m_sh(handler), m_escape_slash(escape_forward_slash) {}
+
+        // 设置解析时的源文本及其源区间表: 之后编号在表中的节点按原样复制其源区间
+        void use_source(std::string_view source, SourceSpans const& spans) noexcept
+        {
+            m_source = source;
+            m_spans = &spans;
         }
 
         // 用于写入换行和当前的缩进
@@ -62,104 +220,97 @@ namespace jsonpp::details
             }
         }
 
-    public:
-        explicit JsonSerializer(SerializeHandlerT& handler) : m_sh(handler) {}
-
+        /*
+         * stable_source: the string outlives the handler's use of the output, so a zero-copy handler
+         * may reference it instead of copying (true for strings stored in a basic_json).
+         */
         template <typename StringT>
-        void escape_string(StringT const& str) // escape v.转义 e.g. \ -> \\, " -> \"
+        bool escape_string(StringT const& str, bool stable_source = true) // escape v.转义 e.g. \ -> \\, " -> \"
         {
             std::string_view sv(std::data(str), std::size(str));
             m_sh.append('\"');
-            auto chunkBegin = sv.begin();
-            auto const end = sv.end();
-            while (chunkBegin < end)
-            {
-                auto badChar = std::find_if(chunkBegin, end, needs_escaping);
-                auto chunkLength = badChar - chunkBegin;
-                if (chunkLength > 0)
-                {
-                    m_sh.append(std::addressof(*chunkBegin), chunkLength); // 第一个参数应当为指针而不是迭代器, 尽管部分实现中迭代器底层直接使用指针
-                }
-                if (badChar == end)
-                    break; // 到达字符串结尾, 停止处理
-                chunkBegin = badChar + 1; // 跳过当前已经写入流的块, 等同于 chunkBegin += chunkLength + 1
+            bool clean;
+            if (m_escape_slash)
+                clean = stable_source ? escape_string_impl<true, true>(sv) : escape_string_impl<true, false>(sv);
+            else
+                clean = stable_source ? escape_string_impl<false, true>(sv) : escape_string_impl<false, false>(sv);
+            m_sh.append('\"');
+            return clean;
+        }
 
-                // 下面处理转义
-                char ch = *badChar;
-                switch (ch)
-                {
-                case '\"': m_sh.append("\\\"", 2);
-                    break;
-                case '\\': m_sh.append("\\\\", 2);
-                    break;
-#ifdef ESCAPE_FORWARD_SLASH
-                case '/': m_sh.append("\\/", 2); break;
-#endif
-                case '\b': m_sh.append("\\b", 2);
-                    break; // \x08
-                case '\f': m_sh.append("\\f", 2);
-                    break; // \x0C
-                case '\n': m_sh.append("\\n", 2);
-                    break; // \x0A
-                case '\r': m_sh.append("\\r", 2);
-                    break; // \x0D
-                case '\t': m_sh.append("\\t", 2);
-                    break; // \x09
-                default:
-                    {
-                        char buf[7]{};
-                        std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned short>(ch));
-                        m_sh.append(buf, 6); // \uXXXX一定是6字符
-                        break;
-                    }
-                }
+        // 键不缓存标记 (节点句柄可以改写键), 每次都扫描
+        void write_key(string const& key) { escape_string(key); }
+
+        void write_null() { m_sh.append("null", 4); }
+
+        void write_bool(bool value)
+        {
+            if (value) m_sh.append("true", 4);
+            else m_sh.append("false", 5);
+        }
+
+        template <typename IntegerT>
+        void write_integer(IntegerT value)
+        {
+            constexpr size_t MAX_INT_CHARS = 32;
+            char cbuf[MAX_INT_CHARS];
+            auto result = std::to_chars(cbuf, cbuf + sizeof(cbuf), value);
+            m_sh.append(cbuf, result.ptr - cbuf);
+        }
+
+        template <typename FloatT>
+        void write_float(FloatT value)
+        {
+            constexpr size_t MAX_DOUBLE_CHARS = 64;
+            char cbuf[MAX_DOUBLE_CHARS];
+            auto result = std::to_chars(cbuf, cbuf + sizeof(cbuf), value, std::chars_format::general);
+            m_sh.append(cbuf, result.ptr - cbuf);
+
+            std::string_view written(cbuf, result.ptr - cbuf);
+            if (written.find('.') == std::string_view::npos &&
+                written.find('e') == std::string_view::npos &&
+                written.find('E') == std::string_view::npos)
+            {
+                m_sh.append(".0", 2); // ensure that float numbers have a decimal part
             }
-            m_sh.append('\"');
         }
 
         template <bool Pretty = false>
         void dump(JsonT const& json, std::string_view indent = "\t", int depth = 0)
         {
-            std::visit([this, &indent, depth](auto&& v)
+            if (m_spans)
+            {
+                auto const* span = m_spans->find(json.span_id());
+                if (span && span->offset <= m_source.size() && span->length <= m_source.size() - span->offset)
+                    return append_clean<true>(m_source.substr(span->offset, span->length));
+            }
+
+            std::visit([this, &json, &indent, depth](auto&& stored)
                 {
+                    auto const& v = unshared(stored); // 共享存储按其中的容器写出
                     using T = std::decay_t<decltype(v)>;
 
                     if constexpr (std::is_same_v<T, std::monostate>)
                         return; // empty basic_json
                     if constexpr (std::is_same_v<T, null_t>)
                     {
-                        m_sh.append("null", 4);
+                        write_null();
                     }
                     if constexpr (std::is_same_v<T, boolean>)
                     {
-                        if (v) m_sh.append("true", 4);
-                        else m_sh.append("false", 5);
+                        write_bool(v);
                     }
                     if constexpr (std::is_same_v<T, number_int>)
                     {
-                        constexpr size_t MAX_INT_CHARS = 32;
-                        char cbuf[MAX_INT_CHARS];
-                        auto result = std::to_chars(cbuf, cbuf + sizeof(cbuf), v);
-                        m_sh.append(cbuf, result.ptr - cbuf);
+                        write_integer(v);
                     }
                     if constexpr (std::is_same_v<T, number_float>)
                     {
-                        constexpr size_t MAX_DOUBLE_CHARS = 64;
-                        char cbuf[MAX_DOUBLE_CHARS];
-                        auto result = std::to_chars(cbuf, cbuf + sizeof(cbuf), v, std::chars_format::general);
-                        m_sh.append(cbuf, result.ptr - cbuf);
-
-                        std::string_view written(cbuf, result.ptr - cbuf);
-                        if (written.find('.') == std::string_view::npos &&
-                            written.find('e') == std::string_view::npos &&
-                            written.find('E') == std::string_view::npos)
-                        {
-                            m_sh.append(".0", 2); // ensure that float numbers have a decimal part
-                        }
+                        write_float(v);
                     }
                     if constexpr (std::is_same_v<T, string>)
                     {
-                        escape_string(v);
+                        write_hinted_string(v, json);
                     }
                     if constexpr (std::is_same_v<T, array>)
                     {
@@ -175,7 +326,7 @@ namespace jsonpp::details
 
                                 if constexpr (Pretty)
                                     append_indent(indent, depth + 1);
-                                dump<Pretty>(item);
+                                dump<Pretty>(item, indent, depth + 1);
                             }
                             if constexpr (Pretty)
                                 append_indent(indent, depth);
@@ -196,18 +347,22 @@ namespace jsonpp::details
 
                                 if constexpr (Pretty)
                                     append_indent(indent, depth + 1);
-                                escape_string(item.first);
+                                write_key(item.first);
                                 if constexpr (Pretty)
                                     m_sh.append(": ", 2);
                                 else
                                     m_sh.append(':');
-                                dump<Pretty>(item.second);
+                                dump<Pretty>(item.second, indent, depth + 1);
                             }
                             if constexpr (Pretty)
                                 append_indent(indent, depth);
                         }
                         m_sh.append('}');
                     }
+                    if constexpr (std::is_same_v<T, raw>)
+                    {
+                        append_clean<true>(v.text); // 已验证的源文本, 原样写出 (Pretty 也不重新排版)
+                    }
                 }, json.m_value
             );
         }
@@ -0,0 +1,582 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_SNAPSHOT_HPP
+#define JSONPP_JSON_SNAPSHOT_HPP
+
+#include "macro_def.hpp"
+#include "basic_json.hpp"
+#include "jsonexception.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if JSONPP_HAS_POSIX_IO
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace jsonpp
+{
+    namespace details
+    {
+        /*
+         * Snapshot layout (native byte order; every record starts at an 8-byte aligned offset):
+         *   header  "JSONPPSN", u32 version, u32 byte-order mark, u64 total size, root slot
+         *   slot    u8 Type, 7 bytes padding, u64 payload. Booleans and numbers are stored inline,
+         *           strings, arrays and objects as the offset of their record
+         *   string  u64 length, bytes, '\0'
+         *   array   u64 count, count slots
+         *   object  u64 count, count entries { u64 offset of the key string, slot }, sorted by key
+         * Equal strings (keys and values alike) are stored once.
+         */
+        struct SnapshotFormat
+        {
+            static constexpr char MAGIC[8] = {'J', 'S', 'O', 'N', 'P', 'P', 'S', 'N'};
+            static constexpr std::uint32_t VERSION = 1;
+            static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+            static constexpr std::size_t VERSION_OFFSET = 8;
+            static constexpr std::size_t BYTE_ORDER_OFFSET = 12;
+            static constexpr std::size_t SIZE_OFFSET = 16;
+            static constexpr std::size_t ROOT_OFFSET = 24;
+            static constexpr std::size_t HEADER_SIZE = 40;
+            static constexpr std::size_t SLOT_SIZE = 16;
+            static constexpr std::size_t ENTRY_SIZE = 8 + SLOT_SIZE;
+        };
+
+        template <typename JsonT>
+        class SnapshotWriter
+        {
+            using F = SnapshotFormat;
+            using array = typename JsonT::array;
+            using object = typename JsonT::object;
+
+            std::string& m_out;
+            std::size_t m_base = 0; // 快照在 m_out 中的起点, 所有偏移量都相对于它
+            std::unordered_map<std::string_view, std::uint64_t> m_strings; // 字符串池
+            std::deque<JsonT> m_materialized; // 解析后的 raw 节点, 字符串池引用其中的字符串
+
+            template <typename T>
+            void store(std::size_t offset, T value) { std::memcpy(&m_out[m_base + offset], &value, sizeof(T)); }
+
+            std::size_t allocate(std::size_t bytes)
+            {
+                m_out.append((8 - (m_out.size() - m_base) % 8) % 8, '\0');
+                auto const offset = m_out.size() - m_base;
+                m_out.append(bytes, '\0');
+                return offset;
+            }
+
+            std::uint64_t write_string(std::string_view str)
+            {
+                auto const it = m_strings.find(str);
+                if (it != m_strings.end())
+                    return it->second;
+                auto const offset = allocate(8 + str.size() + 1);
+                store<std::uint64_t>(offset, str.size());
+                std::memcpy(&m_out[m_base + offset + 8], str.data(), str.size());
+                m_strings.emplace(str, offset);
+                return offset;
+            }
+
+            std::uint64_t write_array(array const& arr)
+            {
+                auto const offset = allocate(8 + arr.size() * F::SLOT_SIZE);
+                store<std::uint64_t>(offset, arr.size());
+                for (std::size_t i = 0; i < arr.size(); ++i)
+                    write_slot(offset + 8 + i * F::SLOT_SIZE, arr[i]);
+                return offset;
+            }
+
+            std::uint64_t write_object(object const& obj)
+            {
+                std::vector<std::pair<std::string_view, JsonT const*>> members;
+                members.reserve(obj.size());
+                for (auto const& [key, value] : obj)
+                    members.emplace_back(key, &value);
+                std::sort(members.begin(), members.end(),
+                          [](auto const& a, auto const& b) { return a.first < b.first; });
+
+                auto const offset = allocate(8 + members.size() * F::ENTRY_SIZE);
+                store<std::uint64_t>(offset, members.size());
+                for (std::size_t i = 0; i < members.size(); ++i)
+                {
+                    auto const entry = offset + 8 + i * F::ENTRY_SIZE;
+                    store<std::uint64_t>(entry, write_string(members[i].first));
+                    write_slot(entry + 8, *members[i].second);
+                }
+                return offset;
+            }
+
+            void write_slot(std::size_t offset, JsonT const& json)
+            {
+                Type type = json.type();
+                std::uint64_t payload = 0;
+                switch (type)
+                {
+                case Type::empty:
+                    type = Type::null;
+                    break;
+                case Type::null:
+                    break;
+                case Type::boolean:
+                    payload = json.as_bool() ? 1 : 0;
+                    break;
+                case Type::number_int:
+                    payload = static_cast<std::uint64_t>(static_cast<std::int64_t>(json.as_int()));
+                    break;
+                case Type::number_float:
+                    {
+                        auto const value = static_cast<double>(json.as_float());
+                        std::memcpy(&payload, &value, sizeof(payload));
+                        break;
+                    }
+                case Type::string:
+                    payload = write_string(json.as_string());
+                    break;
+                case Type::array:
+                    payload = write_array(json.as_array());
+                    break;
+                case Type::object:
+                    payload = write_object(json.as_object());
+                    break;
+                case Type::raw:
+                    m_materialized.push_back(json.materialized());
+                    return write_slot(offset, m_materialized.back());
+                }
+                store<std::uint8_t>(offset, static_cast<std::uint8_t>(type));
+                store<std::uint64_t>(offset + 8, payload);
+            }
+
+        public:
+            explicit SnapshotWriter(std::string& out): m_out(out) {}
+
+            void write(JsonT const& root)
+            {
+                m_base = m_out.size();
+                allocate(F::HEADER_SIZE);
+                std::memcpy(&m_out[m_base], F::MAGIC, sizeof(F::MAGIC));
+                store<std::uint32_t>(F::VERSION_OFFSET, F::VERSION);
+                store<std::uint32_t>(F::BYTE_ORDER_OFFSET, F::BYTE_ORDER_MARK);
+                write_slot(F::ROOT_OFFSET, root);
+                store<std::uint64_t>(F::SIZE_OFFSET, m_out.size() - m_base);
+            }
+        }; // class SnapshotWriter
+    }
+
+    /*
+     * A value inside a snapshot: a small handle that reads directly from the snapshot bytes.
+     * Valid as long as the snapshot_view (or buffer) it came from. Offsets are bounds-checked on
+     * every access, so a corrupt snapshot throws JsonSnapshotError instead of reading out of bounds.
+     */
+    class snapshot_value
+    {
+        using F = details::SnapshotFormat;
+
+        char const* m_data = nullptr;
+        std::size_t m_size = 0;
+        Type m_type = Type::null;
+        std::uint64_t m_payload = 0;
+
+        template <typename T>
+        static T load(char const* data, std::size_t size, std::uint64_t offset)
+        {
+            if (offset > size || size - offset < sizeof(T))
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            return value;
+        }
+
+        static std::string_view load_string(char const* data, std::size_t size, std::uint64_t offset)
+        {
+            auto const length = load<std::uint64_t>(data, size, offset);
+            if (length > size - offset - 8)
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            return {data + offset + 8, static_cast<std::size_t>(length)};
+        }
+
+        std::size_t record_count(std::size_t element_size) const
+        {
+            auto const count = load<std::uint64_t>(m_data, m_size, m_payload);
+            if (count > (m_size - m_payload - 8) / element_size)
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            return static_cast<std::size_t>(count);
+        }
+
+        void expect(Type type, char const* name) const
+        {
+            if (m_type != type)
+                throw JsonTypeError(std::string("Snapshot value is not ") + name);
+        }
+
+        std::size_t entry_offset(std::size_t index) const { return m_payload + 8 + index * F::ENTRY_SIZE; }
+        std::string_view key_at(std::size_t index) const
+        {
+            return load_string(m_data, m_size, load<std::uint64_t>(m_data, m_size, entry_offset(index)));
+        }
+
+        // 二分查找键, 未找到时返回 size
+        std::size_t find_index(std::string_view key, std::size_t size) const
+        {
+            std::size_t low = 0, high = size;
+            while (low < high)
+            {
+                auto const mid = low + (high - low) / 2;
+                if (key_at(mid) < key)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            return low < size && key_at(low) == key ? low : size;
+        }
+
+        friend class snapshot_view;
+
+    public:
+        snapshot_value() = default; // null
+
+        static snapshot_value from_slot(char const* data, std::size_t size, std::uint64_t offset)
+        {
+            snapshot_value value;
+            value.m_data = data;
+            value.m_size = size;
+            auto const type = load<std::uint8_t>(data, size, offset);
+            if (type > static_cast<std::uint8_t>(Type::object))
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            value.m_type = static_cast<Type>(type);
+            value.m_payload = load<std::uint64_t>(data, size, offset + 8);
+            // 写入器总是把子容器的记录放在引用它的槽之后; 偏移量严格递增保证了不会有环
+            if ((value.m_type == Type::array || value.m_type == Type::object) && value.m_payload <= offset)
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            return value;
+        }
+
+        class iterator
+        {
+            // 按值保存父容器, 迭代器不依赖产生它的临时对象
+            char const* m_data = nullptr;
+            std::size_t m_size = 0;
+            Type m_type = Type::null;
+            std::uint64_t m_payload = 0;
+            std::size_t m_index = 0;
+
+            snapshot_value parent() const
+            {
+                snapshot_value value;
+                value.m_data = m_data;
+                value.m_size = m_size;
+                value.m_type = m_type;
+                value.m_payload = m_payload;
+                return value;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = snapshot_value;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = snapshot_value;
+
+            iterator() = default;
+            iterator(snapshot_value const& parent, std::size_t index)
+                : m_data(parent.m_data), m_size(parent.m_size), m_type(parent.m_type), m_payload(parent.m_payload), m_index(index) {}
+
+            snapshot_value operator*() const { return value(); }
+            snapshot_value value() const
+            {
+                auto const slot = m_type == Type::array
+                    ? m_payload + 8 + m_index * F::SLOT_SIZE
+                    : parent().entry_offset(m_index) + 8;
+                return from_slot(m_data, m_size, slot);
+            }
+            // Key of the current member (objects only)
+            std::string_view key() const
+            {
+                auto const p = parent();
+                p.expect(Type::object, "an object");
+                return p.key_at(m_index);
+            }
+
+            iterator& operator++() { ++m_index; return *this; }
+            iterator operator++(int) { auto old = *this; ++m_index; return old; }
+            bool operator==(iterator const& other) const
+            {
+                return m_index == other.m_index && m_data == other.m_data && m_payload == other.m_payload;
+            }
+            bool operator!=(iterator const& other) const { return !(*this == other); }
+        };
+
+        Type type() const noexcept { return m_type; }
+        bool is_null() const noexcept { return m_type == Type::null; }
+        bool is_bool() const noexcept { return m_type == Type::boolean; }
+        bool is_number() const noexcept { return m_type == Type::number_int || m_type == Type::number_float; }
+        bool is_int() const noexcept { return m_type == Type::number_int; }
+        bool is_float() const noexcept { return m_type == Type::number_float; }
+        bool is_string() const noexcept { return m_type == Type::string; }
+        bool is_array() const noexcept { return m_type == Type::array; }
+        bool is_object() const noexcept { return m_type == Type::object; }
+
+        bool as_bool() const { expect(Type::boolean, "a bool"); return m_payload != 0; }
+        std::int64_t as_int() const { expect(Type::number_int, "an int64"); return static_cast<std::int64_t>(m_payload); }
+        double as_float() const
+        {
+            expect(Type::number_float, "a double");
+            double value;
+            std::memcpy(&value, &m_payload, sizeof(value));
+            return value;
+        }
+        std::string_view as_string() const { expect(Type::string, "a string"); return load_string(m_data, m_size, m_payload); }
+
+        // Same convention as basic_json::size(): element count for containers, 0 for null, 1 otherwise
+        std::size_t size() const
+        {
+            switch (m_type)
+            {
+            case Type::array: return record_count(F::SLOT_SIZE);
+            case Type::object: return record_count(F::ENTRY_SIZE);
+            case Type::empty:
+            case Type::null: return 0;
+            default: return 1;
+            }
+        }
+
+        snapshot_value at(std::size_t index) const
+        {
+            expect(Type::array, "an array");
+            if (index >= record_count(F::SLOT_SIZE))
+                throw JsonOutOfRange(JsonOutOfRange::ARRAY_OUT_OF_RANGE_MESSAGE);
+            return from_slot(m_data, m_size, m_payload + 8 + index * F::SLOT_SIZE);
+        }
+        snapshot_value operator[](std::size_t index) const { return at(index); }
+
+        snapshot_value at(std::string_view key) const
+        {
+            expect(Type::object, "an object");
+            auto const size = record_count(F::ENTRY_SIZE);
+            auto const index = find_index(key, size);
+            if (index == size)
+                throw JsonOutOfRange(JsonOutOfRange::KEY_NOT_FOUND_MESSAGE);
+            return from_slot(m_data, m_size, entry_offset(index) + 8);
+        }
+        snapshot_value operator[](std::string_view key) const { return at(key); }
+
+        bool contains(std::string_view key) const
+        {
+            if (m_type != Type::object)
+                return false;
+            auto const size = record_count(F::ENTRY_SIZE);
+            return find_index(key, size) != size;
+        }
+
+        // Iterates over array elements or object members (in key order); empty for other types
+        iterator begin() const { return {*this, 0}; }
+        iterator end() const { return {*this, is_array() || is_object() ? size() : 0}; }
+
+        // Copies this value into a basic_json; containers nested deeper than MAX_NESTING_DEPTH throw JsonSnapshotError
+        template <typename JsonT = json>
+        JsonT to_json() const { return to_json_impl<JsonT>(0); }
+
+    private:
+        template <typename JsonT>
+        JsonT to_json_impl(int depth) const
+        {
+            if ((m_type == Type::array || m_type == Type::object) && depth >= MAX_NESTING_DEPTH)
+                throw JsonSnapshotError(JsonSnapshotError::CORRUPT_MESSAGE);
+            switch (m_type)
+            {
+            case Type::boolean: return JsonT(as_bool());
+            case Type::number_int: return JsonT(static_cast<typename JsonT::number_int>(as_int()));
+            case Type::number_float: return JsonT(static_cast<typename JsonT::number_float>(as_float()));
+            case Type::string: return JsonT(typename JsonT::string(as_string()));
+            case Type::array:
+                {
+                    typename JsonT::array arr;
+                    arr.reserve(size());
+                    for (auto const& item : *this)
+                        arr.push_back(item.template to_json_impl<JsonT>(depth + 1));
+                    return JsonT(std::move(arr));
+                }
+            case Type::object:
+                {
+                    typename JsonT::object obj;
+                    for (auto it = begin(); it != end(); ++it)
+                        obj.emplace(typename JsonT::string(it.key()), it.value().template to_json_impl<JsonT>(depth + 1));
+                    return JsonT(std::move(obj));
+                }
+            default:
+                return JsonT(null);
+            }
+        }
+    }; // class snapshot_value
+
+    /*
+     * A snapshot (see basic_json::to_snapshot()) opened for reading. open() maps the file read-only and shared,
+     * so processes opening the same file share its pages; nothing is parsed or copied up front.
+     * Without POSIX I/O, open() reads the file into memory instead.
+     */
+    class snapshot_view
+    {
+        using F = details::SnapshotFormat;
+
+        char const* m_data = nullptr;
+        std::size_t m_size = 0;
+        void* m_mapping = nullptr;
+        std::size_t m_mapping_size = 0;
+        std::string m_storage; // 无 mmap 时的文件内容
+        snapshot_value m_root;
+
+        void bind(char const* data, std::size_t size)
+        {
+            if (size < F::HEADER_SIZE || std::memcmp(data, F::MAGIC, sizeof(F::MAGIC)) != 0)
+                throw JsonSnapshotError("JSON snapshot: not a snapshot");
+            std::uint32_t version, byte_order;
+            std::uint64_t total;
+            std::memcpy(&version, data + F::VERSION_OFFSET, sizeof(version));
+            std::memcpy(&byte_order, data + F::BYTE_ORDER_OFFSET, sizeof(byte_order));
+            std::memcpy(&total, data + F::SIZE_OFFSET, sizeof(total));
+            if (version != F::VERSION)
+                throw JsonSnapshotError("JSON snapshot: unsupported version " + std::to_string(version));
+            if (byte_order != F::BYTE_ORDER_MARK)
+                throw JsonSnapshotError("JSON snapshot: written on a machine with a different byte order");
+            if (total > size)
+                throw JsonSnapshotError("JSON snapshot: truncated");
+
+            m_data = data;
+            m_size = static_cast<std::size_t>(total);
+            m_root = snapshot_value::from_slot(m_data, m_size, F::ROOT_OFFSET);
+        }
+
+        void release() noexcept
+        {
+#if JSONPP_HAS_POSIX_IO
+            if (m_mapping)
+                ::munmap(m_mapping, m_mapping_size);
+#endif
+            m_mapping = nullptr;
+            m_mapping_size = 0;
+            m_data = nullptr;
+            m_size = 0;
+            m_storage.clear();
+            m_root = snapshot_value();
+        }
+
+        void take(snapshot_view& other) noexcept
+        {
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_mapping_size = std::exchange(other.m_mapping_size, 0);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_root = std::exchange(other.m_root, snapshot_value());
+            bool const owns_storage = !other.m_storage.empty();
+            m_storage = std::move(other.m_storage);
+            other.m_storage.clear();
+            if (owns_storage) // std::string 的移动不保证数据地址不变
+                bind(m_storage.data(), m_storage.size());
+        }
+
+    public:
+        snapshot_view() = default;
+
+        // Reads a snapshot held in caller-owned memory, which must outlive the view and its values
+        explicit snapshot_view(std::string_view bytes) { bind(bytes.data(), bytes.size()); }
+
+        static snapshot_view open(std::string const& path)
+        {
+            snapshot_view view;
+#if JSONPP_HAS_POSIX_IO
+            int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                throw JsonSnapshotError("JSON snapshot: cannot open " + path + ": " + std::strerror(errno));
+            struct stat st{};
+            if (::fstat(fd, &st) != 0)
+            {
+                int const error = errno;
+                ::close(fd);
+                throw JsonSnapshotError("JSON snapshot: cannot stat " + path + ": " + std::strerror(error));
+            }
+            if (st.st_size == 0) // mmap 不接受长度 0
+            {
+                ::close(fd);
+                throw JsonSnapshotError("JSON snapshot: " + path + " is empty");
+            }
+            auto const size = static_cast<std::size_t>(st.st_size);
+            void* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            int const error = errno;
+            ::close(fd); // 映射在关闭描述符后仍然有效
+            if (mapping == MAP_FAILED)
+                throw JsonSnapshotError("JSON snapshot: cannot map " + path + ": " + std::strerror(error));
+            view.m_mapping = mapping;
+            view.m_mapping_size = size;
+            view.bind(static_cast<char const*>(mapping), size);
+#else
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                throw JsonSnapshotError("JSON snapshot: cannot open " + path);
+            view.m_storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            view.bind(view.m_storage.data(), view.m_storage.size());
+#endif
+            return view;
+        }
+
+        snapshot_view(snapshot_view const&) = delete;
+        snapshot_view& operator=(snapshot_view const&) = delete;
+        snapshot_view(snapshot_view&& other) noexcept { take(other); }
+        snapshot_view& operator=(snapshot_view&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                take(other);
+            }
+            return *this;
+        }
+        ~snapshot_view() { release(); }
+
+        snapshot_value const& root() const noexcept { return m_root; }
+        std::string_view bytes() const noexcept { return {m_data, m_size}; }
+
+        Type type() const noexcept { return m_root.type(); }
+        std::size_t size() const { return m_root.size(); }
+        snapshot_value at(std::size_t index) const { return m_root.at(index); }
+        snapshot_value operator[](std::size_t index) const { return m_root.at(index); }
+        snapshot_value at(std::string_view key) const { return m_root.at(key); }
+        snapshot_value operator[](std::string_view key) const { return m_root.at(key); }
+        bool contains(std::string_view key) const { return m_root.contains(key); }
+        snapshot_value::iterator begin() const { return m_root.begin(); }
+        snapshot_value::iterator end() const { return m_root.end(); }
+
+        template <typename JsonT = json>
+        JsonT to_json() const { return m_root.template to_json<JsonT>(); }
+    }; // class snapshot_view
+}
+
+#endif //JSONPP_JSON_SNAPSHOT_HPP
@@ -0,0 +1,254 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_SNAPSHOT_HOLDER_HPP
+#define JSONPP_JSON_SNAPSHOT_HOLDER_HPP
+
+#include "json_fwd.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace jsonpp
+{
+    /*
+     * Holds the current version of a document for many concurrent readers and occasional writers (RCU).
+     *
+     * read() pins the current version without locks: it touches only a per-thread counter slot, never a cache
+     * line shared by all readers. publish() swaps in a new version atomically; the old one is retired and freed
+     * by epoch-based reclamation as soon as the last reader that could still see it has left (the leaving
+     * reader or the next writer frees it). Writers are serialized by a mutex.
+     *
+     * update() copies the current document, lets the callback modify the copy and publishes it. Call share() on
+     * the published document to make those copies O(1) plus the changed path.
+     */
+    template <typename JsonT = json>
+    class json_snapshot_holder
+    {
+        struct Version
+        {
+            std::shared_ptr<JsonT const> value;
+            std::uint64_t number;
+        };
+
+        struct Retired
+        {
+            Version* version;
+            std::uint64_t epoch;
+        };
+
+        // 每个槽位按 epoch % 3 记录正在读取的线程数; 独占缓存行, 读者之间不共享写入
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<std::uint32_t> active[3] = {};
+        };
+
+        static constexpr std::size_t SLOT_COUNT = 128;
+
+        std::atomic<Version*> m_current;
+        std::atomic<std::uint64_t> m_epoch{0};
+        std::atomic<std::size_t> m_retired_count{0};
+        mutable std::array<ReaderSlot, SLOT_COUNT> m_slots;
+        std::mutex m_writer_mutex;
+        std::vector<Retired> m_retired;
+        std::uint64_t m_next_number = 1;
+
+        static ReaderSlot& slot_of(std::array<ReaderSlot, SLOT_COUNT>& slots) noexcept
+        {
+            static std::atomic<std::size_t> next_index{0};
+            thread_local std::size_t const index = next_index.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT;
+            return slots[index];
+        }
+
+        // Epoch e+1 may begin once no reader is left in epoch e-1
+        bool try_advance_epoch() noexcept
+        {
+            auto const epoch = m_epoch.load(std::memory_order_relaxed);
+            auto const previous = (epoch + 2) % 3;
+            for (auto const& slot : m_slots)
+                if (slot.active[previous].load(std::memory_order_seq_cst) != 0)
+                    return false;
+            m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        // A version retired in epoch r is unreachable for every reader once epoch r+2 has begun
+        void reclaim_locked()
+        {
+            if (m_retired.empty())
+                return;
+            if (try_advance_epoch())
+                try_advance_epoch();
+            auto const epoch = m_epoch.load(std::memory_order_relaxed);
+            std::size_t kept = 0;
+            for (auto const& retired : m_retired)
+            {
+                if (retired.epoch + 2 <= epoch)
+                    delete retired.version;
+                else
+                    m_retired[kept++] = retired;
+            }
+            m_retired.resize(kept);
+            m_retired_count.store(kept, std::memory_order_relaxed);
+        }
+
+        void try_reclaim()
+        {
+            std::unique_lock<std::mutex> lock(m_writer_mutex, std::try_to_lock);
+            if (lock)
+                reclaim_locked();
+        }
+
+        void publish_locked(std::shared_ptr<JsonT const> value)
+        {
+            auto* next = new Version{ std::move(value), m_next_number++ };
+            auto* old = m_current.exchange(next, std::memory_order_acq_rel);
+            m_retired.push_back({ old, m_epoch.load(std::memory_order_relaxed) });
+            m_retired_count.store(m_retired.size(), std::memory_order_relaxed);
+            reclaim_locked();
+        }
+
+    public:
+        /*
+         * A pinned version. Keep guards short-lived: a version, and every version published after it,
+         * cannot be freed while a guard that may see it exists. Not transferable between threads.
+         */
+        class read_guard
+        {
+            friend class json_snapshot_holder;
+
+            json_snapshot_holder* m_holder = nullptr;
+            std::atomic<std::uint32_t>* m_counter = nullptr;
+            Version const* m_version = nullptr;
+
+            explicit read_guard(json_snapshot_holder& holder): m_holder(&holder)
+            {
+                auto& slot = slot_of(holder.m_slots);
+                for (;;)
+                {
+                    // 登记后再次确认 epoch 未变, 否则写者可能已经越过了登记的 epoch
+                    auto const epoch = holder.m_epoch.load(std::memory_order_seq_cst);
+                    m_counter = &slot.active[epoch % 3];
+                    m_counter->fetch_add(1, std::memory_order_seq_cst);
+                    if (holder.m_epoch.load(std::memory_order_seq_cst) == epoch)
+                        break;
+                    m_counter->fetch_sub(1, std::memory_order_release);
+                }
+                m_version = holder.m_current.load(std::memory_order_acquire);
+            }
+
+            void release() noexcept
+            {
+                if (!m_holder)
+                    return;
+                m_counter->fetch_sub(1, std::memory_order_release);
+                if (m_holder->m_retired_count.load(std::memory_order_relaxed) != 0)
+                {
+                    try { m_holder->try_reclaim(); }
+                    catch (...) {} // 回收失败时留给下一个写者
+                }
+                m_holder = nullptr;
+            }
+
+        public:
+            read_guard(read_guard&& other) noexcept
+                : m_holder(std::exchange(other.m_holder, nullptr)), m_counter(other.m_counter), m_version(other.m_version) {}
+            read_guard& operator=(read_guard&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+                    m_holder = std::exchange(other.m_holder, nullptr);
+                    m_counter = other.m_counter;
+                    m_version = other.m_version;
+                }
+                return *this;
+            }
+            read_guard(read_guard const&) = delete;
+            read_guard& operator=(read_guard const&) = delete;
+            ~read_guard() { release(); }
+
+            JsonT const& get() const noexcept { return *m_version->value; }
+            JsonT const& operator*() const noexcept { return get(); }
+            JsonT const* operator->() const noexcept { return &get(); }
+            // Increases by one with every publish()
+            std::uint64_t version() const noexcept { return m_version->number; }
+        };
+
+        explicit json_snapshot_holder(JsonT initial = JsonT())
+            : m_current(new Version{ std::make_shared<JsonT const>(std::move(initial)), 0 }) {}
+
+        json_snapshot_holder(json_snapshot_holder const&) = delete;
+        json_snapshot_holder& operator=(json_snapshot_holder const&) = delete;
+
+        // No read_guard may outlive the holder
+        ~json_snapshot_holder()
+        {
+            for (auto const& retired : m_retired)
+                delete retired.version;
+            delete m_current.load(std::memory_order_relaxed);
+        }
+
+        read_guard read() const { return read_guard(const_cast<json_snapshot_holder&>(*this)); }
+
+        // The current version as a reference-counted pointer, for holding it beyond a short read
+        std::shared_ptr<JsonT const> load() const { return read().m_version->value; }
+
+        void publish(JsonT value)
+        {
+            auto shared = std::make_shared<JsonT const>(std::move(value));
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            publish_locked(std::move(shared));
+        }
+
+        // Copies the current document, applies fn(JsonT&) and publishes the result. Concurrent updates are serialized.
+        template <typename FunctionT>
+        void update(FunctionT&& fn)
+        {
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            JsonT next = *m_current.load(std::memory_order_acquire)->value;
+            std::forward<FunctionT>(fn)(next);
+            publish_locked(std::make_shared<JsonT const>(std::move(next)));
+        }
+
+        std::uint64_t version() const noexcept { return m_current.load(std::memory_order_acquire)->number; }
+
+        // Blocks until every retired version has been freed, i.e. until all older readers have left
+        void synchronize()
+        {
+            for (;;)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_writer_mutex);
+                    reclaim_locked();
+                    if (m_retired.empty())
+                        return;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }; // class json_snapshot_holder
+}
+
+#endif //JSONPP_JSON_SNAPSHOT_HOLDER_HPP
@@ -0,0 +1,202 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_JSON_WRITER_HPP
+#define JSONPP_JSON_WRITER_HPP
+
+#include "basic_json.hpp"
+#include "json_serializer.hpp"
+#include "jsonexception.hpp"
+#include "traits.hpp"
+
+#include <string_view>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jsonpp
+{
+    /*
+     * Streaming JSON writer: emits a document directly to a serialize handler without building a basic_json.
+     * Escaping, number formatting and pretty layout are those of details::JsonSerializer, so the output is
+     * identical to dumping the equivalent basic_json (object members appear in the order they are written).
+     *
+     *   json_writer w(handler);
+     *   w.begin_object().key("id").value(42).key("tags").begin_array().value("a").end_array().end_object();
+     */
+    template <typename SerializeHandlerT, typename JsonT = json>
+    class json_writer
+    {
+        static_assert(traits::is_json_serialize_handler_v<SerializeHandlerT>,
+            "SerializeHandlerT should be a JSON Serialize Handler.");
+
+        struct Frame
+        {
+            bool is_object;
+            bool empty;
+        };
+
+        SerializeHandlerT& m_sh;
+        details::JsonSerializer<JsonT, SerializeHandlerT> m_serializer;
+        std::vector<Frame> m_stack;
+        std::string_view m_indent;
+        bool m_pretty;
+        bool m_escape_slash;
+        bool m_after_key = false;
+        bool m_root_written = false;
+
+        int depth() const noexcept { return static_cast<int>(m_stack.size()); }
+
+        // Writes separator and indentation for the next element of the current container
+        void begin_element()
+        {
+            Frame& top = m_stack.back();
+            if (!top.empty)
+                m_sh.append(',');
+            top.empty = false;
+            if (m_pretty)
+                m_serializer.append_indent(m_indent, depth());
+        }
+
+        void before_value()
+        {
+            if (m_stack.empty())
+            {
+                if (m_root_written)
+                    throw JsonWriterError(JsonWriterError::MULTIPLE_ROOTS_MESSAGE);
+                m_root_written = true;
+            }
+            else if (m_stack.back().is_object)
+            {
+                if (!m_after_key)
+                    throw JsonWriterError(JsonWriterError::KEY_EXPECTED_MESSAGE);
+                m_after_key = false;
+            }
+            else
+                begin_element();
+        }
+
+        json_writer& begin_container(bool is_object)
+        {
+            before_value();
+            m_sh.append(is_object ? '{' : '[');
+            m_stack.push_back({ is_object, true });
+            return *this;
+        }
+
+        json_writer& end_container(bool is_object)
+        {
+            if (m_stack.empty() || m_stack.back().is_object != is_object)
+                throw JsonWriterError(JsonWriterError::UNBALANCED_MESSAGE);
+            if (m_after_key)
+                throw JsonWriterError(JsonWriterError::VALUE_EXPECTED_MESSAGE);
+            bool const empty = m_stack.back().empty;
+            m_stack.pop_back();
+            if (m_pretty && !empty)
+                m_serializer.append_indent(m_indent, depth());
+            m_sh.append(is_object ? '}' : ']');
+            return *this;
+        }
+
+        // stable: val 的生命周期长于输出的使用期, 零拷贝 handler 可以引用其中的字符串
+        json_writer& write_json(JsonT const& val, bool stable)
+        {
+            if (val.empty())
+                throw JsonWriterError(JsonWriterError::VALUE_EXPECTED_MESSAGE);
+            before_value();
+            if constexpr (traits::is_zero_copy_serialize_handler_v<SerializeHandlerT>)
+            {
+                if (!stable)
+                {
+                    // 先完整序列化到本地缓冲区, 再经 append() 复制到 handler 中
+                    std::string buffer;
+                    details::StringSerializeHandler sh(buffer);
+                    details::JsonSerializer<JsonT, details::StringSerializeHandler> serializer(sh, m_escape_slash);
+                    if (m_pretty)
+                        serializer.template dump<true>(val, m_indent, depth());
+                    else
+                        serializer.template dump<false>(val);
+                    m_sh.append(buffer.data(), buffer.size());
+                    return *this;
+                }
+            }
+            if (m_pretty)
+                m_serializer.template dump<true>(val, m_indent, depth());
+            else
+                m_serializer.template dump<false>(val);
+            return *this;
+        }
+
+    public:
+        explicit json_writer(SerializeHandlerT& handler, bool pretty = false, std::string_view indent = "\t",
+                             bool escape_forward_slash = details::DEFAULT_ESCAPE_FORWARD_SLASH)
+            : m_sh(handler), m_serializer(handler, escape_forward_slash), m_indent(indent), m_pretty(pretty),
+              m_escape_slash(escape_forward_slash) {}
+
+        json_writer& begin_object() { return begin_container(true); }
+        json_writer& end_object() { return end_container(true); }
+        json_writer& begin_array() { return begin_container(false); }
+        json_writer& end_array() { return end_container(false); }
+
+        json_writer& key(std::string_view name)
+        {
+            if (m_stack.empty() || !m_stack.back().is_object)
+                throw JsonWriterError(JsonWriterError::KEY_OUTSIDE_OBJECT_MESSAGE);
+            if (m_after_key)
+                throw JsonWriterError(JsonWriterError::VALUE_EXPECTED_MESSAGE);
+            begin_element();
+            m_serializer.escape_string(name, false);
+            if (m_pretty)
+                m_sh.append(": ", 2);
+            else
+                m_sh.append(':');
+            m_after_key = true;
+            return *this;
+        }
+
+        json_writer& value(null_t) { before_value(); m_serializer.write_null(); return *this; }
+        json_writer& value(bool val) { before_value(); m_serializer.write_bool(val); return *this; }
+
+        template <typename T_Integer,
+            std::enable_if_t<std::is_integral_v<T_Integer> && !std::is_same_v<T_Integer, bool>, int> = 0>
+        json_writer& value(T_Integer val) { before_value(); m_serializer.write_integer(val); return *this; }
+
+        template <typename T_Float,
+            std::enable_if_t<std::is_floating_point_v<T_Float>, int> = 0>
+        json_writer& value(T_Float val) { before_value(); m_serializer.write_float(val); return *this; }
+
+        json_writer& value(std::string_view val) { before_value(); m_serializer.escape_string(val, false); return *this; }
+        json_writer& value(char const* val) { return value(std::string_view(val)); }
+        json_writer& value(std::string const& val) { return value(std::string_view(val)); }
+
+        // Embeds an existing DOM subtree; an empty basic_json is not a value and is rejected
+        json_writer& value(JsonT const& val) { return write_json(val, true); }
+        // A temporary is destroyed before a zero-copy handler's segments are consumed, so it is copied instead
+        json_writer& value(JsonT&& val) { return write_json(val, false); }
+
+        // Shorthand for key(name).value(val)
+        template <typename T>
+        json_writer& member(std::string_view name, T&& val) { return key(name).value(std::forward<T>(val)); }
+
+        // True once a complete top-level value has been written
+        bool complete() const noexcept { return m_root_written && m_stack.empty(); }
+    }; // class json_writer
+
+}
+
+#endif //JSONPP_JSON_WRITER_HPP
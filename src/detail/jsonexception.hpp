@@ -69,10 +69,69 @@ namespace jsonpp
     public:
         static constexpr char const* ARRAY_OUT_OF_RANGE_MESSAGE = "JSON array index out of range";
         static constexpr char const* KEY_NOT_FOUND_MESSAGE = "Key not found in JSON object";
+        static constexpr char const* MSGPACK_LENGTH_MESSAGE = "MessagePack: strings, arrays and maps are limited to 2^32-1 entries";
+        static constexpr char const* CBOR_NEGATIVE_MESSAGE = "CBOR: negative integer does not fit an unsigned number_int";
 
         JsonOutOfRange(std::string const& msg):
             JsonException(msg) {}
     };
+    class JsonWriterError : public JsonException
+    {
+    public:
+        static constexpr char const* KEY_OUTSIDE_OBJECT_MESSAGE = "JSON writer: key() is only allowed directly inside an object";
+        static constexpr char const* KEY_EXPECTED_MESSAGE = "JSON writer: expected key() before an object member value";
+        static constexpr char const* VALUE_EXPECTED_MESSAGE = "JSON writer: expected a value after key()";
+        static constexpr char const* UNBALANCED_MESSAGE = "JSON writer: end_object()/end_array() does not match the open container";
+        static constexpr char const* MULTIPLE_ROOTS_MESSAGE = "JSON writer: a document has exactly one top-level value";
+
+        JsonWriterError(std::string const& msg):
+            JsonException(msg) {}
+    };
+
+    class JsonSnapshotError : public JsonException
+    {
+    public:
+        static constexpr char const* CORRUPT_MESSAGE = "JSON snapshot: corrupt data (offset, length or nesting out of range)";
+
+        JsonSnapshotError(std::string const& msg):
+            JsonException(msg) {}
+    };
+    class JsonPatchError : public JsonException
+    {
+    public:
+        JsonPatchError(std::string const& msg):
+            JsonException("JSON Patch: " + msg) {}
+
+        JsonPatchError(std::string const& msg, std::size_t operation):
+            JsonException("JSON Patch operation #" + std::to_string(operation) + ": " + msg) {}
+    };
+
+    class JsonSchemaError : public JsonException
+    {
+        std::string m_location;
+
+    public:
+        // Invalid schema
+        JsonSchemaError(std::string const& msg):
+            JsonException("JSON Schema: " + msg) {}
+
+        // Instance that does not conform; location is the JSON Pointer of the failing value
+        JsonSchemaError(std::string const& msg, std::string const& location):
+            JsonException("JSON Schema: " + msg + " at \"" + location + "\""), m_location(location) {}
+
+        JsonSchemaError(std::string const& msg, std::string const& location, std::size_t pos):
+            JsonException("JSON Schema: " + msg + " at \"" + location + "\" (position " + std::to_string(pos) + ")"),
+            m_location(location) {}
+
+        std::string const& instance_location() const noexcept { return m_location; }
+    };
+
+    class JsonPathError : public JsonException
+    {
+    public:
+        JsonPathError(std::string const& msg, std::size_t pos):
+            JsonException("JSONPath: " + msg + " at position " + std::to_string(pos)) {}
+    };
     /*
      * end JSON exceptions
      */
@@ -41,11 +41,33 @@ typename BooleanType,   \
 typename NumberIntegerType, \
 typename NumberFloatType,   \
 template<typename U> class AllocatorType,   \
+template<typename T, typename SFINAE> class JSONSerializer, \
 typename CustomBaseClass    \
 >
 
 #define BASIC_JSON_TYPE \
-basic_json<ObjectType, ArrayType, StringType, BooleanType, NumberIntegerType, NumberFloatType, AllocatorType, CustomBaseClass>
+basic_json<ObjectType, ArrayType, StringType, BooleanType, NumberIntegerType, NumberFloatType, AllocatorType, JSONSerializer, CustomBaseClass>
+
+// SIMD support for the serializer's escape scanning. Define JSONPP_NO_SIMD to force the portable path.
+#if !defined(JSONPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JSONPP_HAS_SSE2 1
+#else
+#define JSONPP_HAS_SSE2 0
+#endif
+
+// POSIX file descriptor output (write/writev)
+#if defined(__unix__) || defined(__APPLE__)
+#define JSONPP_HAS_POSIX_IO 1
+#else
+#define JSONPP_HAS_POSIX_IO 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define JSONPP_CTZ_(x) static_cast<std::size_t>(__builtin_ctz(x))
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define JSONPP_CTZ_(x) [](unsigned long v) { unsigned long idx; _BitScanForward(&idx, v); return static_cast<std::size_t>(idx); }(x)
+#endif
 
 #define _STR(x) #x
 #define TO_STRING(x) _STR(x)
@@ -0,0 +1,377 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_MSGPACK_HPP
+#define JSONPP_MSGPACK_HPP
+
+#include "basic_json.hpp"
+#include "binary_io.hpp"
+#include "traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace jsonpp
+{
+    namespace details
+    {
+        /*
+         * MessagePack encoder. Every value uses its smallest format: fixint/fixstr/fixarray/fixmap where possible,
+         * otherwise the narrowest sized format. Floats are written as float32 when that is exact.
+         * An empty basic_json is encoded as nil.
+         */
+        template <typename JsonT, typename SerializeHandlerT>
+        class MsgpackWriter
+        {
+            static_assert(traits::is_json_serialize_handler_v<SerializeHandlerT>, "SerializeHandlerT should be a JSON Serialize Handler.");
+
+            using number_int = typename JsonT::number_int;
+            using number_float = typename JsonT::number_float;
+
+            SerializeHandlerT& m_sh;
+
+            void write_byte(std::uint8_t byte) { m_sh.append(static_cast<char>(byte)); }
+
+            template <typename UIntT>
+            void write_sized(std::uint8_t format, UIntT value)
+            {
+                write_byte(format);
+                write_big_endian(m_sh, value);
+            }
+
+            void write_unsigned(std::uint64_t value)
+            {
+                if (value < 0x80)
+                    write_byte(static_cast<std::uint8_t>(value)); // positive fixint
+                else if (value <= 0xFF)
+                    write_sized(0xCC, static_cast<std::uint8_t>(value));
+                else if (value <= 0xFFFF)
+                    write_sized(0xCD, static_cast<std::uint16_t>(value));
+                else if (value <= 0xFFFFFFFF)
+                    write_sized(0xCE, static_cast<std::uint32_t>(value));
+                else
+                    write_sized(0xCF, value);
+            }
+
+            void write_negative(std::int64_t value)
+            {
+                if (value >= -32)
+                    write_byte(static_cast<std::uint8_t>(value)); // negative fixint
+                else if (value >= INT8_MIN)
+                    write_sized(0xD0, static_cast<std::uint8_t>(value));
+                else if (value >= INT16_MIN)
+                    write_sized(0xD1, static_cast<std::uint16_t>(value));
+                else if (value >= INT32_MIN)
+                    write_sized(0xD2, static_cast<std::uint32_t>(value));
+                else
+                    write_sized(0xD3, static_cast<std::uint64_t>(value));
+            }
+
+            // fix 格式的上限为 fix_limit, 否则依次使用 8/16/32 位长度 (format8 为 0 表示没有 8 位格式); 没有 64 位长度
+            void write_length(std::size_t length, std::uint8_t fix_base, std::size_t fix_limit,
+                              std::uint8_t format8, std::uint8_t format16, std::uint8_t format32)
+            {
+                if (length < fix_limit)
+                    write_byte(static_cast<std::uint8_t>(fix_base | length));
+                else if (format8 != 0 && length <= 0xFF)
+                    write_sized(format8, static_cast<std::uint8_t>(length));
+                else if (length <= 0xFFFF)
+                    write_sized(format16, static_cast<std::uint16_t>(length));
+                else if (length <= 0xFFFFFFFF)
+                    write_sized(format32, static_cast<std::uint32_t>(length));
+                else
+                    throw JsonOutOfRange(JsonOutOfRange::MSGPACK_LENGTH_MESSAGE);
+            }
+
+            void write_string(std::string_view str)
+            {
+                write_length(str.size(), 0xA0, 32, 0xD9, 0xDA, 0xDB);
+                if constexpr (traits::is_zero_copy_serialize_handler_v<SerializeHandlerT>)
+                    m_sh.append_reference(str.data(), str.size());
+                else
+                    m_sh.append(str.data(), str.size());
+            }
+
+            void write_float(number_float value)
+            {
+                if constexpr (sizeof(number_float) <= sizeof(float))
+                    write_sized(0xCA, bit_cast<std::uint32_t>(static_cast<float>(value)));
+                else
+                {
+                    auto const wide = static_cast<double>(value);
+                    auto const single = static_cast<float>(wide);
+                    if (static_cast<double>(single) == wide || wide != wide) // 可无损表示为单精度 (或 NaN)
+                        write_sized(0xCA, bit_cast<std::uint32_t>(single));
+                    else
+                        write_sized(0xCB, bit_cast<std::uint64_t>(wide));
+                }
+            }
+
+        public:
+            explicit MsgpackWriter(SerializeHandlerT& handler): m_sh(handler) {}
+
+            void write(JsonT const& json)
+            {
+                switch (json.type())
+                {
+                case Type::empty:
+                case Type::null:
+                    write_byte(0xC0);
+                    break;
+                case Type::boolean:
+                    write_byte(json.as_bool() ? 0xC3 : 0xC2);
+                    break;
+                case Type::number_int:
+                    {
+                        auto const value = json.as_int();
+                        if constexpr (std::is_signed_v<number_int>)
+                        {
+                            if (value < 0)
+                            {
+                                write_negative(static_cast<std::int64_t>(value));
+                                break;
+                            }
+                        }
+                        write_unsigned(static_cast<std::uint64_t>(value));
+                        break;
+                    }
+                case Type::number_float:
+                    write_float(json.as_float());
+                    break;
+                case Type::string:
+                    write_string(json.as_string());
+                    break;
+                case Type::array:
+                    {
+                        auto const& arr = json.as_array();
+                        write_length(arr.size(), 0x90, 16, 0, 0xDC, 0xDD);
+                        for (auto const& item : arr)
+                            write(item);
+                        break;
+                    }
+                case Type::object:
+                    {
+                        auto const& obj = json.as_object();
+                        write_length(obj.size(), 0x80, 16, 0, 0xDE, 0xDF);
+                        for (auto const& [key, value] : obj)
+                        {
+                            write_string(key);
+                            write(value);
+                        }
+                        break;
+                    }
+                case Type::raw:
+                    write(json.resolved()); // 解析结果缓存在节点中, 零拷贝输出引用的字符串与节点同寿命
+                    break;
+                }
+            }
+        }; // class MsgpackWriter
+
+        /*
+         * MessagePack decoder producing a basic_json. bin payloads become base64url strings (as for CBOR);
+         * extension types have no JSON equivalent and are rejected. Integers that do not fit number_int
+         * become number_float. parse() expects exactly one message, parse_next() reads one message of a sequence.
+         */
+        template <typename StreamT, typename JsonT>
+        class MsgpackParser : public BinaryParserBase<StreamT>
+        {
+        protected:
+            using ParserBase<StreamT>::tell_pos;
+            using ParserBase<StreamT>::eof;
+            using BinaryParserBase<StreamT>::fail;
+            using BinaryParserBase<StreamT>::enter;
+            using BinaryParserBase<StreamT>::leave;
+            using BinaryParserBase<StreamT>::remaining;
+            using BinaryParserBase<StreamT>::reserve_size;
+            using BinaryParserBase<StreamT>::read_byte;
+            using BinaryParserBase<StreamT>::read_bytes;
+
+            using number_int = typename JsonT::number_int;
+            using number_float = typename JsonT::number_float;
+            using string = typename JsonT::string;
+            using array = typename JsonT::array;
+            using object = typename JsonT::object;
+
+        private:
+            template <typename UIntT>
+            UIntT read() { return this->template read_big_endian<UIntT>(); }
+
+            std::size_t read_length(std::size_t length, std::size_t start, std::size_t min_item_size)
+            {
+                if (length > remaining() / min_item_size)
+                    fail("length exceeds the remaining input", start);
+                return length;
+            }
+
+            static JsonT make_unsigned(std::uint64_t value)
+            {
+                if (value <= static_cast<std::uint64_t>(std::numeric_limits<number_int>::max()))
+                    return JsonT(static_cast<number_int>(value));
+                return JsonT(static_cast<number_float>(value));
+            }
+
+            static JsonT make_signed(std::int64_t value)
+            {
+                if (value >= 0)
+                    return make_unsigned(static_cast<std::uint64_t>(value));
+                if constexpr (std::is_signed_v<number_int>)
+                {
+                    if (value >= static_cast<std::int64_t>(std::numeric_limits<number_int>::min()))
+                        return JsonT(static_cast<number_int>(value));
+                }
+                return JsonT(static_cast<number_float>(value));
+            }
+
+            string read_string(std::size_t length, std::size_t start)
+            {
+                string str;
+                read_bytes(read_length(length, start, 1), str);
+                return str;
+            }
+
+            JsonT read_array(std::size_t length, std::size_t start)
+            {
+                length = read_length(length, start, 1);
+                enter();
+                array arr;
+                arr.reserve(reserve_size(length));
+                for (std::size_t i = 0; i < length; ++i)
+                    arr.push_back(parse_item());
+                leave();
+                return {std::move(arr)};
+            }
+
+            JsonT read_map(std::size_t length, std::size_t start)
+            {
+                length = read_length(length, start, 2);
+                enter();
+                object obj;
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    auto const key_start = tell_pos();
+                    auto const format = read_byte();
+                    std::size_t key_length;
+                    if ((format & 0xE0) == 0xA0)
+                        key_length = format & 0x1F;
+                    else if (format == 0xD9)
+                        key_length = read<std::uint8_t>();
+                    else if (format == 0xDA)
+                        key_length = read<std::uint16_t>();
+                    else if (format == 0xDB)
+                        key_length = read<std::uint32_t>();
+                    else
+                        fail("map keys must be strings", key_start);
+                    auto key = read_string(key_length, key_start);
+                    obj[std::move(key)] = parse_item();
+                }
+                leave();
+                return {std::move(obj)};
+            }
+
+            JsonT parse_item()
+            {
+                auto const start = tell_pos();
+                auto const format = read_byte();
+
+                if (format < 0x80) // positive fixint
+                    return JsonT(static_cast<number_int>(format));
+                if (format >= 0xE0) // negative fixint
+                    return make_signed(static_cast<std::int8_t>(format));
+                if (format < 0x90)
+                    return read_map(format & 0x0F, start);
+                if (format < 0xA0)
+                    return read_array(format & 0x0F, start);
+                if (format < 0xC0)
+                    return JsonT(read_string(format & 0x1F, start));
+
+                switch (format)
+                {
+                case 0xC0: return {null};
+                case 0xC2: return JsonT(false);
+                case 0xC3: return JsonT(true);
+                case 0xC4: return JsonT(base64url_encode<string>(read_string(read<std::uint8_t>(), start)));
+                case 0xC5: return JsonT(base64url_encode<string>(read_string(read<std::uint16_t>(), start)));
+                case 0xC6: return JsonT(base64url_encode<string>(read_string(read<std::uint32_t>(), start)));
+                case 0xCA: return JsonT(static_cast<number_float>(bit_cast<float>(read<std::uint32_t>())));
+                case 0xCB: return JsonT(static_cast<number_float>(bit_cast<double>(read<std::uint64_t>())));
+                case 0xCC: return make_unsigned(read<std::uint8_t>());
+                case 0xCD: return make_unsigned(read<std::uint16_t>());
+                case 0xCE: return make_unsigned(read<std::uint32_t>());
+                case 0xCF: return make_unsigned(read<std::uint64_t>());
+                case 0xD0: return make_signed(static_cast<std::int8_t>(read<std::uint8_t>()));
+                case 0xD1: return make_signed(static_cast<std::int16_t>(read<std::uint16_t>()));
+                case 0xD2: return make_signed(static_cast<std::int32_t>(read<std::uint32_t>()));
+                case 0xD3: return make_signed(static_cast<std::int64_t>(read<std::uint64_t>()));
+                case 0xD9: return JsonT(read_string(read<std::uint8_t>(), start));
+                case 0xDA: return JsonT(read_string(read<std::uint16_t>(), start));
+                case 0xDB: return JsonT(read_string(read<std::uint32_t>(), start));
+                case 0xDC: return read_array(read<std::uint16_t>(), start);
+                case 0xDD: return read_array(read<std::uint32_t>(), start);
+                case 0xDE: return read_map(read<std::uint16_t>(), start);
+                case 0xDF: return read_map(read<std::uint32_t>(), start);
+                case 0xC7: case 0xC8: case 0xC9:
+                case 0xD4: case 0xD5: case 0xD6: case 0xD7: case 0xD8:
+                    fail("extension types are not supported", start);
+                default: // 0xC1
+                    fail("invalid format byte", start);
+                }
+            }
+
+        public:
+            explicit MsgpackParser(StreamT& stream): BinaryParserBase<StreamT>(stream, "MessagePack") {}
+
+            // Decodes exactly one message spanning the whole input
+            JsonT parse()
+            {
+                JsonT result = parse_item();
+                if (!eof())
+                    fail("unexpected data after the message", tell_pos());
+                return result;
+            }
+
+            // Decodes the next message of a sequence and leaves the stream right after it
+            JsonT parse_next() { return parse_item(); }
+
+            bool at_end() const { return eof(); }
+        }; // class MsgpackParser
+    }
+
+    /*
+     * Pull reader for concatenated MessagePack messages (pipelined replies, record logs, ...).
+     * A truncated message at the end of the input throws JsonParseError.
+     */
+    template <typename StreamT, typename JsonT = json>
+    class msgpack_reader
+    {
+        static_assert(traits::is_json_stream_v<StreamT>, "StreamT should be a JSON Stream.");
+
+        details::MsgpackParser<StreamT, JsonT> m_parser;
+
+    public:
+        explicit msgpack_reader(StreamT& stream): m_parser(stream) {}
+
+        bool has_next() const { return !m_parser.at_end(); }
+        JsonT next() { return m_parser.parse_next(); }
+    };
+}
+
+#endif //JSONPP_MSGPACK_HPP
@@ -22,8 +22,11 @@ limitations under the License.
 #include "traits.hpp"
 #include "jsonexception.hpp"
 #include "basic_json.hpp"
+#include "json_pointer.hpp"
 
 #include <string_view>
+#include <string>
+#include <vector>
 #include <charconv>
 #include <cstddef>
 
@@ -86,6 +89,11 @@ namespace jsonpp
         private:
             string m_result;
             std::size_t m_start;
+            bool m_had_escape = false;
+            bool m_discard = false; // 只验证, 不保存结果 (用于跳过 raw 片段)
+
+            void put(char ch) { if (!m_discard) m_result += ch; }
+            void put(std::string_view chunk) { if (!m_discard) m_result.append(chunk); }
 
             enum class UCPStatus: std::uint8_t // Unicode Code Point Status
             {
@@ -104,10 +112,17 @@ namespace jsonpp
             void append_utf8(std::uint32_t codepoint);
             static std::uint32_t get_codepoint(std::uint16_t high, std::uint16_t low);
             void unescape_character();
+            string parse_body(); // 左引号之后的部分
 
         public:
             JSONStringParser(StreamT& stream, std::size_t _start): ParserBase<StreamT>(stream), m_result(), m_start(_start) {}
             string parse();
+            // 调用方已跳过左引号并读取了不含转义的前缀 prefix, 继续解析剩余部分
+            string parse_rest(std::string_view prefix) { put(prefix); return parse_body(); }
+            void skip() { m_discard = true; parse(); } // 验证字符串但不构造结果
+
+            // 源文本中没有转义序列时, 解析结果中也不会有需要转义的字符 (RFC 8259 禁止未转义的控制字符)
+            bool had_escape() const noexcept { return m_had_escape; }
 
         };
 
@@ -141,28 +156,28 @@ namespace jsonpp
             if (codepoint <= 0x7F)
             {
                 // ASCII, 0b0xxxxxxx
-                m_result += static_cast<char>(codepoint);
+                put(static_cast<char>(codepoint));
             }
             else if (codepoint <= 0x7FF)
             {
                 // 2-byte UTF-8, 0b110xxxxx 0b10xxxxxx
-                m_result += static_cast<char>(0xC0 | ((codepoint >> 6) & 0x1F));
-                m_result += static_cast<char>(0x80 | (codepoint & 0x3F));
+                put(static_cast<char>(0xC0 | ((codepoint >> 6) & 0x1F)));
+                put(static_cast<char>(0x80 | (codepoint & 0x3F)));
             }
             else if (codepoint <= 0xFFFF)
             {
                 // 3-byte UTF-8, 0b1110xxxx 0b10xxxxxx 0b10xxxxxx
-                m_result += static_cast<char>(0xE0 | ((codepoint >> 12) & 0x0F));
-                m_result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-                m_result += static_cast<char>(0x80 | (codepoint & 0x3F));
+                put(static_cast<char>(0xE0 | ((codepoint >> 12) & 0x0F)));
+                put(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                put(static_cast<char>(0x80 | (codepoint & 0x3F)));
             }
             else if (codepoint <= 0x10FFFF)
             {
                 // 4-byte UTF-8, 0b11110xxx 0b10xxxxxx 0b10xxxxxx 0b10xxxxxx
-                m_result += static_cast<char>(0xF0 | (codepoint >> 18));
-                m_result += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
-                m_result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
-                m_result += static_cast<char>(0x80 | (codepoint & 0x3F));
+                put(static_cast<char>(0xF0 | (codepoint >> 18)));
+                put(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+                put(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+                put(static_cast<char>(0x80 | (codepoint & 0x3F)));
             }
         }
 
@@ -178,14 +193,14 @@ namespace jsonpp
         {
             switch (peek())
             {
-            case '\"': m_result += '\"'; advance(); break;
-            case '\\': m_result += '\\'; advance(); break;
-            case '/': m_result += '/'; advance(); break;
-            case 'b': m_result += '\b'; advance(); break;
-            case 'f': m_result += '\f'; advance(); break;
-            case 'n': m_result += '\n'; advance(); break;
-            case 'r': m_result += '\r'; advance(); break;
-            case 't': m_result += '\t'; advance(); break;
+            case '\"': put('\"'); advance(); break;
+            case '\\': put('\\'); advance(); break;
+            case '/': put('/'); advance(); break;
+            case 'b': put('\b'); advance(); break;
+            case 'f': put('\f'); advance(); break;
+            case 'n': put('\n'); advance(); break;
+            case 'r': put('\r'); advance(); break;
+            case 't': put('\t'); advance(); break;
             case 'u':
                 {
                     auto upos = tell_pos();
@@ -223,12 +238,12 @@ namespace jsonpp
         typename JSONStringParser<StreamT, JsonT>::string JSONStringParser<StreamT, JsonT>::parse()
         {
             advance(); // 字符串起点, 跳过左引号
+            return parse_body();
+        }
 
-            if constexpr (is_sized_stream_v<StreamT>)
-            { // 如果能直接得到整个流的大小则直接预留空间
-                m_result.reserve(size());
-            }
-
+        template <typename StreamT, typename JsonT>
+        typename JSONStringParser<StreamT, JsonT>::string JSONStringParser<StreamT, JsonT>::parse_body()
+        {
             while (!eof())
             {
                 if constexpr (is_contiguous_stream_v<StreamT>)
@@ -239,7 +254,7 @@ namespace jsonpp
                     });
 
                     if (!chunk.empty())
-                        m_result.append(chunk);
+                        put(chunk);
                     JSONPP_CHECK_EOF_("string", m_start);
                 }
                 // 下面检查为什么停下
@@ -250,6 +265,7 @@ namespace jsonpp
 
                 if (ch == '\\')
                 {
+                    m_had_escape = true;
                     advance();
                     unescape_character();
                 }
@@ -259,7 +275,7 @@ namespace jsonpp
                 else
                 {
                     // 只有 IStreamStream 会在这里命中好字符, StringViewStream 已经在 chunk 中处理了它们
-                    m_result += ch;
+                    put(static_cast<char>(ch));
                     advance();
                 }
             }
@@ -288,9 +304,15 @@ namespace jsonpp
             using array = typename JsonT::array;
             using object = typename JsonT::object;
 
+            using raw = typename JsonT::raw;
+
         private:
             int m_nesting_depth;
 
+            ParseOptions const* m_options;
+            std::vector<std::vector<std::string>> m_raw_paths; // 预先拆分的 JSON Pointer
+            std::vector<std::string> m_path; // 当前值的路径, 仅在 m_raw_paths 非空时维护
+
             static bool is_whitespace(char ch) noexcept;
 
             void skip_whitespace() noexcept; // 跳过从 pos 开始的空白字符, 使 pos 指向调用函数后的第一个非空白字符
@@ -300,6 +322,7 @@ namespace jsonpp
             static JsonT parse_number_from_chunk(std::string_view chunk, std::size_t start);
 
             JsonT parse_value(); // 解析, 返回并跳过从当前 pos 开始的一个 basic_json, 使 pos 指向被解析的 basic_json 后的第一个字节
+            JsonT parse_value_impl();
 
             JsonT parse_null();
             JsonT parse_true();
@@ -309,14 +332,164 @@ namespace jsonpp
             JsonT parse_array();
             JsonT parse_object();
 
+            // Raw fragments
+            bool tracks_path() const noexcept { return !m_raw_paths.empty(); }
+            bool keep_raw(char ch) const;
+            JsonT parse_raw();
+
+            void skip_value(); // 与 parse_value() 做相同的检查, 但不构造结果
+            void skip_array();
+            void skip_object();
+
         public:
             Parser() = delete;
 
-            explicit Parser(StreamT& stream) : ParserBase<StreamT>(stream), m_nesting_depth(0) {}
+            explicit Parser(StreamT& stream, ParseOptions const* options = nullptr);
 
             JsonT parse();
+            void validate(); // 检查整个文档恰好是一个合法的 JSON 值, 不构造结果
+
+            // 供其他解析器嵌入使用: 解析/跳过当前位置的一个值, 不检查其后的内容
+            JsonT parse_one() { return parse_value(); }
+            void skip_one() { skip_value(); }
         };
 
+        template <typename StreamT, typename JsonT>
+        Parser<StreamT, JsonT>::Parser(StreamT& stream, ParseOptions const* options)
+            : ParserBase<StreamT>(stream), m_nesting_depth(0), m_options(options)
+        {
+            if (m_options)
+            {
+                m_raw_paths.reserve(m_options->raw_paths.size());
+                for (auto const& pointer : m_options->raw_paths)
+                    m_raw_paths.push_back(split_json_pointer(pointer));
+            }
+        }
+
+        template <typename StreamT, typename JsonT>
+        bool Parser<StreamT, JsonT>::keep_raw(char ch) const
+        {
+            if (m_options->raw_depth != 0 && (ch == '[' || ch == '{')
+                && static_cast<std::size_t>(m_nesting_depth) >= m_options->raw_depth)
+                return true;
+            for (auto const& path : m_raw_paths)
+                if (path == m_path)
+                    return true;
+            return false;
+        }
+
+        template <typename StreamT, typename JsonT>
+        JsonT Parser<StreamT, JsonT>::parse_raw()
+        {
+            std::size_t const start = tell_pos();
+            skip_value();
+            return JsonT(raw{ string(get_chunk(start, tell_pos() - start)) });
+        }
+
+        template <typename StreamT, typename JsonT>
+        void Parser<StreamT, JsonT>::skip_value()
+        {
+            if (eof())
+                throw JsonParseError("Unexpected end of file");
+            char ch = peek();
+            switch (ch)
+            {
+            case 'n': parse_literal("null", 4); break;
+            case 't': parse_literal("true", 4); break;
+            case 'f': parse_literal("false", 5); break;
+            case '\"': JSONStringParser<StreamT, JsonT>(m_stream, tell_pos()).skip(); break;
+            case '[': skip_array(); break;
+            case '{': skip_object(); break;
+            default:
+                if ((ch >= '0' && ch <= '9') || ch == '-')
+                    parse_number(); // 数字没有堆分配, 直接复用
+                else
+                    throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+            }
+        }
+
+        template <typename StreamT, typename JsonT>
+        void Parser<StreamT, JsonT>::skip_array()
+        {
+            if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                throw JsonDepthLimitExceeded(tell_pos());
+
+            auto start = tell_pos();
+            advance(); // 跳过左 [
+            skip_whitespace();
+            while (!eof() && peek() != ']')
+            {
+                skip_value();
+                skip_whitespace();
+
+                if (peek() == ']')
+                    break;
+                else if (peek() != ',')
+                {
+                    JSONPP_CHECK_EOF_("array", start);
+                    throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                }
+                advance(); // 跳过 ','
+
+                skip_whitespace();
+
+                if (peek() == ']')
+                    throw JsonParseError("Expected value after comma, but found ']' instead", tell_pos());
+            }
+            JSONPP_CHECK_EOF_("array", start);
+
+            advance(); // 跳过右 ]
+            --m_nesting_depth;
+        }
+
+        template <typename StreamT, typename JsonT>
+        void Parser<StreamT, JsonT>::skip_object()
+        {
+            if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                throw JsonDepthLimitExceeded(tell_pos());
+
+            auto start = tell_pos();
+            advance(); // 跳过左 {
+            skip_whitespace();
+            while (!eof() && peek() != '}')
+            {
+                if (peek() != '\"') [[unlikely]]
+                    throw JsonParseError("Key of an object must be string");
+                JSONStringParser<StreamT, JsonT>(m_stream, tell_pos()).skip();
+
+                skip_whitespace();
+
+                if (peek() != ':')
+                {
+                    JSONPP_CHECK_EOF_("object", start);
+                    throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                }
+                advance();
+
+                skip_whitespace();
+                skip_value();
+                skip_whitespace();
+
+                if (peek() == '}')
+                    break;
+                else if (peek() != ',')
+                {
+                    JSONPP_CHECK_EOF_("object", start);
+                    throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                }
+                advance(); // skip comma
+
+                skip_whitespace();
+
+                if (peek() == '}')
+                    throw JsonParseError("Expected value after comma, but found '}' instead", tell_pos());
+            }
+            JSONPP_CHECK_EOF_("object", start);
+
+            advance(); // 跳过右 }
+            --m_nesting_depth;
+        }
+
         template <typename StreamT, typename JsonT>
         void Parser<StreamT, JsonT>::parse_literal(char const* lit, std::size_t len)
         {
@@ -365,11 +538,30 @@ namespace jsonpp
 
         template <typename StreamT, typename JsonT>
         JsonT Parser<StreamT, JsonT>::parse_value()
+        {
+            if (m_options && m_options->source_spans)
+            {
+                std::size_t const start = tell_pos();
+                JsonT result = parse_value_impl();
+                result.set_span_id(m_options->source_spans->record(start, tell_pos() - start));
+                return result;
+            }
+            return parse_value_impl();
+        }
+
+        template <typename StreamT, typename JsonT>
+        JsonT Parser<StreamT, JsonT>::parse_value_impl()
         {
             // 调用该函数之前与之后均调用了 skip_whitespace()
             if (eof())
                 throw JsonParseError("Unexpected end of file");
             char ch = peek();
+            if constexpr (is_contiguous_stream_v<StreamT>)
+            {
+                // raw 片段直接引用源文本, 因此只在连续流上可用
+                if (m_options && keep_raw(ch))
+                    return parse_raw();
+            }
             switch (ch)
             {
             case 'n':
@@ -443,7 +635,11 @@ namespace jsonpp
         template <typename StreamT, typename JsonT>
         JsonT Parser<StreamT, JsonT>::parse_string()
         {
-            return JSONStringParser<StreamT, JsonT>(m_stream, tell_pos()).parse();
+            JSONStringParser<StreamT, JsonT> string_parser(m_stream, tell_pos());
+            JsonT result(string_parser.parse());
+            if (!string_parser.had_escape())
+                result.add_hint(JsonT::HINT_STRING_CLEAN);
+            return result;
         }
 
         template <typename StreamT, typename JsonT>
@@ -459,7 +655,14 @@ namespace jsonpp
             skip_whitespace();
             while (!eof() && peek() != ']')
             {
-                arr.push_back(parse_value());
+                if (tracks_path())
+                {
+                    m_path.push_back(std::to_string(arr.size()));
+                    arr.push_back(parse_value());
+                    m_path.pop_back();
+                }
+                else
+                    arr.push_back(parse_value());
                 skip_whitespace();
 
                 // json数组中对象以外的字符只能是空白字符或'['或']'或','
@@ -481,7 +684,7 @@ namespace jsonpp
 
             advance(); // 跳过右 ]
             --m_nesting_depth; // Decrease nesting depth counter before returning
-            return {arr};
+            return {std::move(arr)};
         }
 
         template <typename StreamT, typename JsonT>
@@ -512,8 +715,12 @@ namespace jsonpp
                 advance();
 
                 skip_whitespace();
-                auto val = parse_value();
-                obj[key.as_string()] = val;
+                if (tracks_path())
+                    m_path.emplace_back(*std::get_if<string>(&key.m_value));
+                auto& slot = obj[std::move(*std::get_if<string>(&key.m_value))];
+                slot = parse_value();
+                if (tracks_path())
+                    m_path.pop_back();
 
                 skip_whitespace();
 
@@ -535,12 +742,19 @@ namespace jsonpp
 
             advance(); // 跳过右 }
             --m_nesting_depth; // Decrease nesting depth counter before returning
-            return {obj};
+            return {std::move(obj)};
         }
 
         template <typename StreamT, typename JsonT>
         JsonT Parser<StreamT, JsonT>::parse()
         {
+            if (m_options && m_options->source_spans)
+            {
+                if constexpr (is_contiguous_stream_v<StreamT>)
+                    m_options->source_spans->start(m_stream.size() - tell_pos());
+                else
+                    m_options->source_spans->start(0); // 长度未知, 无法预留编号: 不记录
+            }
             skip_whitespace();
             if (eof()) // doc 为空
                 return {};
@@ -555,6 +769,17 @@ namespace jsonpp
 
             return {};
         }
+
+        template <typename StreamT, typename JsonT>
+        void Parser<StreamT, JsonT>::validate()
+        {
+            skip_whitespace();
+            skip_value();
+            skip_whitespace();
+
+            if (!eof())
+                throw JsonParseError("Unexpected character(s) after JSON value");
+        }
         /*
          * end JSON Parser
          */
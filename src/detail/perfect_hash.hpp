@@ -0,0 +1,162 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_PERFECT_HASH_HPP
+#define JSONPP_PERFECT_HASH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace jsonpp::details
+{
+    constexpr std::uint64_t fnv1a_64(std::string_view text) noexcept
+    {
+        std::uint64_t h = 0xcbf29ce484222325ULL;
+        for (char c : text)
+        {
+            h ^= static_cast<unsigned char>(c);
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+
+    // splitmix64 finalizer
+    constexpr std::uint64_t mix64(std::uint64_t x) noexcept
+    {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    constexpr std::size_t next_pow2(std::size_t n) noexcept
+    {
+        std::size_t p = 1;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    /*
+     * Perfect hash over a fixed set of N keys, built at compile time by hash-and-displace: the keys are grouped
+     * into buckets by one hash, and every bucket gets the first displacement that sends all of its keys to free
+     * slots (largest buckets first). A lookup hashes the key once, reads two small tables and compares one key.
+     */
+    template <std::size_t N>
+    class PerfectHashTable
+    {
+        static_assert(N < 0xFFFF, "PerfectHashTable: too many keys");
+
+    public:
+        static constexpr std::size_t SLOTS = next_pow2(2 * N);
+        static constexpr std::size_t BUCKETS = next_pow2(N / 2 + 1);
+        static constexpr std::uint16_t EMPTY = 0xFFFF;
+        static constexpr std::uint32_t MAX_DISPLACEMENT = 0xFFFF;
+
+    private:
+        std::array<std::string_view, N> m_keys{};
+        std::array<std::uint16_t, BUCKETS> m_displacement{};
+        std::array<std::uint16_t, SLOTS> m_slots{};
+        bool m_valid = false;
+
+        static constexpr std::size_t bucket_of(std::uint64_t h) noexcept { return mix64(h) & (BUCKETS - 1); }
+
+        static constexpr std::size_t slot_of(std::uint64_t h, std::uint32_t displacement) noexcept
+        {
+            return mix64(h + displacement * 0x9E3779B97F4A7C15ULL) & (SLOTS - 1);
+        }
+
+        // 为 bucket 寻找使其所有键落在空槽中的位移
+        constexpr bool place(std::array<std::uint64_t, N> const& hashes, std::size_t bucket)
+        {
+            for (std::uint32_t d = 0; d <= MAX_DISPLACEMENT; ++d)
+            {
+                bool ok = true;
+                for (std::size_t i = 0; i < N && ok; ++i)
+                {
+                    if (bucket_of(hashes[i]) != bucket)
+                        continue;
+                    auto& slot = m_slots[slot_of(hashes[i], d)];
+                    if (slot == EMPTY)
+                        slot = static_cast<std::uint16_t>(i);
+                    else
+                        ok = false;
+                }
+                if (ok)
+                {
+                    m_displacement[bucket] = static_cast<std::uint16_t>(d);
+                    return true;
+                }
+                for (auto& slot : m_slots) // 撤销本轮放置
+                    if (slot != EMPTY && bucket_of(hashes[slot]) == bucket)
+                        slot = EMPTY;
+            }
+            return false;
+        }
+
+    public:
+        // valid() is false when the keys are not distinct
+        constexpr explicit PerfectHashTable(std::array<std::string_view, N> const& keys)
+        {
+            m_keys = keys;
+            for (auto& slot : m_slots)
+                slot = EMPTY;
+            for (std::size_t i = 0; i < N; ++i)
+                for (std::size_t j = i + 1; j < N; ++j)
+                    if (keys[i] == keys[j])
+                        return;
+
+            std::array<std::uint64_t, N> hashes{};
+            std::array<std::size_t, BUCKETS> sizes{};
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                hashes[i] = fnv1a_64(keys[i]);
+                ++sizes[bucket_of(hashes[i])];
+            }
+
+            std::array<std::size_t, BUCKETS> order{};
+            for (std::size_t b = 0; b < BUCKETS; ++b)
+                order[b] = b;
+            for (std::size_t i = 1; i < BUCKETS; ++i) // 插入排序, 桶按大小降序
+                for (std::size_t j = i; j > 0 && sizes[order[j - 1]] < sizes[order[j]]; --j)
+                {
+                    auto const tmp = order[j];
+                    order[j] = order[j - 1];
+                    order[j - 1] = tmp;
+                }
+
+            for (std::size_t b : order)
+                if (sizes[b] != 0 && !place(hashes, b))
+                    return;
+            m_valid = true;
+        }
+
+        constexpr bool valid() const noexcept { return m_valid; }
+
+        // Index of key in the key array, or N if it is not one of the keys
+        constexpr std::size_t find(std::string_view key) const noexcept
+        {
+            auto const h = fnv1a_64(key);
+            auto const i = m_slots[slot_of(h, m_displacement[bucket_of(h)])];
+            return i != EMPTY && m_keys[i] == key ? i : N;
+        }
+    }; // class PerfectHashTable
+}
+
+#endif //JSONPP_PERFECT_HASH_HPP
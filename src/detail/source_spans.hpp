@@ -0,0 +1,91 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_SOURCE_SPANS_HPP
+#define JSONPP_SOURCE_SPANS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jsonpp::details
+{
+    /*
+     * Where every value of a document parsed with ParseOptions::source_spans starts and ends in the source text.
+     * The spans live here rather than in the nodes; a node only keeps an id. Ids are unique across all parses in the
+     * process and never reused, so a node copied or moved into another document can never be matched against the
+     * spans of that document's source (see basic_json::dump_incremental()).
+     */
+    class SourceSpans
+    {
+    public:
+        struct Span
+        {
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        // 节点中只有 56 位用于保存编号
+        static constexpr std::uint64_t MAX_ID = (std::uint64_t(1) << 56) - 1;
+
+        std::size_t size() const noexcept { return m_spans.size(); }
+        bool empty() const noexcept { return m_spans.empty(); }
+
+        // The span of the value with this id, or nullptr if it was not recorded by the last parse into this table
+        Span const* find(std::uint64_t id) const noexcept
+        {
+            auto const index = id - m_first_id;
+            return m_first_id != 0 && index < m_spans.size() ? &m_spans[static_cast<std::size_t>(index)] : nullptr;
+        }
+
+        // 开始一次新的解析: 每个值至少占一个字节, 所以预留 source_size 个编号一定够用
+        void start(std::size_t source_size)
+        {
+            m_spans.clear();
+            m_first_id = m_last_id = 0;
+            auto const count = static_cast<std::uint64_t>(source_size);
+            if (count == 0)
+                return;
+            auto const first = s_next_id.fetch_add(count, std::memory_order_relaxed);
+            if (first <= MAX_ID - count) // 编号用尽后不再记录, 节点照常重新序列化
+            {
+                m_first_id = first;
+                m_last_id = first + count - 1;
+            }
+        }
+
+        // 记录一个值, 返回其编号; 0 表示未记录
+        std::uint64_t record(std::size_t offset, std::size_t length)
+        {
+            auto const id = m_first_id + m_spans.size();
+            if (m_first_id == 0 || id > m_last_id)
+                return 0;
+            m_spans.push_back({ offset, length });
+            return id;
+        }
+
+    private:
+        static inline std::atomic<std::uint64_t> s_next_id{1};
+
+        std::uint64_t m_first_id = 0;
+        std::uint64_t m_last_id = 0;
+        std::vector<Span> m_spans;
+    };
+}
+
+#endif //JSONPP_SOURCE_SPANS_HPP
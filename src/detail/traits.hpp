@@ -143,6 +143,32 @@ namespace jsonpp::traits
 
     template <typename T>
     inline constexpr bool is_json_serialize_handler_v = is_json_serialize_handler<T>::value;
+
+    // Can the handler reference caller-owned memory instead of copying it (zero-copy string payloads)
+    template <typename T, typename = void>
+    struct is_zero_copy_serialize_handler : std::false_type {};
+
+    template <typename T>
+    struct is_zero_copy_serialize_handler<T, std::enable_if_t<is_json_serialize_handler_v<T>, std::void_t<
+        decltype(std::declval<T>().append_reference((char const*)0, std::size_t()))
+    >>>
+        : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_zero_copy_serialize_handler_v = is_zero_copy_serialize_handler<T>::value;
+
+    // Can the associative container look keys up by KeyT (transparent comparator / hash)
+    template <typename MapT, typename KeyT = std::string_view, typename = void>
+    struct has_transparent_find : std::false_type {};
+
+    template <typename MapT, typename KeyT>
+    struct has_transparent_find<MapT, KeyT, std::void_t<
+        decltype(std::declval<MapT&>().find(std::declval<KeyT const&>()))
+    >>
+        : std::true_type {};
+
+    template <typename MapT, typename KeyT = std::string_view>
+    inline constexpr bool has_transparent_find_v = has_transparent_find<MapT, KeyT>::value;
 }
 
 #endif //JSONPP_STREAM_TRAITS_HPP
\ No newline at end of file
@@ -0,0 +1,397 @@
+/*
+jsonpp - A modern, header-only C++ JSON library
+Copyright 2025-2026 Mikami (jsonpp project)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+   http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+ */
+
+#ifndef JSONPP_TYPED_PARSER_HPP
+#define JSONPP_TYPED_PARSER_HPP
+
+#include "macro_def.hpp"
+#include "adl_serializer.hpp"
+#include "jsonexception.hpp"
+#include "json_stream_adaptor.hpp"
+#include "parser.hpp"
+#include "perfect_hash.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace jsonpp
+{
+    namespace details
+    {
+        // Compile-time key table of a struct registered with JSONPP_FIELDS
+        template <typename T>
+        struct FieldDispatch
+        {
+            static constexpr auto fields = adl_lookup::fields_of<T>();
+            static constexpr std::size_t COUNT = std::tuple_size_v<std::decay_t<decltype(fields)>>;
+
+            template <std::size_t... I>
+            static constexpr std::array<std::string_view, COUNT> names_of(std::index_sequence<I...>)
+            {
+                return {std::get<I>(fields).name...};
+            }
+
+            static constexpr PerfectHashTable<COUNT> table{names_of(std::make_index_sequence<COUNT>())};
+            static_assert(table.valid(), "JSONPP_FIELDS: field names must be distinct");
+        };
+
+        /*
+         * Parses a document straight into C++ objects: bool, arithmetic types, strings, std::optional,
+         * sequence containers, string-keyed maps and structs registered with JSONPP_FIELDS are filled from the
+         * token stream without building basic_json nodes. Unknown members are validated and skipped.
+         * Types that only have an ADL from_json() are parsed into a JsonT subtree first and converted from it.
+         */
+        template <typename StreamT, typename JsonT>
+        class TypedParser : public ParserBase<StreamT>
+        {
+        protected:
+            JSONPP_IMPORT_PARSERBASE_MEMBERS_
+
+            // 以下成员也供派生的解析器 (如 ColumnParser) 复用
+            using string = typename JsonT::string;
+
+            int m_nesting_depth = 0;
+            string m_key_buffer; // 需要解码的键
+
+            template <typename>
+            static constexpr bool dependent_false = false;
+
+            [[noreturn]] void type_error(char const* expected) const
+            {
+                throw JsonTypeError(std::string("expected ") + expected + " at position " + std::to_string(tell_pos()));
+            }
+
+            void skip_whitespace() noexcept
+            {
+                while (peek() == ' ' || peek() == '\n' || peek() == '\r' || peek() == '\t')
+                    advance();
+            }
+
+            void parse_literal(char const* lit, std::size_t len)
+            {
+                for (std::size_t i = 0; i < len; ++i)
+                    consume(lit[i], JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos()));
+            }
+
+            void skip_value() { Parser<StreamT, JsonT>(m_stream).skip_one(); }
+
+            std::string_view read_number_text(std::string& scratch)
+            {
+                auto const is_num_char = [](int c)
+                {
+                    return (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' || c == 'e' || c == 'E';
+                };
+                if constexpr (is_contiguous_stream_v<StreamT>)
+                {
+                    std::size_t const start = tell_pos();
+                    while (is_num_char(peek()))
+                        advance();
+                    return get_chunk(start, tell_pos() - start);
+                }
+                else
+                {
+                    while (is_num_char(peek()))
+                        scratch += static_cast<char>(advance());
+                    return scratch;
+                }
+            }
+
+            template <typename T>
+            void read_number(T& out)
+            {
+                char const ch = static_cast<char>(peek());
+                if (!((ch >= '0' && ch <= '9') || ch == '-'))
+                    type_error("a number");
+                std::size_t const start = tell_pos();
+                std::string scratch;
+                auto const text = read_number_text(scratch);
+                char const* const first = text.data();
+                char const* const last = first + text.size();
+
+                if constexpr (std::is_integral_v<T>)
+                {
+                    auto [ptr, ec] = std::from_chars(first, last, out);
+                    if (ec == std::errc() && ptr == last)
+                        return;
+                    // 整数值的浮点写法 (如 1e3, 2.0) 也接受
+                    double value{};
+                    auto [fptr, fec] = std::from_chars(first, last, value);
+                    if (fec != std::errc() || fptr != last)
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, start);
+                    if (value != std::floor(value) || value < static_cast<double>(std::numeric_limits<T>::min())
+                        || value > static_cast<double>(std::numeric_limits<T>::max()))
+                        throw JsonTypeError("number does not fit the integer type at position " + std::to_string(start));
+                    out = static_cast<T>(value);
+                }
+                else
+                {
+                    auto [ptr, ec] = std::from_chars(first, last, out);
+                    if (ec == std::errc::result_out_of_range)
+                        throw JsonParseError("Number is out of range", start);
+                    if (ec != std::errc() || ptr != last)
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, start);
+                }
+            }
+
+            // 连续流上不含转义的字符串直接引用源文本, 不构造字符串; 结果在读取下一个字符串之前有效
+            std::string_view read_string_view()
+            {
+                if (peek() != '\"') [[unlikely]]
+                    type_error("a string");
+                std::size_t const start = tell_pos();
+                if constexpr (is_contiguous_stream_v<StreamT>)
+                {
+                    advance(); // 跳过左引号
+                    std::string_view const chunk = read_chunk_until([](char c)
+                    {
+                        return c == '\\' || c == '\"' || static_cast<unsigned char>(c) < 0x20;
+                    });
+                    if (peek() == '\"')
+                    {
+                        advance();
+                        return chunk;
+                    }
+                    m_key_buffer = JSONStringParser<StreamT, JsonT>(m_stream, start).parse_rest(chunk);
+                }
+                else
+                    m_key_buffer = JSONStringParser<StreamT, JsonT>(m_stream, start).parse();
+                return std::string_view(m_key_buffer.data(), m_key_buffer.size());
+            }
+
+            // on_member(key) 必须读取或跳过成员的值
+            template <typename OnMember>
+            void read_object(OnMember&& on_member)
+            {
+                if (peek() != '{')
+                    type_error("an object");
+                if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                    throw JsonDepthLimitExceeded(tell_pos());
+
+                auto const start = tell_pos();
+                advance(); // 跳过左 {
+                skip_whitespace();
+                while (!eof() && peek() != '}')
+                {
+                    if (peek() != '\"') [[unlikely]]
+                        throw JsonParseError("Key of an object must be string", tell_pos());
+                    std::string_view const key = read_string_view();
+                    skip_whitespace();
+                    if (peek() != ':')
+                    {
+                        JSONPP_CHECK_EOF_("object", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance();
+                    skip_whitespace();
+                    on_member(key);
+                    skip_whitespace();
+
+                    if (peek() == '}')
+                        break;
+                    else if (peek() != ',')
+                    {
+                        JSONPP_CHECK_EOF_("object", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance(); // skip comma
+                    skip_whitespace();
+                    if (peek() == '}')
+                        throw JsonParseError("Expected value after comma, but found '}' instead", tell_pos());
+                }
+                JSONPP_CHECK_EOF_("object", start);
+
+                advance(); // 跳过右 }
+                --m_nesting_depth;
+            }
+
+            template <typename OnElement>
+            void read_array(OnElement&& on_element)
+            {
+                if (peek() != '[')
+                    type_error("an array");
+                if (++m_nesting_depth > MAX_NESTING_DEPTH)
+                    throw JsonDepthLimitExceeded(tell_pos());
+
+                auto const start = tell_pos();
+                advance(); // 跳过左 [
+                skip_whitespace();
+                while (!eof() && peek() != ']')
+                {
+                    on_element();
+                    skip_whitespace();
+
+                    if (peek() == ']')
+                        break;
+                    else if (peek() != ',')
+                    {
+                        JSONPP_CHECK_EOF_("array", start);
+                        throw JsonParseError(JsonParseError::UNPARSABLE_MESSAGE, tell_pos());
+                    }
+                    advance(); // 跳过 ','
+                    skip_whitespace();
+                    if (peek() == ']')
+                        throw JsonParseError("Expected value after comma, but found ']' instead", tell_pos());
+                }
+                JSONPP_CHECK_EOF_("array", start);
+
+                advance(); // 跳过右 ]
+                --m_nesting_depth;
+            }
+
+            // 完美哈希把键映射到成员序号, 再经函数指针表写入成员
+            template <typename T, std::size_t... I>
+            void read_field(std::size_t index, T& out, std::index_sequence<I...>)
+            {
+                using Setter = void (*)(TypedParser&, T&);
+                static constexpr Setter setters[] = {
+                    [](TypedParser& parser, T& value) { parser.read(value.*(std::get<I>(FieldDispatch<T>::fields).member)); }...
+                };
+                setters[index](*this, out);
+            }
+
+            template <typename T>
+            void read_fields(T& out)
+            {
+                using Dispatch = FieldDispatch<T>;
+                read_object([&](std::string_view key)
+                {
+                    if constexpr (Dispatch::COUNT != 0)
+                    {
+                        if (auto const index = Dispatch::table.find(key); index != Dispatch::COUNT)
+                            return read_field(index, out, std::make_index_sequence<Dispatch::COUNT>());
+                    }
+                    skip_value();
+                });
+            }
+
+        public:
+            explicit TypedParser(StreamT& stream): ParserBase<StreamT>(stream) {}
+
+            // Reads the value at the current position into out
+            template <typename T>
+            void read(T& out)
+            {
+                if (eof())
+                    throw JsonParseError("Unexpected end of file");
+
+                if constexpr (std::is_same_v<T, JsonT>)
+                    out = Parser<StreamT, JsonT>(m_stream).parse_one();
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    if (peek() == 't')
+                        parse_literal("true", 4), out = true;
+                    else if (peek() == 'f')
+                        parse_literal("false", 5), out = false;
+                    else
+                        type_error("a boolean");
+                }
+                else if constexpr (std::is_arithmetic_v<T>)
+                    read_number(out);
+                else if constexpr (std::is_same_v<T, string>)
+                {
+                    if (peek() != '\"')
+                        type_error("a string");
+                    out = JSONStringParser<StreamT, JsonT>(m_stream, tell_pos()).parse();
+                }
+                else if constexpr (traits::is_optional<T>::value)
+                {
+                    if (peek() == 'n')
+                    {
+                        parse_literal("null", 4);
+                        out.reset();
+                    }
+                    else
+                        read(out.emplace());
+                }
+                else if constexpr (traits::has_json_fields_v<T>)
+                    read_fields(out);
+                else if constexpr (traits::is_string_map<T>::value)
+                {
+                    out.clear();
+                    read_object([&](std::string_view key) { read(out[typename T::key_type(key)]); });
+                }
+                else if constexpr (traits::is_sequence_container<T>::value)
+                {
+                    out.clear();
+                    read_array([&]
+                    {
+                        if constexpr (std::is_reference_v<decltype(out.emplace_back())>)
+                            read(out.emplace_back());
+                        else // std::vector<bool>
+                        {
+                            typename T::value_type item{};
+                            read(item);
+                            out.push_back(std::move(item));
+                        }
+                    });
+                }
+                else if constexpr (traits::has_from_json_v<typename JsonT::template json_serializer<T>, JsonT, T>)
+                    Parser<StreamT, JsonT>(m_stream).parse_one().get_to(out);
+                else
+                    static_assert(dependent_false<T>, "parse_into: T has no JSON mapping (register it with JSONPP_FIELDS or provide from_json)");
+            }
+
+            // Reads a whole document, which must consist of exactly one value
+            template <typename T>
+            void parse(T& out)
+            {
+                skip_whitespace();
+                read(out);
+                skip_whitespace();
+                if (!eof())
+                    throw JsonParseError("Unexpected character(s) after JSON value");
+            }
+        }; // class TypedParser
+    }
+
+    /*
+     * Deserializes a document directly into out without an intermediate basic_json (see details::TypedParser).
+     * JsonT only selects the string type and the serializer for types that need a DOM fallback.
+     */
+    template <typename T, typename JsonT = json>
+    void parse_into(std::string_view json_doc, T& out)
+    {
+        details::StringViewStream svs(json_doc);
+        details::TypedParser<details::StringViewStream, JsonT>(svs).parse(out);
+    }
+
+    template <typename T, typename JsonT = json>
+    void parse_into(std::istream& json_istream, T& out)
+    {
+        details::IStreamStream iss(json_istream);
+        details::TypedParser<details::IStreamStream, JsonT>(iss).parse(out);
+    }
+
+    template <typename T, typename JsonT = json>
+    T parse_into(std::string_view json_doc)
+    {
+        T out{};
+        parse_into<T, JsonT>(json_doc, out);
+        return out;
+    }
+}
+
+#endif //JSONPP_TYPED_PARSER_HPP
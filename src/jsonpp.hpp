@@ -24,5 +24,11 @@ limitations under the License.
 #include "detail/json_fwd.hpp"
 #include "detail/parser.hpp"
 #include "detail/basic_json_impl.hpp"
+#include "detail/json_writer.hpp"
+#include "detail/json_snapshot_holder.hpp"
+#include "detail/json_path.hpp"
+#include "detail/typed_parser.hpp"
+#include "detail/json_schema.hpp"
+#include "detail/json_columns.hpp"
 
 #endif //JSONPP_JSONPP_HPP
\ No newline at end of file
@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    // "0a 1b ff" -> bytes
+    std::string hex(std::string_view text)
+    {
+        std::string out;
+        int nibbles = 0, value = 0;
+        for (char ch : text)
+        {
+            if (ch == ' ')
+                continue;
+            value = value * 16 + (ch <= '9' ? ch - '0' : (ch | 0x20) - 'a' + 10);
+            if (++nibbles == 2)
+            {
+                out += static_cast<char>(value);
+                nibbles = value = 0;
+            }
+        }
+        return out;
+    }
+}
+
+// RFC 8949 Appendix A
+TEST(CborTest, EncodesShortestForm) {
+    EXPECT_EQ(json(0).to_cbor(), hex("00"));
+    EXPECT_EQ(json(23).to_cbor(), hex("17"));
+    EXPECT_EQ(json(24).to_cbor(), hex("1818"));
+    EXPECT_EQ(json(1000).to_cbor(), hex("1903e8"));
+    EXPECT_EQ(json(1000000).to_cbor(), hex("1a000f4240"));
+    EXPECT_EQ(json(1000000000000).to_cbor(), hex("1b000000e8d4a51000"));
+    EXPECT_EQ(json(-1).to_cbor(), hex("20"));
+    EXPECT_EQ(json(-1000).to_cbor(), hex("3903e7"));
+    EXPECT_EQ(json(1.5).to_cbor(), hex("fa3fc00000"));
+    EXPECT_EQ(json(1.1).to_cbor(), hex("fb3ff199999999999a"));
+    EXPECT_EQ(json(false).to_cbor(), hex("f4"));
+    EXPECT_EQ(json(null).to_cbor(), hex("f6"));
+    EXPECT_EQ(json("IETF").to_cbor(), hex("6449455446"));
+    EXPECT_EQ(json::parse("[1,[2,3],[4,5]]").to_cbor(), hex("8301820203820405"));
+    EXPECT_EQ(json::parse(R"({"a":1,"b":[2,3]})").to_cbor(), hex("a26161016162820203"));
+}
+
+TEST(CborTest, DecodesAppendixVectors) {
+    EXPECT_EQ(json::from_cbor(hex("1bffffffffffffffff")).as_float(), 18446744073709551615.0);
+    EXPECT_EQ(json::from_cbor(hex("3b7fffffffffffffff")).as_int(), INT64_MIN);
+    EXPECT_EQ(json::from_cbor(hex("f93e00")).as_float(), 1.5);
+    EXPECT_EQ(json::from_cbor(hex("f90001")).as_float(), 5.960464477539063e-8);
+    EXPECT_TRUE(std::isinf(json::from_cbor(hex("f9fc00")).as_float()));
+    EXPECT_TRUE(json::from_cbor(hex("f7")).is_null()); // undefined
+    EXPECT_EQ(json::from_cbor(hex("c074323031332d30332d32315432303a30343a30305a")).as_string(), "2013-03-21T20:04:00Z");
+    EXPECT_EQ(json::from_cbor(hex("4401020304")).as_string(), "AQIDBA"); // byte string -> base64url
+    EXPECT_EQ(json::from_cbor(hex("7f657374726561646d696e67ff")).as_string(), "streaming");
+    EXPECT_EQ(json::from_cbor(hex("9f018202039f0405ffff")), json::parse("[1,[2,3],[4,5]]"));
+    EXPECT_EQ(json::from_cbor(hex("bf61610161629f0203ffff")), json::parse(R"({"a":1,"b":[2,3]})"));
+}
+
+TEST(CborTest, DecodesTypedArrays) {
+    EXPECT_EQ(json::from_cbor(hex("d84043010203")), json::parse("[1,2,3]"));              // uint8
+    EXPECT_EQ(json::from_cbor(hex("d84544e8030100")), json::parse("[1000,1]"));           // uint16 LE
+    EXPECT_EQ(json::from_cbor(hex("d84a48fffffffffffffffe")), json::parse("[-1,-2]"));    // sint32 BE
+    EXPECT_EQ(json::from_cbor(hex("d8504400003e00")), json::parse("[0.0,1.5]"));         // float16 BE
+    EXPECT_EQ(json::from_cbor(hex("d85648000000000000f83f")), json::parse("[1.5]"));      // float64 LE
+    EXPECT_THROW(json::from_cbor(hex("d84143010203")), JsonParseError);                      // 长度不是元素大小的整数倍
+}
+
+TEST(CborTest, RoundTrip) {
+    auto doc = json::parse(R"({"id":-9223372036854775808,"max":9223372036854775807,"pi":3.141592653589793,
+        "f":0.25,"s":"línea\n","nested":{"list":[true,false,null,[],{}],"empty":""}})");
+    std::string const encoded = doc.to_cbor();
+    EXPECT_EQ(json::from_cbor(encoded), doc);
+
+    std::istringstream is(encoded);
+    EXPECT_EQ(json::from_cbor(is), doc);
+
+    details::ScatterGatherSerializeHandler sg(4);
+    doc.to_cbor(sg);
+    EXPECT_EQ(sg.str(), encoded);
+
+    auto const* bytes = reinterpret_cast<std::uint8_t const*>(encoded.data());
+    EXPECT_EQ(json::from_cbor(bytes, encoded.size()), doc);
+}
+
+TEST(CborTest, RejectsMalformedInput) {
+    EXPECT_THROW(json::from_cbor(""), JsonParseError);
+    EXPECT_THROW(json::from_cbor(hex("1c")), JsonParseError);             // 保留的附加信息
+    EXPECT_THROW(json::from_cbor(hex("1903")), JsonParseError);           // 截断
+    EXPECT_THROW(json::from_cbor(hex("9bffffffffffffffff")), JsonParseError); // 长度超过剩余输入
+    EXPECT_THROW(json::from_cbor(hex("a10102")), JsonParseError);         // 非字符串键
+    EXPECT_THROW(json::from_cbor(hex("ff")), JsonParseError);             // 游离的 break
+    EXPECT_THROW(json::from_cbor(hex("0000")), JsonParseError);           // 多余的数据
+    EXPECT_THROW(json::from_cbor(hex("7f6161016162ff")), JsonParseError); // 不定长字符串中的非字符串块
+    EXPECT_THROW(json::from_cbor(std::string(MAX_NESTING_DEPTH + 1, '\x81') + hex("00")), JsonDepthLimitExceeded);
+}
+
+TEST(CborTest, EncodesUnsignedIntegersAndRawNodes) {
+    using unsigned_json = basic_json<std::map, std::vector, std::string, bool, std::uint64_t, double>;
+    EXPECT_EQ(unsigned_json(std::uint64_t(UINT64_MAX)).to_cbor(), hex("1bffffffffffffffff"));
+    EXPECT_EQ(unsigned_json(std::uint64_t(1) << 63).to_cbor(), hex("1b8000000000000000"));
+
+    // raw 节点的字符串被零拷贝输出引用, 必须在编码之后仍然有效
+    std::string const text = R"({"data": {"s": ")" + std::string(64, 'x') + R"("}})";
+    ParseOptions options;
+    options.raw_depth = 1;
+    auto const doc = json::parse(text, options);
+    details::ScatterGatherSerializeHandler sg(4);
+    doc.to_cbor(sg);
+    EXPECT_EQ(sg.str(), json::parse(text).to_cbor());
+}
+
+TEST(CborTest, RejectsNegativeIntegersForUnsignedNumberType) {
+    using unsigned_json = basic_json<std::map, std::vector, std::string, bool, std::uint64_t, double>;
+    EXPECT_EQ(unsigned_json::from_cbor(hex("1bffffffffffffffff")).as_int(), UINT64_MAX);
+    EXPECT_THROW(unsigned_json::from_cbor(hex("20")), JsonOutOfRange);                 // -1
+    EXPECT_THROW(unsigned_json::from_cbor(hex("3bffffffffffffffff")), JsonOutOfRange); // -2^64
+    EXPECT_THROW(unsigned_json::from_cbor(hex("820120")), JsonOutOfRange);             // [1, -1]
+    EXPECT_THROW(unsigned_json::from_cbor(hex("d84a48fffffffffffffffe")), JsonOutOfRange); // sint32 [-1, -2]
+    EXPECT_EQ(unsigned_json::from_cbor(hex("d84a480000000100000002")), unsigned_json::parse("[1,2]"));
+}
+
+TEST(CborTest, MapsUnassignedSimpleValuesToNull) {
+    // RFC 8949 §6.1: false/true/null 以外的简单值转换为 null
+    EXPECT_TRUE(json::from_cbor(hex("e0")).is_null());   // simple(0)
+    EXPECT_TRUE(json::from_cbor(hex("f3")).is_null());   // simple(19)
+    EXPECT_TRUE(json::from_cbor(hex("f820")).is_null()); // simple(32)
+    EXPECT_TRUE(json::from_cbor(hex("f8ff")).is_null()); // simple(255)
+    EXPECT_EQ(json::from_cbor(hex("83f0f4f5")), json::parse("[null,false,true]"));
+
+    EXPECT_THROW(json::from_cbor(hex("f814")), JsonParseError); // 小于 32 的值不能用两字节编码
+    EXPECT_THROW(json::from_cbor(hex("f8")), JsonParseError);   // 截断
+    EXPECT_THROW(json::from_cbor(hex("fc")), JsonParseError);   // 保留的附加信息 28
+}
+
+TEST(CborTest, BoundsReservationForUnsizedInput) {
+    // istream 的长度未知, 声明的长度不能直接用于分配; 应在读到输入末尾时报错
+    std::istringstream huge(hex("9b 00000fffffffffff 00"));
+    EXPECT_THROW(json::from_cbor(huge), JsonParseError);
+    std::istringstream big(hex("9a 10000000 01 02"));
+    EXPECT_THROW(json::from_cbor(big), JsonParseError);
+}
+
+TEST(MsgpackTest, EncodesSmallestFormat) {
+    EXPECT_EQ(json(0).to_msgpack(), hex("00"));
+    EXPECT_EQ(json(127).to_msgpack(), hex("7f"));
+    EXPECT_EQ(json(128).to_msgpack(), hex("cc80"));
+    EXPECT_EQ(json(65535).to_msgpack(), hex("cdffff"));
+    EXPECT_EQ(json(65536).to_msgpack(), hex("ce00010000"));
+    EXPECT_EQ(json(4294967296).to_msgpack(), hex("cf0000000100000000"));
+    EXPECT_EQ(json(-1).to_msgpack(), hex("ff"));
+    EXPECT_EQ(json(-32).to_msgpack(), hex("e0"));
+    EXPECT_EQ(json(-33).to_msgpack(), hex("d0df"));
+    EXPECT_EQ(json(-129).to_msgpack(), hex("d1ff7f"));
+    EXPECT_EQ(json(-2147483649).to_msgpack(), hex("d3ffffffff7fffffff"));
+    EXPECT_EQ(json(1.5).to_msgpack(), hex("ca3fc00000"));
+    EXPECT_EQ(json(1.1).to_msgpack(), hex("cb3ff199999999999a"));
+    EXPECT_EQ(json(null).to_msgpack(), hex("c0"));
+    EXPECT_EQ(json(true).to_msgpack(), hex("c3"));
+    EXPECT_EQ(json("abc").to_msgpack(), hex("a3616263"));
+    EXPECT_EQ(json(std::string(32, 'x')).to_msgpack(), hex("d920") + std::string(32, 'x'));
+    EXPECT_EQ(json::parse(R"({"a":[1,2]})").to_msgpack(), hex("81a16192 0102"));
+
+    json big = json::array{};
+    for (int i = 0; i < 16; ++i)
+        big.push_back(i);
+    EXPECT_EQ(big.to_msgpack().substr(0, 3), hex("dc0010"));
+}
+
+TEST(MsgpackTest, DecodesAllFormats) {
+    EXPECT_EQ(json::from_msgpack(hex("cfffffffffffffffff")).as_float(), 18446744073709551615.0);
+    EXPECT_EQ(json::from_msgpack(hex("d3 8000000000000000")).as_int(), INT64_MIN);
+    EXPECT_EQ(json::from_msgpack(hex("d1ff7f")).as_int(), -129);
+    EXPECT_EQ(json::from_msgpack(hex("c40301ff02")).as_string(), "Af8C");
+    EXPECT_EQ(json::from_msgpack(hex("da0003616263")).as_string(), "abc");
+    EXPECT_EQ(json::from_msgpack(hex("de0001a16190")), json::parse(R"({"a":[]})"));
+    EXPECT_EQ(json::from_msgpack(hex("dd00000002c2c3")), json::parse("[false,true]"));
+
+    EXPECT_THROW(json::from_msgpack(hex("c1")), JsonParseError);
+    EXPECT_THROW(json::from_msgpack(hex("d40100")), JsonParseError);  // fixext
+    EXPECT_THROW(json::from_msgpack(hex("8101c0")), JsonParseError);  // 非字符串键
+    EXPECT_THROW(json::from_msgpack(hex("ddffffffff")), JsonParseError);
+    EXPECT_THROW(json::from_msgpack(hex("cd01")), JsonParseError);
+    EXPECT_THROW(json::from_msgpack(hex("0000")), JsonParseError);
+}
+
+TEST(MsgpackTest, RoundTripAndConfiguredNumberTypes) {
+    auto doc = json::parse(R"({"id":-9223372036854775808,"max":9223372036854775807,"ratio":0.1,
+        "names":["a","","é"],"nested":{"ok":true,"none":null,"list":[[],{}]}})");
+    std::string const packed = doc.to_msgpack();
+    EXPECT_EQ(json::from_msgpack(packed), doc);
+    std::istringstream is(packed);
+    EXPECT_EQ(json::from_msgpack(is), doc);
+
+    using small_json = basic_json<std::map, std::vector, std::string, bool, std::int32_t, float>;
+    small_json small = small_json::array{small_json(std::int32_t(-70000)), small_json(0.5f)};
+    EXPECT_EQ(small.to_msgpack(), hex("92d2fffeee90ca3f000000"));
+    auto decoded = small_json::from_msgpack(hex("93 d2fffeee90 cb3fb999999999999a cf0000000100000000"));
+    EXPECT_EQ(decoded[0].as_int(), -70000);
+    EXPECT_FLOAT_EQ(decoded[1].as_float(), 0.1f);
+    EXPECT_TRUE(decoded[2].is_float()); // 超出 int32 范围
+}
+
+TEST(MsgpackTest, EncodesRawNodesAndBoundsReservation) {
+    // raw 节点的字符串被零拷贝输出引用, 必须在编码之后仍然有效
+    std::string const text = R"({"data": {"s": ")" + std::string(64, 'x') + R"("}})";
+    ParseOptions options;
+    options.raw_depth = 1;
+    auto const doc = json::parse(text, options);
+    details::ScatterGatherSerializeHandler sg(4);
+    doc.to_msgpack(sg);
+    EXPECT_EQ(sg.str(), json::parse(text).to_msgpack());
+
+    // istream 的长度未知, 声明的长度不能直接用于分配
+    std::istringstream huge(hex("dd ffffffff 01"));
+    EXPECT_THROW(json::from_msgpack(huge), JsonParseError);
+}
+
+TEST(MsgpackTest, ReadsConcatenatedMessages) {
+    std::string stream_data = json(1).to_msgpack() + json::parse(R"({"k":"v"})").to_msgpack() + json("end").to_msgpack();
+    details::StringViewStream svs(stream_data);
+    msgpack_reader reader(svs);
+
+    std::vector<json> messages;
+    while (reader.has_next())
+        messages.push_back(reader.next());
+    ASSERT_EQ(messages.size(), 3u);
+    EXPECT_EQ(messages[1]["k"].as_string(), "v");
+    EXPECT_EQ(messages[2].as_string(), "end");
+
+    std::string truncated = json(1).to_msgpack() + hex("92 01");
+    std::istringstream is(truncated);
+    details::IStreamStream iss(is);
+    msgpack_reader<details::IStreamStream> partial(iss);
+    EXPECT_EQ(partial.next().as_int(), 1);
+    EXPECT_THROW(partial.next(), JsonParseError);
+}
+
+TEST(SnapshotTest, ReadsValuesWithoutDeserializing) {
+    auto doc = json::parse(R"({"name":"ref","version":3,"ratio":0.5,"ok":true,"none":null,
+        "items":[{"id":1,"tag":"a"},{"id":2,"tag":"a"}],"zeta":[],"alpha":{}})");
+    std::string const bytes = doc.to_snapshot();
+    snapshot_view view(bytes);
+
+    EXPECT_EQ(view.type(), Type::object);
+    EXPECT_EQ(view.size(), 8u);
+    EXPECT_EQ(view["name"].as_string(), "ref");
+    EXPECT_EQ(view.at("version").as_int(), 3);
+    EXPECT_EQ(view["ratio"].as_float(), 0.5);
+    EXPECT_TRUE(view["ok"].as_bool());
+    EXPECT_TRUE(view["none"].is_null());
+    EXPECT_EQ(view["items"][1]["id"].as_int(), 2);
+    EXPECT_TRUE(view.contains("alpha"));
+    EXPECT_FALSE(view.contains("beta"));
+    EXPECT_FALSE(view["items"].contains("id"));
+
+    EXPECT_THROW(view.at("missing"), JsonOutOfRange);
+    EXPECT_THROW(view["items"].at(2), JsonOutOfRange);
+    EXPECT_THROW(view["name"].as_int(), JsonTypeError);
+
+    // 对象按键的顺序迭代
+    std::vector<std::string> keys;
+    for (auto it = view.begin(); it != view.end(); ++it)
+        keys.emplace_back(it.key());
+    EXPECT_EQ(keys, (std::vector<std::string>{"alpha", "items", "name", "none", "ok", "ratio", "version", "zeta"}));
+    std::int64_t sum = 0;
+    for (auto item : view["items"])
+        sum += item["id"].as_int();
+    EXPECT_EQ(sum, 3);
+
+    EXPECT_EQ(view.to_json(), doc);
+    EXPECT_EQ(view["items"].to_json<unordered_json>(), unordered_json::parse(R"([{"id":1,"tag":"a"},{"id":2,"tag":"a"}])"));
+
+    // 字符串池: 重复的键与值只存一次
+    auto const count = [](std::string const& haystack, std::string const& needle)
+    {
+        std::size_t n = 0;
+        for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1))
+            ++n;
+        return n;
+    };
+    EXPECT_EQ(count(bytes, "tag"), 1u);
+    EXPECT_EQ(count(json::parse(R"(["same","same",{"same":"same"}])").to_snapshot(), "same"), 1u);
+}
+
+TEST(SnapshotTest, MapsFileAndRejectsBadInput) {
+    auto doc = unordered_json::parse(R"({"b":[1,2.5,"x"],"a":{"nested":[[]]}})");
+    std::string const path = testing::TempDir() + "jsonpp_snapshot_test.bin";
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::string const bytes = doc.to_snapshot();
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+
+    snapshot_view view = snapshot_view::open(path);
+    snapshot_view moved = std::move(view);
+    EXPECT_EQ(moved["b"][2].as_string(), "x");
+    EXPECT_EQ(moved["a"]["nested"][0].size(), 0u);
+    EXPECT_EQ(moved.to_json<unordered_json>(), doc);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(snapshot_view::open(path), JsonSnapshotError);
+    EXPECT_THROW(snapshot_view(std::string_view("not a snapshot at all, just some text")), JsonSnapshotError);
+
+    std::string bytes = json::parse(R"({"k":"v"})").to_snapshot();
+    EXPECT_THROW(snapshot_view(std::string_view(bytes).substr(0, bytes.size() - 8)), JsonSnapshotError);
+    bytes[32] = '\x7f'; // 根对象的偏移量指向快照之外
+    snapshot_view corrupt{std::string_view(bytes)};
+    EXPECT_THROW(corrupt.size(), JsonSnapshotError);
+}
+
+TEST(SnapshotTest, RejectsCyclicAndOutOfRangeOffsets) {
+    // "[1]": 头部 40 字节, 根槽位于 24, 数组记录位于 40 (数量), 其元素槽位于 48
+    std::string const valid = json::parse("[1]").to_snapshot();
+    auto const patch_slot = [&](std::size_t slot, Type type, std::uint64_t payload)
+    {
+        std::string bytes = valid;
+        bytes[slot] = static_cast<char>(type);
+        std::memcpy(&bytes[slot + 8], &payload, sizeof(payload));
+        return bytes;
+    };
+    ASSERT_EQ(snapshot_view(std::string_view(valid)).to_json(), json::parse("[1]"));
+
+    // 元素槽指回数组自身
+    std::string const cyclic = patch_slot(48, Type::array, 40);
+    snapshot_view view{std::string_view(cyclic)};
+    EXPECT_EQ(view.size(), 1u);
+    EXPECT_THROW(view.to_json(), JsonSnapshotError);
+    EXPECT_THROW(view.at(0), JsonSnapshotError);
+    EXPECT_THROW(*view.begin(), JsonSnapshotError);
+    EXPECT_THROW(snapshot_view(std::string_view(patch_slot(48, Type::object, 48))).to_json(), JsonSnapshotError);
+
+    // 根槽指向头部
+    EXPECT_THROW(snapshot_view(std::string_view(patch_slot(24, Type::array, 0))), JsonSnapshotError);
+
+    // 指向快照之外
+    std::string const outside = patch_slot(48, Type::array, std::uint64_t(1) << 40);
+    EXPECT_THROW(snapshot_view(std::string_view(outside)).to_json(), JsonSnapshotError);
+    EXPECT_THROW(snapshot_view(std::string_view(patch_slot(48, Type::string, UINT64_MAX - 4))).to_json(), JsonSnapshotError);
+    EXPECT_THROW(snapshot_view(std::string_view(patch_slot(48, static_cast<Type>(0x40), 0))).to_json(), JsonSnapshotError);
+
+    // 嵌套过深的快照在 to_json() 中被拒绝, 而不是耗尽栈
+    json deep = json::array{};
+    for (int i = 0; i < MAX_NESTING_DEPTH; ++i)
+        deep = json::array{std::move(deep)};
+    std::string const deep_bytes = deep.to_snapshot();
+    EXPECT_THROW(snapshot_view(std::string_view(deep_bytes)).to_json(), JsonSnapshotError);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    char const* const ROWS = R"([
+        {"id": 1, "price": 9.5, "ok": true, "name": "apple", "extra": {"x": [1, 2]}},
+        {"id": 2, "price": 3, "ok": false, "name": null},
+        {"name": "chérry", "id": 3.0, "price": null},
+        {"id": null, "ok": true, "name": "", "price": -1e2}
+    ])";
+
+    std::vector<column_spec> const FIELDS = {
+        {"id", column_type::int64},
+        {"price", column_type::float64},
+        {"ok", column_type::boolean},
+        {"name", column_type::string},
+    };
+
+    void expect_rows(json_columns const& t)
+    {
+        ASSERT_EQ(t.rows, 4u);
+        ASSERT_EQ(t.columns.size(), 4u);
+
+        auto const& id = t["id"];
+        EXPECT_EQ(id.length, 4u);
+        EXPECT_EQ(id.null_count, 1u);
+        EXPECT_EQ(id.int64_values, (std::vector<std::int64_t>{1, 2, 3, 0}));
+        EXPECT_EQ(id.validity, (std::vector<std::uint8_t>{0b0111}));
+
+        auto const& price = t["price"];
+        EXPECT_EQ(price.null_count, 1u);
+        EXPECT_EQ(price.float64_values, (std::vector<double>{9.5, 3, 0, -100}));
+        EXPECT_FALSE(price.is_valid(2));
+
+        auto const& ok = t["ok"];
+        EXPECT_EQ(ok.null_count, 1u); // 第三行缺失
+        EXPECT_EQ(ok.validity, (std::vector<std::uint8_t>{0b1011}));
+        EXPECT_EQ(ok.boolean_values, (std::vector<std::uint8_t>{0b1001}));
+        EXPECT_TRUE(ok.boolean_at(0));
+        EXPECT_FALSE(ok.boolean_at(1));
+
+        auto const& name = t["name"];
+        EXPECT_EQ(name.null_count, 1u);
+        EXPECT_EQ(name.offsets, (std::vector<std::int64_t>{0, 5, 5, 12, 12}));
+        EXPECT_EQ(name.string_at(0), "apple");
+        EXPECT_EQ(name.string_at(2), "ch\xc3\xa9rry");
+        EXPECT_TRUE(name.is_valid(3));
+        EXPECT_EQ(name.string_at(3), "");
+    }
+}
+
+TEST(ColumnsTest, FromDom)
+{
+    expect_rows(to_columns(json::parse(ROWS), FIELDS));
+}
+
+TEST(ColumnsTest, FromRawDom)
+{
+    ParseOptions options;
+    options.raw_depth = 1; // 每一行都保留为 raw 片段
+    auto const rows = json::parse(ROWS, options);
+    ASSERT_TRUE(rows.as_array()[0].is_raw());
+    expect_rows(to_columns(rows, FIELDS));
+}
+
+TEST(ColumnsTest, FromStream)
+{
+    expect_rows(parse_columns(ROWS, FIELDS));
+    std::istringstream iss(ROWS);
+    expect_rows(parse_columns(iss, FIELDS));
+}
+
+TEST(ColumnsTest, BitmapSpansBytes)
+{
+    std::string doc = "[";
+    for (int i = 0; i < 10; ++i)
+        doc += (i ? "," : "") + (i % 3 == 0 ? std::string("{}") : "{\"v\":" + std::to_string(i) + "}");
+    doc += "]";
+    for (auto const& t : {parse_columns(doc, {{"v", column_type::int64}}), to_columns(json::parse(doc), {{"v", column_type::int64}})})
+    {
+        auto const& v = t["v"];
+        EXPECT_EQ(v.length, 10u);
+        EXPECT_EQ(v.null_count, 4u);
+        EXPECT_EQ(v.validity, (std::vector<std::uint8_t>{0b10110110, 0b01}));
+    }
+}
+
+TEST(ColumnsTest, EmptyAndUnknownFields)
+{
+    auto const t = parse_columns(" [ ] ", FIELDS);
+    EXPECT_EQ(t.rows, 0u);
+    EXPECT_EQ(t["name"].offsets, (std::vector<std::int64_t>{0}));
+    EXPECT_THROW(t["missing"], JsonOutOfRange);
+}
+
+TEST(ColumnsTest, DuplicateKeysKeepLastValue)
+{
+    // 与 DOM 解析器一致: 重复的键以最后一个值为准, 包括 null 与值互相覆盖及跨越位图字节边界的行
+    std::string doc = "[";
+    for (int i = 0; i < 10; ++i)
+        doc += std::string(i ? "," : "") + R"({"id": 1, "ok": null, "name": "first", "price": 1.5, "id": )"
+            + (i % 2 ? "null" : std::to_string(i)) + R"(, "ok": )" + (i % 3 ? "true" : "false")
+            + R"(, "name": )" + (i % 4 ? "\"last\"" : "null") + R"(, "price": 2})";
+    doc += "]";
+
+    auto const fused = parse_columns(doc, FIELDS);
+    auto const dom = to_columns(json::parse(doc), FIELDS);
+    ASSERT_EQ(fused.rows, dom.rows);
+    for (auto const& field : FIELDS)
+    {
+        auto const& a = fused[field.name];
+        auto const& b = dom[field.name];
+        EXPECT_EQ(a.length, b.length) << field.name;
+        EXPECT_EQ(a.null_count, b.null_count) << field.name;
+        EXPECT_EQ(a.validity, b.validity) << field.name;
+        EXPECT_EQ(a.int64_values, b.int64_values) << field.name;
+        EXPECT_EQ(a.float64_values, b.float64_values) << field.name;
+        EXPECT_EQ(a.boolean_values, b.boolean_values) << field.name;
+        EXPECT_EQ(a.offsets, b.offsets) << field.name;
+        EXPECT_EQ(a.data, b.data) << field.name;
+    }
+    EXPECT_EQ(fused["id"].int64_values, (std::vector<std::int64_t>{0, 0, 2, 0, 4, 0, 6, 0, 8, 0}));
+    EXPECT_EQ(fused["id"].null_count, 5u);
+    EXPECT_EQ(fused["name"].data, "lastlastlastlastlastlastlast");
+    EXPECT_EQ(fused["price"].float64_values, std::vector<double>(10, 2.0));
+}
+
+TEST(ColumnsTest, Errors)
+{
+    EXPECT_THROW(to_columns(json::parse("{}"), FIELDS), JsonTypeError);
+    EXPECT_THROW(to_columns(json::parse("[1]"), FIELDS), JsonTypeError);
+    EXPECT_THROW(to_columns(json::parse(R"([{"id": 1.5}])"), FIELDS), JsonTypeError);
+    EXPECT_THROW(to_columns(json::parse(R"([{"ok": 1}])"), FIELDS), JsonTypeError);
+    EXPECT_THROW(to_columns(json::parse("[]"), {{"a", column_type::int64}, {"a", column_type::string}}), JsonException);
+
+    EXPECT_THROW(parse_columns("{}", FIELDS), JsonTypeError);
+    EXPECT_THROW(parse_columns("[1]", FIELDS), JsonTypeError);
+    EXPECT_THROW(parse_columns(R"([{"name": 1}])", FIELDS), JsonTypeError);
+    EXPECT_THROW(parse_columns(R"([{"id": 1.5}])", FIELDS), JsonTypeError);
+    EXPECT_THROW(parse_columns(R"([{"id": 1}] x)", FIELDS), JsonParseError);
+    EXPECT_THROW(parse_columns(R"([{"id": 1})", FIELDS), JsonParseError);
+    EXPECT_THROW(parse_columns(R"([{id: 1}])", FIELDS), JsonParseError);
+}
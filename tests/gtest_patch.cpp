@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    json apply_patch(std::string const& doc, std::string const& ops)
+    {
+        auto j = json::parse(doc);
+        j.patch(json::parse(ops));
+        return j;
+    }
+
+    // diff(a, b) applied to a must yield b
+    void expect_roundtrip(json const& source, json const& target)
+    {
+        auto const ops = json::diff(source, target);
+        json patched = source;
+        patched.patch(ops);
+        EXPECT_EQ(patched, target) << "patch: " << ops.stringify();
+    }
+}
+
+// RFC 6902 Appendix A
+TEST(JsonPatchTest, RfcExamples) {
+    EXPECT_EQ(apply_patch(R"({"foo":"bar"})", R"([{"op":"add","path":"/baz","value":"qux"}])"),
+              json::parse(R"({"baz":"qux","foo":"bar"})"));
+    EXPECT_EQ(apply_patch(R"({"foo":["bar","baz"]})", R"([{"op":"add","path":"/foo/1","value":"qux"}])"),
+              json::parse(R"({"foo":["bar","qux","baz"]})"));
+    EXPECT_EQ(apply_patch(R"({"baz":"qux","foo":"bar"})", R"([{"op":"remove","path":"/baz"}])"),
+              json::parse(R"({"foo":"bar"})"));
+    EXPECT_EQ(apply_patch(R"({"foo":["bar","qux","baz"]})", R"([{"op":"remove","path":"/foo/1"}])"),
+              json::parse(R"({"foo":["bar","baz"]})"));
+    EXPECT_EQ(apply_patch(R"({"baz":"qux","foo":"bar"})", R"([{"op":"replace","path":"/baz","value":"boo"}])"),
+              json::parse(R"({"baz":"boo","foo":"bar"})"));
+    EXPECT_EQ(apply_patch(R"({"foo":{"bar":"baz","waldo":"fred"},"qux":{"corge":"grault"}})",
+                          R"([{"op":"move","from":"/foo/waldo","path":"/qux/thud"}])"),
+              json::parse(R"({"foo":{"bar":"baz"},"qux":{"corge":"grault","thud":"fred"}})"));
+    EXPECT_EQ(apply_patch(R"({"foo":["all","grass","cows","eat"]})", R"([{"op":"move","from":"/foo/1","path":"/foo/3"}])"),
+              json::parse(R"({"foo":["all","cows","eat","grass"]})"));
+    EXPECT_EQ(apply_patch(R"({"foo":["bar"]})", R"([{"op":"add","path":"/foo/-","value":["abc","def"]}])"),
+              json::parse(R"({"foo":["bar",["abc","def"]]})"));
+    EXPECT_EQ(apply_patch(R"({"/":9,"~1":10})", R"([{"op":"test","path":"/~01","value":10}])"),
+              json::parse(R"({"/":9,"~1":10})"));
+    EXPECT_EQ(apply_patch(R"({"a":1})", R"([{"op":"copy","from":"/a","path":"/b"},{"op":"add","path":"","value":[1]}])"),
+              json::parse("[1]"));
+
+    EXPECT_THROW(apply_patch(R"({"baz":"qux"})", R"([{"op":"test","path":"/baz","value":"bar"}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({"foo":"bar"})", R"([{"op":"add","path":"/baz/bat","value":"qux"}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({"foo":[1]})", R"([{"op":"add","path":"/foo/2","value":0}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({"foo":[1]})", R"([{"op":"remove","path":"/foo/01"}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({"a":{"b":1}})", R"([{"op":"move","from":"/a","path":"/a/b/c"}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({})", R"([{"op":"frobnicate","path":""}])"), JsonPatchError);
+    EXPECT_THROW(apply_patch(R"({})", R"([{"op":"add","value":1}])"), JsonPatchError);
+}
+
+TEST(JsonPatchTest, FailureRollsBack) {
+    auto const original = json::parse(R"({"list":[1,2,3],"obj":{"a":"x","b":"y"},"n":1})");
+    auto doc = original;
+    auto const ops = json::parse(R"([
+        {"op":"remove","path":"/list/0"},
+        {"op":"add","path":"/list/-","value":4},
+        {"op":"move","from":"/obj/a","path":"/list/0"},
+        {"op":"replace","path":"/n","value":"changed"},
+        {"op":"add","path":"/obj/b","value":"overwritten"},
+        {"op":"copy","from":"/obj","path":"/copy"},
+        {"op":"move","from":"/list","path":""},
+        {"op":"test","path":"/0","value":"no such value"}
+    ])");
+    EXPECT_THROW(doc.patch(ops), JsonPatchError);
+    EXPECT_EQ(doc, original);
+    EXPECT_EQ(doc.stringify(), original.stringify());
+}
+
+TEST(JsonPatchTest, RvalueOperationsAreMoved) {
+    auto doc = json::parse(R"({"items":[]})");
+    json ops = json::array{};
+    json op = json::object{};
+    op["op"] = "add";
+    op["path"] = "/items/-";
+    op["value"] = std::string(1000, 'x');
+    ops.push_back(std::move(op));
+    auto const* payload = ops[0]["value"].as_string().data();
+
+    doc.patch(std::move(ops));
+    EXPECT_EQ(doc["items"][0].as_string().data(), payload); // 字符串缓冲区被移动而非复制
+}
+
+TEST(JsonDiffTest, ObjectsAndScalars) {
+    auto const a = json::parse(R"({"keep":{"deep":[1,2,3]},"change":1,"drop":true,"a/b":{"~":0}})");
+    auto const b = json::parse(R"({"keep":{"deep":[1,2,3]},"change":2,"add":null,"a/b":{"~":1}})");
+    auto const ops = json::diff(a, b);
+    EXPECT_EQ(ops, json::parse(R"([
+        {"op":"replace","path":"/a~1b/~0","value":1},
+        {"op":"replace","path":"/change","value":2},
+        {"op":"remove","path":"/drop"},
+        {"op":"add","path":"/add","value":null}
+    ])"));
+    expect_roundtrip(a, b);
+
+    EXPECT_EQ(json::diff(a, a).size(), 0u);
+    EXPECT_EQ(json::diff(json(1), json("1")), json::parse(R"([{"op":"replace","path":"","value":"1"}])"));
+}
+
+TEST(JsonDiffTest, ArraysAreAligned) {
+    auto const a = json::parse(R"([{"id":1},{"id":2},{"id":3},{"id":4},{"id":5}])");
+    auto const b = json::parse(R"([{"id":1},{"id":3},{"id":4},{"id":"new"},{"id":5},{"id":6}])");
+    auto const ops = json::diff(a, b);
+    EXPECT_EQ(ops, json::parse(R"([
+        {"op":"remove","path":"/1"},
+        {"op":"add","path":"/3","value":{"id":"new"}},
+        {"op":"add","path":"/5","value":{"id":6}}
+    ])"));
+    expect_roundtrip(a, b);
+
+    // 被替换的元素递归比较
+    auto const c = json::parse(R"([[1,2,{"x":1}],"same"])");
+    auto const d = json::parse(R"([[1,2,{"x":2}],"same"])");
+    EXPECT_EQ(json::diff(c, d), json::parse(R"([{"op":"replace","path":"/0/2/x","value":2}])"));
+
+    expect_roundtrip(json::parse("[]"), json::parse("[1,2,3]"));
+    expect_roundtrip(json::parse("[1,2,3]"), json::parse("[]"));
+    expect_roundtrip(json::parse("[1,2,3,4]"), json::parse("[4,3,2,1]"));
+    expect_roundtrip(json::parse(R"({"a":[1,{"b":[2,3]}]})"), json::parse(R"({"a":[{"b":[3,2]},1,1]})"));
+}
+
+TEST(JsonDiffTest, LargeArrayLocalEdits) {
+    json a = json::array{};
+    for (int i = 0; i < 20000; ++i)
+    {
+        json item = json::object{};
+        item["id"] = i;
+        item["name"] = "item" + std::to_string(i);
+        a.push_back(std::move(item));
+    }
+    json b = a;
+    b.erase(size_t(1000));
+    b[5000]["name"] = "renamed";
+    b.insert(b.begin() + 15000, json("inserted"));
+
+    auto const ops = json::diff(a, b);
+    EXPECT_EQ(ops.size(), 3u);
+    json patched = a;
+    patched.patch(ops);
+    EXPECT_EQ(patched, b);
+
+    // 超过编辑距离上限时退化为按位置配对, 结果仍然正确
+    json c = json::array{}, d = json::array{};
+    for (int i = 0; i < 3000; ++i)
+    {
+        c.push_back(i);
+        d.push_back(-i - 1);
+    }
+    expect_roundtrip(c, d);
+}
+
+TEST(JsonUpdateTest, CopyAndMerge) {
+    auto base = json::parse(R"({"a":1,"nested":{"x":1,"y":2},"list":[1]})");
+    auto const overrides = json::parse(R"({"b":2,"nested":{"y":20,"z":30},"list":[2]})");
+
+    auto replaced = base;
+    replaced.update(overrides);
+    EXPECT_EQ(replaced, json::parse(R"({"a":1,"b":2,"nested":{"y":20,"z":30},"list":[2]})"));
+
+    auto merged = base;
+    merged.update(overrides, true);
+    EXPECT_EQ(merged, json::parse(R"({"a":1,"b":2,"nested":{"x":1,"y":20,"z":30},"list":[2]})"));
+
+    json empty;
+    empty.update(overrides);
+    EXPECT_EQ(empty, overrides);
+
+    json ranged = json::object{};
+    auto first = overrides.find("list");
+    ranged.update(first, std::next(first));
+    EXPECT_EQ(ranged, json::parse(R"({"list":[2]})"));
+
+    json number = 1;
+    EXPECT_THROW(number.update(overrides), JsonTypeError);
+    EXPECT_THROW(base.update(json::parse("[1]")), JsonTypeError);
+    EXPECT_THROW(ranged.update(json::parse("[1]").begin(), json::parse("[1]").end()), JsonTypeError);
+}
+
+TEST(JsonUpdateTest, RvalueStealsSubtrees) {
+    auto base = json::parse(R"({"keep":true,"nested":{"x":1}})");
+    auto layer = json::parse(R"({"nested":{"y":2},"big":"placeholder"})");
+    layer["big"] = std::string(1000, 'b');
+    auto const* payload = layer["big"].as_string().data();
+
+    base.update(std::move(layer), true);
+    EXPECT_EQ(base["big"].as_string().data(), payload);
+    EXPECT_EQ(base["nested"], json::parse(R"({"x":1,"y":2})"));
+    EXPECT_TRUE(base["keep"].as_bool());
+
+    auto unordered = unordered_json::parse(R"({"a":1})");
+    unordered.update(unordered_json::parse(R"({"a":2,"b":{"c":3}})"), true);
+    EXPECT_EQ(unordered, unordered_json::parse(R"({"a":2,"b":{"c":3}})"));
+}
+
+// RFC 7396 Appendix A
+TEST(JsonMergePatchTest, RfcExamples) {
+    struct Case { char const* target; char const* patch; char const* result; };
+    Case const cases[] = {
+        {R"({"a":"b"})", R"({"a":"c"})", R"({"a":"c"})"},
+        {R"({"a":"b"})", R"({"b":"c"})", R"({"a":"b","b":"c"})"},
+        {R"({"a":"b"})", R"({"a":null})", R"({})"},
+        {R"({"a":"b","b":"c"})", R"({"a":null})", R"({"b":"c"})"},
+        {R"({"a":["b"]})", R"({"a":"c"})", R"({"a":"c"})"},
+        {R"({"a":"c"})", R"({"a":["b"]})", R"({"a":["b"]})"},
+        {R"({"a":{"b":"c"}})", R"({"a":{"b":"d","c":null}})", R"({"a":{"b":"d"}})"},
+        {R"({"a":[{"b":"c"}]})", R"({"a":[1]})", R"({"a":[1]})"},
+        {R"(["a","b"])", R"(["c","d"])", R"(["c","d"])"},
+        {R"({"a":"b"})", R"(["c"])", R"(["c"])"},
+        {R"({"a":"foo"})", "null", "null"},
+        {R"({"a":"foo"})", R"("bar")", R"("bar")"},
+        {R"({"e":null})", R"({"a":1})", R"({"e":null,"a":1})"},
+        {R"([1,2])", R"({"a":"b","c":null})", R"({"a":"b"})"},
+        {R"({})", R"({"a":{"bb":{"ccc":null}}})", R"({"a":{"bb":{}}})"},
+    };
+    for (auto const& c : cases)
+    {
+        auto copied = json::parse(c.target);
+        auto const patch_doc = json::parse(c.patch);
+        copied.merge_patch(patch_doc);
+        EXPECT_EQ(copied, json::parse(c.result)) << c.target << " + " << c.patch;
+
+        auto moved = json::parse(c.target);
+        auto patch = json::parse(c.patch);
+        moved.merge_patch(std::move(patch));
+        EXPECT_EQ(moved, json::parse(c.result)) << c.target << " + " << c.patch;
+    }
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    json const& store()
+    {
+        static json const doc = json::parse(R"({"store":{
+            "book":[
+                {"category":"reference","author":"Nigel Rees","title":"Sayings of the Century","price":8.95},
+                {"category":"fiction","author":"Evelyn Waugh","title":"Sword of Honour","price":12.99},
+                {"category":"fiction","author":"Herman Melville","title":"Moby Dick","isbn":"0-553-21311-3","price":8.99},
+                {"category":"fiction","author":"J. R. R. Tolkien","title":"The Lord of the Rings","isbn":"0-395-19395-8","price":22.99}
+            ],
+            "bicycle":{"color":"red","price":399}}})");
+        return doc;
+    }
+
+    // 结果序列化为数组, 便于比较
+    json query(std::string const& path, json const& doc = store(), details::JsonPathOptions const& options = {})
+    {
+        json out = json::array{};
+        for (auto const* node : json_path(path).select(doc, options))
+            out.push_back(*node);
+        return out;
+    }
+
+    std::vector<std::string> paths(std::string const& path, json const& doc = store())
+    {
+        return json_path(path).select_paths(doc);
+    }
+}
+
+// RFC 9535 Table 2
+TEST(JsonPathTest, RfcBookstore) {
+    EXPECT_EQ(query("$.store.book[*].author"),
+              json::parse(R"(["Nigel Rees","Evelyn Waugh","Herman Melville","J. R. R. Tolkien"])"));
+    EXPECT_EQ(query("$..author").size(), 4u);
+    EXPECT_EQ(query("$.store..price").size(), 5u);
+    EXPECT_EQ(query("$..book[2].title"), json::parse(R"(["Moby Dick"])"));
+    EXPECT_EQ(query("$..book[-1].title"), json::parse(R"(["The Lord of the Rings"])"));
+    EXPECT_EQ(query("$..book[0,1].title"), json::parse(R"(["Sayings of the Century","Sword of Honour"])"));
+    EXPECT_EQ(query("$..book[:2].title"), json::parse(R"(["Sayings of the Century","Sword of Honour"])"));
+    EXPECT_EQ(query("$..book[?@.isbn].title"), json::parse(R"(["Moby Dick","The Lord of the Rings"])"));
+    EXPECT_EQ(query("$..book[?@.price<10].title"), json::parse(R"(["Sayings of the Century","Moby Dick"])"));
+    EXPECT_EQ(query("$..*").size(), 27u);
+}
+
+TEST(JsonPathTest, SlicesAndIndices) {
+    auto const arr = json::parse(R"(["a","b","c","d","e","f","g"])");
+    EXPECT_EQ(query("$[1:3]", arr), json::parse(R"(["b","c"])"));
+    EXPECT_EQ(query("$[5:]", arr), json::parse(R"(["f","g"])"));
+    EXPECT_EQ(query("$[1:5:2]", arr), json::parse(R"(["b","d"])"));
+    EXPECT_EQ(query("$[5:1:-2]", arr), json::parse(R"(["f","d"])"));
+    EXPECT_EQ(query("$[::-1]", arr), json::parse(R"(["g","f","e","d","c","b","a"])"));
+    EXPECT_EQ(query("$[1:3:0]", arr), json::array{});
+    EXPECT_EQ(query("$[-2]", arr), json::parse(R"(["f"])"));
+    EXPECT_EQ(query("$[7]", arr), json::array{});
+    EXPECT_EQ(query("$[0, 0]", arr), json::parse(R"(["a","a"])"));
+}
+
+TEST(JsonPathTest, FiltersAndFunctions) {
+    auto const doc = json::parse(R"([
+        {"a":"ab","n":1,"tags":[1,2]},
+        {"a":"b","n":2.0,"tags":[]},
+        {"a":"bab","n":null,"o":{"x":1}},
+        {"n":true,"o":{"x":1}}])");
+    EXPECT_EQ(query("$[?@.n == 2].a", doc), json::parse(R"(["b"])"));
+    EXPECT_EQ(query("$[?@.n == null].a", doc), json::parse(R"(["bab"])"));
+    EXPECT_EQ(query("$[?@.n > 0 && @.n < 2].a", doc), json::parse(R"(["ab"])"));
+    EXPECT_EQ(query("$[?!@.a].n", doc), json::parse("[true]"));
+    EXPECT_EQ(query("$[?@.o == $[3].o].n", doc), json::parse("[null,true]"));
+    EXPECT_EQ(query("$[?@.missing == @.other]", doc).size(), 4u);
+    EXPECT_EQ(query("$[?length(@.a) == 2].a", doc), json::parse(R"(["ab"])"));
+    EXPECT_EQ(query("$[?count(@.tags[*]) > 1].a", doc), json::parse(R"(["ab"])"));
+    EXPECT_EQ(query("$[?match(@.a, 'b.*')].a", doc), json::parse(R"(["b","bab"])"));
+    EXPECT_EQ(query("$[?search(@.a, 'a')].a", doc), json::parse(R"(["ab","bab"])"));
+    EXPECT_EQ(query("$[?value(@..x) == 1].a", doc), json::parse(R"(["bab"])"));
+    EXPECT_EQ(query("$[?(@.n == 1 || @.n == true)]", doc).size(), 2u);
+    EXPECT_EQ(query(R"($[?@.a == "b"].n)", doc), json::parse("[2.0]"));
+}
+
+TEST(JsonPathTest, InvalidQueriesThrow) {
+    for (char const* bad : {"", "store", "$.", "$[", "$[01]", "$[-0]", "$['a'", "$[?@.a ==]", "$[?1]",
+                            "$[?@.* == 1]", "$[?foo(@)]", "$[?length(@.*) == 1]", "$[?count(1) == 1]",
+                            "$[?match(@.a, 'x') == true]", "$ ", "$['\\q']"})
+        EXPECT_THROW(json_path{bad}, JsonPathError) << bad;
+}
+
+TEST(JsonPathTest, ParallelFilterKeepsOrder) {
+    json::array items;
+    for (int i = 0; i < 5000; ++i)
+        items.push_back(json::object{{"id", i}, {"even", i % 2 == 0}});
+    json const doc = items;
+
+    json_path const path("$[?@.even == true && @.id >= 100].id");
+    details::JsonPathOptions options;
+    options.threads = 4;
+    options.min_parallel_elements = 64;
+    auto const parallel = path.select(doc, options);
+    auto const sequential = path.select(doc);
+    ASSERT_EQ(parallel.size(), 2450u);
+    EXPECT_EQ(parallel, sequential);
+    EXPECT_EQ(parallel.front()->as_int(), 100);
+    EXPECT_TRUE(json_path("$[0].id").is_singular());
+    EXPECT_FALSE(path.is_singular());
+    EXPECT_EQ(path.select_first(doc)->as_int(), 100);
+}
+
+// RFC 9535 2.3.1.3 / 2.3.2.3 / 2.3.3.3
+TEST(JsonPathTest, RfcNameWildcardAndIndexExamples) {
+    auto const names = json::parse(R"({"o": {"j j": {"k.k": 3}}, "'": {"@": 2}})");
+    EXPECT_EQ(query("$.o['j j']", names), json::parse(R"([{"k.k": 3}])"));
+    EXPECT_EQ(query("$.o['j j']['k.k']", names), json::parse("[3]"));
+    EXPECT_EQ(query(R"($.o["j j"]["k.k"])", names), json::parse("[3]"));
+    EXPECT_EQ(query(R"($["'"]["@"])", names), json::parse("[2]"));
+
+    auto const wild = json::parse(R"({"o": {"j": 1, "k": 2}, "a": [5, 3]})");
+    EXPECT_EQ(query("$[*]", wild), json::parse(R"([[5, 3], {"j": 1, "k": 2}])")); // std::map: 成员按键排序
+    EXPECT_EQ(query("$.o[*]", wild), json::parse("[1, 2]"));
+    EXPECT_EQ(query("$.o[*, *]", wild), json::parse("[1, 2, 1, 2]"));
+    EXPECT_EQ(query("$.a[*]", wild), json::parse("[5, 3]"));
+
+    auto const arr = json::parse(R"(["a", "b"])");
+    EXPECT_EQ(query("$[1]", arr), json::parse(R"(["b"])"));
+    EXPECT_EQ(query("$[-2]", arr), json::parse(R"(["a"])"));
+}
+
+// RFC 9535 2.3.5.3
+TEST(JsonPathTest, RfcFilterExamples) {
+    auto const doc = json::parse(R"({"a": [3, 5, 1, 2, 4, 6, {"b": "j"}, {"b": "k"}, {"b": {}}, {"b": "kilo"}],
+        "o": {"p": 1, "q": 2, "r": 3, "s": 5, "t": {"u": 6}}, "e": "f"})");
+    EXPECT_EQ(query("$.a[?@.b == 'kilo']", doc), json::parse(R"([{"b": "kilo"}])"));
+    EXPECT_EQ(query("$.a[?(@.b == 'kilo')]", doc), json::parse(R"([{"b": "kilo"}])"));
+    EXPECT_EQ(query("$.a[?@>3.5]", doc), json::parse("[5, 4, 6]"));
+    EXPECT_EQ(query("$.a[?@.b]", doc), json::parse(R"([{"b": "j"}, {"b": "k"}, {"b": {}}, {"b": "kilo"}])"));
+    EXPECT_EQ(query("$[?@.*]", doc), (json::array{doc["a"], doc["o"]}));
+    EXPECT_EQ(query("$[?@[?@.b]]", doc), json::array{doc["a"]});
+    EXPECT_EQ(query("$.o[?@<3, ?@<3]", doc), json::parse("[1, 2, 1, 2]"));
+    EXPECT_EQ(query(R"($.a[?@<2 || @.b == "k"])", doc), json::parse(R"([1, {"b": "k"}])"));
+    EXPECT_EQ(query(R"($.a[?match(@.b, "[jk]")])", doc), json::parse(R"([{"b": "j"}, {"b": "k"}])"));
+    EXPECT_EQ(query(R"($.a[?search(@.b, "[jk]")])", doc), json::parse(R"([{"b": "j"}, {"b": "k"}, {"b": "kilo"}])"));
+    EXPECT_EQ(query("$.o[?@>1 && @<4]", doc), json::parse("[2, 3]"));
+    EXPECT_EQ(query("$.o[?@.u || @.x]", doc), json::parse(R"([{"u": 6}])"));
+    EXPECT_EQ(query("$.a[?@.b == $.x]", doc), json::parse("[3, 5, 1, 2, 4, 6]"));
+    EXPECT_EQ(query("$.a[?@ == @]", doc).size(), 10u);
+}
+
+// RFC 9535 2.5.2.3 / 2.6.1
+TEST(JsonPathTest, RfcDescendantAndNullExamples) {
+    auto const doc = json::parse(R"({"o": {"j": 1, "k": 2}, "a": [5, 3, [{"j": 4}, {"k": 6}]]})");
+    EXPECT_EQ(query("$..j", doc), json::parse("[4, 1]")); // 先序遍历, "a" 在 "o" 之前
+    EXPECT_EQ(query("$..[0]", doc), json::parse(R"([5, {"j": 4}])"));
+    EXPECT_EQ(query("$..[*]", doc).size(), 11u);
+    EXPECT_EQ(query("$..*", doc), query("$..[*]", doc));
+    EXPECT_EQ(query("$..o", doc), json::parse(R"([{"j": 1, "k": 2}])"));
+    EXPECT_EQ(query("$.o..[*, *]", doc), json::parse("[1, 2, 1, 2]"));
+    EXPECT_EQ(query("$.a..[0, 1]", doc), json::parse(R"([5, 3, {"j": 4}, {"k": 6}])"));
+
+    auto const nulls = json::parse(R"({"a": null, "b": [null], "c": [{}], "null": 1})");
+    EXPECT_EQ(query("$.a", nulls), json::parse("[null]"));
+    EXPECT_EQ(query("$.a[0]", nulls), json::array{});
+    EXPECT_EQ(query("$.a.d", nulls), json::array{});
+    EXPECT_EQ(query("$.b[0]", nulls), json::parse("[null]"));
+    EXPECT_EQ(query("$.b[*]", nulls), json::parse("[null]"));
+    EXPECT_EQ(query("$.b[?@]", nulls), json::parse("[null]"));
+    EXPECT_EQ(query("$.b[?@==null]", nulls), json::parse("[null]"));
+    EXPECT_EQ(query("$.c[?@.d==null]", nulls), json::array{});
+    EXPECT_EQ(query("$.null", nulls), json::parse("[1]"));
+}
+
+TEST(JsonPathTest, DescendantFiltersAndNegativeSlices) {
+    EXPECT_EQ(paths("$..[?@.price > 20]"), (std::vector<std::string>{"$['store']['bicycle']", "$['store']['book'][3]"}));
+    EXPECT_EQ(query("$..book[?@.price < 10 && @.isbn].title"), json::parse(R"(["Moby Dick"])"));
+    EXPECT_EQ(query("$..[?@.category == 'fiction'][?@ == 'Moby Dick']"), json::parse(R"(["Moby Dick"])"));
+
+    auto const arr = json::parse(R"(["a","b","c","d","e","f","g"])");
+    EXPECT_EQ(query("$[-1:-3:-1]", arr), json::parse(R"(["g","f"])"));
+    EXPECT_EQ(query("$[10:0:-3]", arr), json::parse(R"(["g","d"])"));
+    EXPECT_EQ(query("$[:-5:-1]", arr), json::parse(R"(["g","f","e","d"])"));
+    EXPECT_EQ(query("$[-10::-1]", arr), json::array{});
+    EXPECT_EQ(query("$[2::-1]", arr), json::parse(R"(["c","b","a"])"));
+    EXPECT_EQ(paths("$[::-3]", arr), (std::vector<std::string>{"$[6]", "$[3]", "$[0]"}));
+}
+
+TEST(JsonPathTest, LengthCountAndValueFunctions) {
+    auto const doc = json::parse(R"([
+        {"s": "é中", "a": [1, 2, 3], "o": {"x": 1}},
+        {"s": "abc", "a": [], "o": {"x": 1, "y": {"x": 2}}},
+        {"s": 5, "a": {"k": 1}}])");
+    EXPECT_EQ(query("$[?length(@.s) == 2].s", doc), json::parse(R"(["é中"])")); // 按码点计数
+    EXPECT_EQ(query("$[?length(@.a) == 1].s", doc), json::parse("[5]"));
+    EXPECT_EQ(query("$[?length(@.s) > 0].s", doc).size(), 2u); // 数字没有长度: 比较结果为假
+    EXPECT_EQ(query("$[?length(@.missing) == length(@.other)].s", doc).size(), 3u); // Nothing == Nothing
+    EXPECT_EQ(query("$[?count(@.a[*]) == 3].s", doc), json::parse(R"(["é中"])"));
+    EXPECT_EQ(query("$[?count(@..x) == 2].s", doc), json::parse(R"(["abc"])"));
+    EXPECT_EQ(query("$[?count(@.*) == 2].s", doc), json::parse("[5]"));
+    EXPECT_EQ(query("$[?value(@..x) == 1].s", doc), json::parse(R"(["é中"])")); // 选中多个节点时为 Nothing
+    EXPECT_EQ(query("$[?value(@.a.k) == 1].s", doc), json::parse("[5]"));
+}
+
+// RFC 9535 2.7 / Table 16
+TEST(JsonPathTest, NormalizedPaths) {
+    auto const doc = json::parse(R"({"a": {"b": [10, 11, 12]}, "\u000b": 1, "it's": 2, "back\\slash": 3, "tab\t": 4})");
+    EXPECT_EQ(paths("$.a", doc), std::vector<std::string>{"$['a']"});
+    EXPECT_EQ(paths("$.a.b[1]", doc), std::vector<std::string>{"$['a']['b'][1]"});
+    EXPECT_EQ(paths("$.a.b[-3]", doc), std::vector<std::string>{"$['a']['b'][0]"});
+    EXPECT_EQ(paths("$.a.b[1:2]", doc), std::vector<std::string>{"$['a']['b'][1]"});
+    EXPECT_EQ(paths(R"($["\u000B"])", doc), std::vector<std::string>{R"($['\u000b'])"});
+    EXPECT_EQ(paths(R"($["a"])", doc), std::vector<std::string>{"$['a']"});
+    EXPECT_EQ(paths("$[\"it's\"]", doc), std::vector<std::string>{R"($['it\'s'])"});
+    EXPECT_EQ(paths(R"($["back\\slash"])", doc), std::vector<std::string>{R"($['back\\slash'])"});
+    EXPECT_EQ(paths(R"($["tab\t"])", doc), std::vector<std::string>{R"($['tab\t'])"});
+    EXPECT_EQ(paths("$", doc), std::vector<std::string>{"$"});
+
+    // 与 select() 的节点一一对应, 包括重复节点
+    auto const book_paths = paths("$..book[?@.isbn].title");
+    EXPECT_EQ(book_paths, (std::vector<std::string>{"$['store']['book'][2]['title']", "$['store']['book'][3]['title']"}));
+    EXPECT_EQ(paths("$.store.book[0, 0].price").size(), 2u);
+    auto const all = json_path("$..*");
+    auto const nodes = all.select(store());
+    auto const all_paths = all.select_paths(store());
+    ASSERT_EQ(nodes.size(), all_paths.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+        EXPECT_EQ(json_path(all_paths[i]).select(store()), (std::vector<json const*>{nodes[i]})) << all_paths[i];
+}
+
+TEST(JsonPathTest, RegexFunctionsOnLongAndMultilineSubjects) {
+    json doc = json::array{};
+    doc.push_back(json::object{{"s", "a\nb"}, {"p", "a.b"}});
+    doc.push_back(json::object{{"s", "axb"}, {"p", "a.b"}});
+    doc.push_back(json::object{{"s", "a\rb"}, {"p", "a.b"}});
+    // I-Regexp 的 '.' 不匹配 \n 与 \r
+    EXPECT_EQ(query("$[?match(@.s, 'a.b')].s", doc), json::parse(R"(["axb"])"));
+    EXPECT_EQ(query("$[?match(@.s, @.p)].s", doc), json::parse(R"(["axb"])"));
+    EXPECT_EQ(query("$[?search(@.s, '^b')].s", doc).size(), 0u);
+
+    // 很长的主题字符串: 递归的匹配器会栈溢出
+    std::string const long_subject = std::string(200000, 'a') + "b";
+    json big = json::array{json::object{{"s", long_subject}, {"p", "a.*b"}}};
+    EXPECT_EQ(query("$[?match(@.s, 'a.*b')]", big).size(), 1u);
+    EXPECT_EQ(query("$[?match(@.s, '(a|b)*')]", big).size(), 1u);
+    EXPECT_EQ(query("$[?match(@.s, @.p)]", big).size(), 1u);
+    EXPECT_EQ(query("$[?search(@.s, 'ab')]", big).size(), 1u);
+    EXPECT_EQ(query("$[?match(@.s, 'a*c')]", big).size(), 0u);
+}
+
+TEST(JsonPathTest, RejectsExcessiveNesting) {
+    auto const nested = [](std::string const& open, std::string const& inner, std::string const& close, int depth)
+    {
+        std::string text = "$[?";
+        for (int i = 0; i < depth; ++i)
+            text += open;
+        text += inner;
+        for (int i = 0; i < depth; ++i)
+            text += close;
+        return text + "]";
+    };
+    // 与文档解析器相同的上限内可以正常编译与求值
+    EXPECT_EQ(query(nested("(", "@.price > 300", ")", 500), store()["store"]), json::parse(R"([{"color":"red","price":399}])"));
+    EXPECT_EQ(query(nested("!(", "@.price > 300", ")", 500), store()["store"]), json::parse(R"([{"color":"red","price":399}])"));
+
+    // 超出上限时抛出 JsonPathError, 而不是耗尽栈
+    EXPECT_THROW(json_path(nested("(", "@.a", ")", 10000)), JsonPathError);
+    EXPECT_THROW(json_path(nested("!(", "@.a", ")", 10000)), JsonPathError);
+    EXPECT_THROW(json_path(nested("@[?", "@.a", "]", 10000)), JsonPathError);
+    EXPECT_THROW(json_path(nested("length(", "@.a", ")", 10000)), JsonPathError);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    json_schema<> const& order_schema()
+    {
+        static json_schema<> const schema(json::parse(R"({
+            "$schema": "https://json-schema.org/draft/2020-12/schema",
+            "title": "order",
+            "type": "object",
+            "required": ["id", "items"],
+            "properties": {
+                "id": {"type": "integer", "minimum": 1},
+                "email": {"type": "string", "pattern": "^[^@]+@[^@]+$", "maxLength": 64},
+                "status": {"enum": ["new", "paid", 3]},
+                "note": true,
+                "items": {
+                    "type": "array", "minItems": 1, "maxItems": 3,
+                    "items": {
+                        "type": "object", "required": ["sku"],
+                        "properties": {"sku": {"type": "string", "minLength": 2}, "qty": {"type": "integer", "exclusiveMinimum": 0}},
+                        "additionalProperties": false
+                    }
+                }
+            }
+        })"));
+        return schema;
+    }
+
+    // 返回失败位置; 通过时为 "ok"
+    std::string dom_location(std::string const& doc)
+    {
+        try { order_schema().validate(json::parse(doc)); }
+        catch (JsonSchemaError const& e) { return e.instance_location(); }
+        return "ok";
+    }
+
+    std::string fused_location(std::string const& doc)
+    {
+        try { order_schema().parse(doc); }
+        catch (JsonSchemaError const& e) { return e.instance_location(); }
+        return "ok";
+    }
+}
+
+namespace
+{
+    struct KeywordCase
+    {
+        char const* instance;
+        char const* location; // 失败位置 (JSON Pointer); 通过时为 "ok"
+    };
+
+    // DOM 校验与融合解析对每个实例都必须给出相同的结果, 失败时还要给出相同的位置和消息
+    void expect_cases(char const* schema_text, std::vector<KeywordCase> const& cases, char const* message = nullptr)
+    {
+        json_schema<> const schema(json::parse(schema_text));
+        for (auto const& [instance, location] : cases)
+        {
+            std::string dom = "ok", fused = "ok", dom_what, fused_what;
+            try { schema.validate(json::parse(instance)); }
+            catch (JsonSchemaError const& e) { dom = e.instance_location(), dom_what = e.what(); }
+            try { EXPECT_EQ(schema.parse(instance), json::parse(instance)) << schema_text << " / " << instance; }
+            catch (JsonSchemaError const& e) { fused = e.instance_location(), fused_what = e.what(); }
+
+            EXPECT_EQ(dom, location) << schema_text << " / " << instance;
+            EXPECT_EQ(fused, location) << schema_text << " / " << instance;
+            EXPECT_EQ(schema.is_valid(json::parse(instance)), std::string(location) == "ok") << schema_text << " / " << instance;
+            if (message && dom != "ok")
+            {
+                EXPECT_NE(dom_what.find(message), std::string::npos) << dom_what;
+                EXPECT_NE(fused_what.find(message), std::string::npos) << fused_what;
+            }
+        }
+    }
+}
+
+TEST(JsonSchemaKeywordTest, Type) {
+    expect_cases(R"({"type": ["integer", "null"]})", {
+        {"1", "ok"}, {"1.0", "ok"}, {"-0", "ok"}, {"null", "ok"}, {"1.5", ""}, {"\"1\"", ""}, {"[]", ""}, {"true", ""},
+    }, "expected null or integer");
+    expect_cases(R"({"properties": {"a": {"type": "number"}, "b": {"type": "boolean"}}})", {
+        {R"({"a": 1, "b": false})", "ok"}, {R"({"a": 1e300})", "ok"}, {R"({"a": "1"})", "/a"}, {R"({"b": 0})", "/b"},
+    });
+}
+
+TEST(JsonSchemaKeywordTest, EnumAndConst) {
+    expect_cases(R"({"enum": ["a", 1, null, [1, 2], {"k": true}]})", {
+        {R"("a")", "ok"}, {"1", "ok"}, {"1.0", "ok"}, {"null", "ok"}, {"[1, 2]", "ok"}, {"[1.0, 2]", "ok"},
+        {R"({"k": true})", "ok"}, {R"("b")", ""}, {"[2, 1]", ""}, {R"({"k": false})", ""}, {"true", ""}, {"0", ""},
+    }, "enum");
+    expect_cases(R"({"properties": {"c": {"const": {"a": [1, "x"]}}, "n": {"const": null}}})", {
+        {R"({"c": {"a": [1, "x"]}})", "ok"}, {R"({"c": {"a": [1.0, "x"]}})", "ok"}, {"{}", "ok"},
+        {R"({"c": {"a": [1]}})", "/c"}, {R"({"c": {"a": [1, "x"], "b": 0}})", "/c"}, {R"({"n": false})", "/n"},
+    });
+}
+
+TEST(JsonSchemaKeywordTest, MinLengthAndMaxLength) {
+    expect_cases(R"({"minLength": 2, "maxLength": 3})", {
+        {R"("ab")", "ok"}, {R"("abc")", "ok"}, {R"("é中")", "ok"}, {R"("\u00e9\u4e2d\u00e9")", "ok"},
+        {"5", "ok"}, {"[1]", "ok"}, // 只约束字符串
+        {R"("a")", ""}, {R"("é")", ""}, {R"("abcd")", ""},
+    });
+    expect_cases(R"({"items": {"maxLength": 1}})", {
+        {R"(["a", "", "中"])", "ok"}, {R"(["a", "bc"])", "/1"},
+    }, "maxLength");
+}
+
+TEST(JsonSchemaKeywordTest, Pattern) {
+    expect_cases(R"({"pattern": "^[a-z]+-\\d{2}$"})", {
+        {R"("ab-12")", "ok"}, {R"("AB-12")", ""}, {R"("ab-123")", ""}, {R"("ab-1")", ""}, {"12", "ok"},
+    }, "pattern");
+    // 未锚定的模式在字符串中任意位置匹配即可 (ECMA-262 search 语义)
+    expect_cases(R"({"properties": {"s": {"pattern": "b+"}}})", {
+        {R"({"s": "abbc"})", "ok"}, {R"({"s": "b"})", "ok"}, {R"({"s": "xyz"})", "/s"}, {R"({"s": ""})", "/s"},
+    });
+}
+
+TEST(JsonSchemaKeywordTest, NumericBounds) {
+    expect_cases(R"({"minimum": 1.5, "exclusiveMaximum": 10})", {
+        {"1.5", "ok"}, {"2", "ok"}, {"9.99", "ok"}, {R"("x")", "ok"},
+        {"1", ""}, {"-3", ""}, {"10", ""}, {"10.0", ""}, {"1e10", ""},
+    });
+    expect_cases(R"({"maximum": 3, "exclusiveMinimum": -1})", {
+        {"3", "ok"}, {"3.0", "ok"}, {"-0.5", "ok"}, {"3.0001", ""}, {"-1", ""}, {"-1.0", ""},
+    });
+    expect_cases(R"({"items": {"exclusiveMaximum": 0}})", {{"[-1, -0.5]", "ok"}, {"[-1, 0]", "/1"}}, "exclusiveMaximum");
+    expect_cases(R"({"properties": {"n": {"minimum": 0}}})", {{R"({"n": -1})", "/n"}}, "minimum");
+}
+
+TEST(JsonSchemaKeywordTest, Required) {
+    expect_cases(R"({"required": ["a", "b~c", "d/e"], "properties": {"n": {"required": ["x"]}}})", {
+        {R"({"a": 1, "b~c": 2, "d/e": 3})", "ok"}, {R"({"a": 1, "b~c": 2, "d/e": 3, "n": {"x": null}})", "ok"},
+        {R"({"a": 1, "b~c": 2})", ""}, {R"({"b~c": 2, "d/e": 3})", ""}, {"[]", "ok"}, // 只约束对象
+        {R"({"a": 1, "b~c": 2, "d/e": 3, "n": {}})", "/n"},
+    }, "missing required property");
+    // 失败位置中的名称按 RFC 6901 转义
+    expect_cases(R"({"properties": {"a/b": {"properties": {"c~d": {"required": ["z"]}}}}})", {
+        {R"({"a/b": {"c~d": {"z": 0}}})", "ok"}, {R"({"a/b": {"c~d": {}}})", "/a~1b/c~0d"},
+    });
+}
+
+TEST(JsonSchemaKeywordTest, AdditionalProperties) {
+    expect_cases(R"({"properties": {"a": {}}, "additionalProperties": {"type": "integer"}})", {
+        {R"({"a": "x", "b": 1})", "ok"}, {R"({"a": "x"})", "ok"}, {R"({"a": "x", "b": "y"})", "/b"},
+        {R"({"b": 1, "c": 2.5})", "/c"},
+    });
+    expect_cases(R"({"properties": {"a": true}, "additionalProperties": false})", {
+        {R"({"a": [1, {"deep": 0}]})", "ok"}, {"{}", "ok"}, {R"({"a": 1, "z": 0})", "/z"}, {R"({"": 0})", "/"},
+    });
+    expect_cases(R"({"properties": {"o": {"additionalProperties": {"maxLength": 1}}}})", {
+        {R"({"o": {"k": "v"}})", "ok"}, {R"({"o": {"k": "vv"}})", "/o/k"},
+    });
+}
+
+TEST(JsonSchemaKeywordTest, ItemsAndArrayBounds) {
+    expect_cases(R"({"items": {"type": "integer", "minimum": 0}})", {
+        {"[]", "ok"}, {"[0, 1, 2]", "ok"}, {"[0, -1]", "/1"}, {R"([0, "x"])", "/1"}, {"{}", "ok"},
+    });
+    expect_cases(R"({"items": false})", {{"[]", "ok"}, {"[1]", "/0"}});
+    expect_cases(R"({"items": {"items": {"type": "string"}}})", {
+        {R"([["a"], []])", "ok"}, {R"([["a"], ["b", 1]])", "/1/1"}, {R"([["a"], 2])", "ok"},
+    });
+    expect_cases(R"({"minItems": 1, "maxItems": 2, "items": {"minItems": 1}})", {
+        {"[[1]]", "ok"}, {"[]", ""}, {"[[1], [2], [3]]", ""}, {"[[1], []]", "/1"},
+    });
+}
+
+TEST(JsonSchemaTest, ValidatesDomAndFusedParseAlike) {
+    std::vector<std::pair<char const*, char const*>> const cases = {
+        {R"({"id":1,"items":[{"sku":"ab","qty":2}],"note":[1,{}],"status":"paid"})", "ok"},
+        {R"({"id":2.0,"items":[{"sku":"ab"}],"status":3.0,"email":"a@b"})", "ok"},
+        {R"({"id":0,"items":[{"sku":"ab"}]})", "/id"},
+        {R"({"id":1.5,"items":[{"sku":"ab"}]})", "/id"},
+        {R"({"id":1})", ""},
+        {R"({"id":1,"items":[]})", "/items"},
+        {R"({"id":1,"items":[{"sku":"ab"},{"sku":"x"}]})", "/items/1/sku"},
+        {R"({"id":1,"items":[{"sku":"ab","qty":0}]})", "/items/0/qty"},
+        {R"({"id":1,"items":[{"sku":"ab","extra":1}]})", "/items/0/extra"},
+        {R"({"id":1,"items":[{"sku":"ab"}],"email":"nope"})", "/email"},
+        {R"({"id":1,"items":[{"sku":"ab"}],"status":"lost"})", "/status"},
+        {R"({"id":1,"items":[{"sku":"ab"},{"sku":"ab"},{"sku":"ab"},{"sku":"ab"}]})", "/items"},
+        {R"([1])", ""},
+    };
+    for (auto const& [doc, location] : cases)
+    {
+        EXPECT_EQ(dom_location(doc), location) << doc;
+        EXPECT_EQ(fused_location(doc), location) << doc;
+        EXPECT_EQ(order_schema().is_valid(json::parse(doc)), std::string(location) == "ok") << doc;
+    }
+}
+
+TEST(JsonSchemaTest, FusedParseStopsAtFirstViolation) {
+    // 违规之后的语法错误不会被读到
+    try
+    {
+        order_schema().parse(R"({"id":"x", this is not json)");
+        FAIL() << "expected a schema violation";
+    }
+    catch (JsonSchemaError const& e)
+    {
+        EXPECT_EQ(e.instance_location(), "/id");
+        EXPECT_NE(std::string(e.what()).find("position 6"), std::string::npos) << e.what();
+    }
+    EXPECT_THROW(order_schema().parse(R"({"id":1,"items":[{"sku":"ab"}] )"), JsonParseError);
+
+    std::istringstream is(R"({"id": 7, "items": [{"sku": "abc", "qty": 1}], "note": null})");
+    auto const doc = order_schema().parse(is);
+    EXPECT_EQ(doc["items"][0]["sku"].as_string(), "abc");
+    EXPECT_EQ(doc, json::parse(R"({"id":7,"items":[{"sku":"abc","qty":1}],"note":null})"));
+}
+
+TEST(JsonSchemaTest, RejectsInvalidAndUnsupportedSchemas) {
+    EXPECT_THROW(json_schema<>(json::parse("1")), JsonSchemaError);
+    EXPECT_THROW(json_schema<>(json::parse(R"({"type":"float"})")), JsonSchemaError);
+    EXPECT_THROW(json_schema<>(json::parse(R"({"minLength":-1})")), JsonSchemaError);
+    EXPECT_THROW(json_schema<>(json::parse(R"({"pattern":"("})")), JsonSchemaError);
+    EXPECT_THROW(json_schema<>(json::parse(R"({"anyOf":[true]})")), JsonSchemaError);
+    EXPECT_THROW(json_schema<>(json::parse(R"({"items":[{}]})")), JsonSchemaError);
+
+    json_schema<> const never(json::parse("false"));
+    EXPECT_FALSE(never.is_valid(json::parse("null")));
+    json_schema<> const always(json::parse(R"({"description":"anything"})"));
+    EXPECT_TRUE(always.is_valid(json::parse(R"([1,{"a":null}])")));
+    EXPECT_EQ(always.parse(" [1] "), json::parse("[1]"));
+}
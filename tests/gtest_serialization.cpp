@@ -0,0 +1,590 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace
+{
+    // 不经过 dump() 的自动并行, 作为对照
+    std::string sequential_dump(json const& j, bool pretty, std::string_view indent)
+    {
+        std::string out;
+        details::StringSerializeHandler sh(out);
+        details::JsonSerializer<json, details::StringSerializeHandler> serializer(sh);
+        if (pretty)
+            serializer.dump<true>(j, indent);
+        else
+            serializer.dump<false>(j);
+        return out;
+    }
+
+    // 逐字节的参考实现, 用于与向量化的转义路径对比
+    std::string reference_escape(std::string const& str, bool escape_slash)
+    {
+        static constexpr char hex[] = "0123456789abcdef";
+        std::string out = "\"";
+        for (char ch : str)
+        {
+            auto uch = static_cast<unsigned char>(ch);
+            switch (ch)
+            {
+            case '\"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '/':
+                out += escape_slash ? "\\/" : "/";
+                break;
+            default:
+                if (uch < 0x20)
+                {
+                    out += "\\u00";
+                    out += hex[uch >> 4];
+                    out += hex[uch & 0xF];
+                }
+                else
+                    out += ch;
+            }
+        }
+        out += '\"';
+        return out;
+    }
+
+    std::string escape_with_serializer(std::string const& str, bool escape_slash)
+    {
+        std::string buffer;
+        details::StringSerializeHandler ssh(buffer);
+        details::JsonSerializer<json, details::StringSerializeHandler> serializer(ssh, escape_slash);
+        serializer.escape_string(str);
+        return buffer;
+    }
+}
+
+TEST(SerializationTest, EscapesEveryControlCharacter) {
+    std::string all;
+    for (int c = 0; c < 0x20; ++c)
+        all += static_cast<char>(c);
+
+    EXPECT_EQ(json(all).stringify(), reference_escape(all, false));
+    EXPECT_EQ(json(std::string(1, '\x1f')).stringify(), "\"\\u001f\"");
+    EXPECT_EQ(json(std::string(1, '\0')).stringify(), "\"\\u0000\"");
+}
+
+TEST(SerializationTest, EscapeAtEveryOffsetOfLongString) {
+    // 覆盖向量化块内部, 块边界以及尾部标量循环中的每个位置
+    char const specials[] = { '\"', '\\', '\n', '\x01', '\x7f', '/', '\xC3' };
+    for (char special : specials)
+    {
+        for (std::size_t len : { 1u, 7u, 8u, 15u, 16u, 17u, 33u, 70u })
+        {
+            for (std::size_t pos = 0; pos < len; ++pos)
+            {
+                std::string str(len, 'a');
+                str[pos] = special;
+                for (bool slash : { false, true })
+                {
+                    EXPECT_EQ(escape_with_serializer(str, slash), reference_escape(str, slash))
+                        << "len=" << len << " pos=" << pos << " char=" << static_cast<int>(special);
+                }
+            }
+        }
+    }
+}
+
+TEST(SerializationTest, ForwardSlashEscapingIsOptional) {
+    std::string const url = "http://example.com/a/b";
+    EXPECT_EQ(escape_with_serializer(url, false), "\"http://example.com/a/b\"");
+    EXPECT_EQ(escape_with_serializer(url, true), "\"http:\\/\\/example.com\\/a\\/b\"");
+
+    // 无论是否转义 '/', 输出都应能被正确解析回原字符串
+    EXPECT_EQ(json::parse(escape_with_serializer(url, true)).as_string(), url);
+}
+
+TEST(SerializationTest, SerializedSizeMatchesDumpExactly) {
+    auto j = json::parse(R"({"name":"Mikami","tags":["a\nb","c\u0001"],"pi":3.5,"n":null,"ok":true,"e":{},"z":[]})");
+
+    EXPECT_EQ(j.serialized_size(), j.stringify().size());
+    EXPECT_EQ(j.serialized_size(true), j.pretty().size());
+    EXPECT_EQ(j.serialized_size(true, "    "), j.pretty("    ").size());
+    EXPECT_EQ(json().serialized_size(), 0u);
+
+    std::string buffer;
+    j.dump(buffer);
+    EXPECT_EQ(buffer, j.stringify());
+}
+
+TEST(SerializationTest, FixedBufferHandlerReportsTruncation) {
+    json const j = json::parse(R"([1,"two",{"three":3}])");
+    std::string const expected = j.stringify();
+
+    char large[64];
+    details::FixedBufferSerializeHandler fits(large);
+    j.dump(fits);
+    EXPECT_FALSE(fits.truncated());
+    EXPECT_EQ(fits.view(), expected);
+
+    char small[8];
+    details::FixedBufferSerializeHandler truncated(small, sizeof(small));
+    j.dump(truncated);
+    EXPECT_TRUE(truncated.truncated());
+    EXPECT_EQ(truncated.written(), sizeof(small));
+    EXPECT_EQ(truncated.size(), expected.size());
+    EXPECT_EQ(truncated.view(), expected.substr(0, sizeof(small)));
+}
+
+TEST(SerializationTest, BufferedHandlerFlushesToOStream) {
+    json j;
+    for (int i = 0; i < 2000; ++i)
+        j.push_back(json::object{{"id", i}, {"name", std::string(i % 50, 'x')}});
+    std::string const expected = j.stringify();
+
+    // 缓冲区小于输出, 覆盖多次写出以及大块直写的路径
+    std::ostringstream oss;
+    {
+        details::BufferedOStreamSerializeHandler handler(details::OStreamSink{oss}, 64);
+        j.dump(handler);
+        EXPECT_TRUE(handler.flush());
+        EXPECT_FALSE(handler.bad());
+    }
+    EXPECT_EQ(oss.str(), expected);
+
+    std::ostringstream via_dump;
+    j.dump(via_dump);
+    EXPECT_EQ(via_dump.str(), expected);
+}
+
+TEST(SerializationTest, DumpToOStreamReportsStreamErrors) {
+    // 拒绝一切输出的 streambuf
+    struct FailingBuf : std::streambuf
+    {
+        int_type overflow(int_type) override { return traits_type::eof(); }
+        std::streamsize xsputn(char const*, std::streamsize) override { return 0; }
+    } buf;
+    json const j = json::parse(R"({"a":[1,2,3],"b":"short"})");
+
+    std::ostream os(&buf);
+    j.dump(os);
+    EXPECT_TRUE(os.bad());
+
+    std::ostream throwing(&buf);
+    throwing.exceptions(std::ios::badbit);
+    EXPECT_THROW(j.dump(throwing), std::ios_base::failure);
+    EXPECT_THROW(throwing << j, std::ios_base::failure);
+}
+
+TEST(SerializationTest, BufferedHandlerUsesCallerBuffer) {
+    json const j = json::parse(R"({"key":"a value longer than the buffer","n":[1,2,3]})");
+    std::ostringstream oss;
+    char buffer[8];
+    details::BufferedOStreamSerializeHandler handler(details::OStreamSink{oss}, buffer, sizeof buffer);
+    j.dump(handler);
+    EXPECT_TRUE(handler.drain());
+    EXPECT_EQ(oss.str(), j.stringify());
+}
+
+TEST(SerializationTest, BufferedHandlerWritesToCFile) {
+    json const j = json::parse(R"({"a":[1,2,3],"b":"text"})");
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    {
+        details::BufferedCFileSerializeHandler handler(details::CFileSink{file});
+        j.dump(handler, true);
+        EXPECT_TRUE(handler.flush());
+    }
+    std::rewind(file);
+    std::string content;
+    for (int ch; (ch = std::fgetc(file)) != EOF;)
+        content += static_cast<char>(ch);
+    std::fclose(file);
+    EXPECT_EQ(content, j.pretty());
+}
+
+#if JSONPP_HAS_POSIX_IO
+TEST(SerializationTest, BufferedHandlerWritesToFdAndReportsErrors) {
+    json const j = json::parse(R"({"key":"value","list":[true,false,null]})");
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    {
+        details::BufferedFdSerializeHandler handler(details::FdSink{fds[1]}, 16);
+        j.dump(handler);
+        EXPECT_TRUE(handler.flush());
+    }
+    ::close(fds[1]);
+    std::string content;
+    char buf[256];
+    for (ssize_t n; (n = ::read(fds[0], buf, sizeof(buf))) > 0;)
+        content.append(buf, static_cast<std::size_t>(n));
+    ::close(fds[0]);
+    EXPECT_EQ(content, j.stringify());
+
+    details::BufferedFdSerializeHandler broken(details::FdSink{-1});
+    j.dump(broken);
+    EXPECT_FALSE(broken.flush());
+    EXPECT_TRUE(broken.bad());
+    EXPECT_EQ(broken.error(), EBADF);
+}
+#endif
+
+TEST(SerializationTest, ScatterGatherReferencesLongStringsInPlace) {
+    std::string const blob(4096, 'B');
+    json j;
+    j["blob"] = blob;
+    j["small"] = "tiny";
+    j["escaped"] = std::string(1000, 'x') + "\n" + std::string(1000, 'y');
+
+    details::ScatterGatherSerializeHandler handler;
+    j.dump(handler);
+    EXPECT_EQ(handler.str(), j.stringify());
+    EXPECT_EQ(handler.size(), j.serialized_size());
+
+    // blob 以及转义字符两侧的长片段都应直接指向 json 节点中的字符串
+    std::string const& stored_blob = j["blob"].as_string();
+    std::string const& stored_escaped = j["escaped"].as_string();
+    int referenced = 0;
+    for (auto seg : handler.segments())
+    {
+        if (seg.data() == stored_blob.data() && seg.size() == stored_blob.size())
+            ++referenced;
+        if (seg.data() == stored_escaped.data() || seg.data() == stored_escaped.data() + 1001)
+            ++referenced;
+    }
+    EXPECT_EQ(referenced, 3);
+}
+
+#if JSONPP_HAS_POSIX_IO
+TEST(SerializationTest, ScatterGatherWritesWithWritev) {
+    json j;
+    for (int i = 0; i < 100; ++i)
+        j.push_back(std::string(300 + i, static_cast<char>('a' + i % 26)));
+
+    details::ScatterGatherSerializeHandler handler;
+    j.dump(handler, true);
+    EXPECT_EQ(handler.iovecs().size(), handler.segment_count());
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_TRUE(handler.write_to(::fileno(file)));
+    std::rewind(file);
+    std::string content;
+    for (int ch; (ch = std::fgetc(file)) != EOF;)
+        content += static_cast<char>(ch);
+    std::fclose(file);
+    EXPECT_EQ(content, j.pretty());
+}
+#endif
+
+TEST(SerializationTest, PrettyPrintIndentsNestedContainers) {
+    auto j = json::parse(R"({"a":[[1],{"b":2}]})");
+    EXPECT_EQ(j.pretty("  "), "{\n  \"a\": [\n    [\n      1\n    ],\n    {\n      \"b\": 2\n    }\n  ]\n}");
+}
+
+TEST(SerializationTest, ParallelDumpIsByteIdentical) {
+    json j;
+    j["meta"] = json::object{{"count", 5000}, {"source", "test/feed"}};
+    for (int i = 0; i < 5000; ++i)
+    {
+        json row;
+        row["id"] = i;
+        row["score"] = i * 0.5;
+        row["name"] = "row \"" + std::to_string(i) + "\"\n";
+        row["tags"] = json::array{"a", "b", i % 3 == 0};
+        j["rows"].push_back(std::move(row));
+    }
+    for (int i = 0; i < 3000; ++i)
+        j["index"]["k" + std::to_string(i)] = json::array{i, nullptr};
+
+    ParallelSerializeOptions options;
+    options.threads = 4;
+    options.min_parallel_bytes = 4096;
+
+    for (bool pretty : { false, true })
+    {
+        std::string parallel;
+        j.dump_parallel(parallel, pretty, "  ", options);
+        EXPECT_EQ(parallel, sequential_dump(j, pretty, "  "));
+    }
+
+    // 小文档不会触发并行, 结果同样一致
+    std::string small;
+    json::parse("[1,2,{\"x\":[]}]").dump_parallel(small, true);
+    EXPECT_EQ(small, json::parse("[1,2,{\"x\":[]}]").pretty());
+}
+
+TEST(SerializationTest, DumpGoesParallelAboveSizeThreshold) {
+    // 少量子节点各自很大: 顺序地进入子节点, 在其中并行
+    json j;
+    for (int part = 0; part < 2; ++part)
+        for (int i = 0; i < 20000; ++i)
+            j["part" + std::to_string(part)].push_back(json::object{{"id", i}, {"text", std::string(40, 'a' + i % 26)}});
+    ASSERT_GE(details::ParallelJsonSerializer<json>::estimate_size(j, SIZE_MAX), ParallelSerializeOptions{}.min_parallel_bytes);
+    EXPECT_EQ(j.stringify(), sequential_dump(j, false, ""));
+    EXPECT_EQ(j.pretty(" "), sequential_dump(j, true, " "));
+
+    ParallelSerializeOptions options; // 单核机器上 dump() 不会并行, 这里显式指定线程数
+    options.threads = 4;
+    std::string parallel;
+    j.dump_parallel(parallel, true, " ", options);
+    EXPECT_EQ(parallel, sequential_dump(j, true, " "));
+}
+
+TEST(SerializationTest, SizeEstimateVisitsBoundedNodes) {
+    // 8 叉树, 约 30 万个节点: 估计只访问固定数量的节点, 其余按样本外推, 结果仍在同一数量级
+    std::function<json(int)> tree = [&](int depth)
+    {
+        if (depth == 0)
+            return json(12345);
+        json node;
+        for (int i = 0; i < 8; ++i)
+            node.push_back(tree(depth - 1));
+        return node;
+    };
+    json const j = tree(6);
+    std::size_t const actual = j.serialized_size();
+    std::size_t const estimate = details::ParallelJsonSerializer<json>::estimate_size(j, SIZE_MAX);
+    EXPECT_GE(estimate, actual / 4);
+    EXPECT_LE(estimate, actual * 4);
+    EXPECT_EQ(j.stringify(), sequential_dump(j, false, ""));
+}
+
+TEST(SerializationTest, RunParallelNestsWithinBoundedPool) {
+    std::atomic<int> sum{0};
+    details::run_parallel(16, 64, [&](std::size_t i)
+    {
+        details::run_parallel(16, 64, [&](std::size_t k) { sum += static_cast<int>(i * 16 + k); });
+    });
+    EXPECT_EQ(sum.load(), 255 * 256 / 2);
+
+    EXPECT_THROW(details::run_parallel(100, 8, [](std::size_t i)
+    {
+        if (i == 42)
+            throw JsonException("task failed");
+    }), JsonException);
+}
+
+TEST(SerializationTest, WriterMatchesDumpOfEquivalentDocument) {
+    json j;
+    j["id"] = 42;
+    j["name"] = "row \"1\"";
+    j["ratio"] = 2.0;
+    j["tags"] = json::array{"a", nullptr, false};
+    j["nested"] = json::object{{"empty_array", json::array{}}, {"empty_object", json::object{}}};
+
+    for (bool pretty : { false, true })
+    {
+        std::string out;
+        details::StringSerializeHandler ssh(out);
+        json_writer writer(ssh, pretty, "  ");
+        // std::map 按键排序输出, 这里按相同顺序写入
+        writer.begin_object()
+            .key("id").value(42)
+            .key("name").value(std::string("row \"1\""))
+            .key("nested").begin_object()
+                .key("empty_array").begin_array().end_array()
+                .key("empty_object").begin_object().end_object()
+            .end_object()
+            .key("ratio").value(2.0)
+            .member("tags", json::array{"a", nullptr, false})
+        .end_object();
+        EXPECT_TRUE(writer.complete());
+
+        std::string expected;
+        j.dump(expected, pretty, "  ");
+        EXPECT_EQ(out, expected);
+    }
+}
+
+TEST(SerializationTest, WriterRejectsMalformedSequences) {
+    std::string out;
+    details::StringSerializeHandler ssh(out);
+
+    json_writer w1(ssh);
+    w1.begin_object();
+    EXPECT_THROW(w1.value(1), JsonWriterError);           // member value without key
+    EXPECT_THROW(w1.end_array(), JsonWriterError);        // mismatched container
+    w1.key("k");
+    EXPECT_THROW(w1.key("again"), JsonWriterError);       // two keys in a row
+    EXPECT_THROW(w1.end_object(), JsonWriterError);       // dangling key
+    w1.value(1).end_object();
+    EXPECT_TRUE(w1.complete());
+    EXPECT_THROW(w1.value(2), JsonWriterError);           // second root
+
+    json_writer w2(ssh);
+    EXPECT_THROW(w2.key("k"), JsonWriterError);           // key outside object
+    w2.begin_array().value(1);
+    EXPECT_FALSE(w2.complete());
+}
+
+TEST(SerializationTest, WriterDoesNotReferenceTemporariesInZeroCopyHandlers) {
+    details::ScatterGatherSerializeHandler handler(1);
+    json_writer writer(handler);
+    writer.begin_array();
+    for (int i = 0; i < 3; ++i)
+        writer.value(std::string(300, static_cast<char>('a' + i))); // 临时字符串, 写入后即销毁
+    writer.begin_object()
+        .member("k", json(std::string(300, 'd')))                      // 临时 basic_json 同样不能被引用
+        .member("l", json::array{std::string(300, 'e')})
+    .end_object();
+    json const kept = std::string(300, 'f');
+    writer.value(kept);                                                 // 左值仍可零拷贝引用
+    writer.end_array();
+
+    json expected = json::array{std::string(300, 'a'), std::string(300, 'b'), std::string(300, 'c'),
+        json::object{{"k", std::string(300, 'd')}, {"l", json::array{std::string(300, 'e')}}}, std::string(300, 'f')};
+    EXPECT_EQ(handler.str(), expected.stringify());
+}
+
+TEST(SerializationTest, CleanStringHintsFollowMutations) {
+    auto j = json::parse(R"({"plain":"abc","esc\"key":"line\nbreak","list":["x","y\\z"]})");
+    std::string const first = j.stringify();
+    EXPECT_EQ(first, R"({"esc\"key":"line\nbreak","list":["x","y\\z"],"plain":"abc"})");
+    EXPECT_EQ(j.stringify(), first); // 第二次序列化使用解析时记录的标记
+
+    // 通过可变引用修改后, 标记必须失效
+    j["plain"].as_string() += "\"quoted\"";
+    *j["list"][0].get_if_string() += "\t";
+    EXPECT_EQ(j.stringify(), R"({"esc\"key":"line\nbreak","list":["x\t","y\\z"],"plain":"abc\"quoted\""})");
+
+    // 赋值与拷贝: 新值的标记随值移动
+    json clean = json::parse(R"("clean")");
+    j["esc\"key"] = clean;
+    json copy = j;
+    copy["plain"] = "a/b";
+    EXPECT_EQ(copy.stringify(), R"({"esc\"key":"clean","list":["x\t","y\\z"],"plain":"a/b"})");
+    EXPECT_EQ(json::parse(copy.stringify()), copy);
+
+    std::swap(j["plain"], j["esc\"key"]);
+    EXPECT_EQ(j.stringify(), R"({"esc\"key":"abc\"quoted\"","list":["x\t","y\\z"],"plain":"clean"})");
+}
+
+TEST(SerializationTest, KeysChangedThroughNodeHandlesAreEscaped) {
+    auto j = json::parse(R"({"ab":1,"cd":"x"})");
+    EXPECT_EQ(j.stringify(), R"({"ab":1,"cd":"x"})");
+    auto& obj = j.as_object();
+    auto nh = obj.extract(obj.begin());
+    nh.key() = "a\"b";
+    obj.insert(std::move(nh));
+    EXPECT_EQ(j.stringify(), R"({"a\"b":1,"cd":"x"})");
+    EXPECT_EQ(j.pretty(" "), "{\n \"a\\\"b\": 1,\n \"cd\": \"x\"\n}");
+    EXPECT_EQ(json::parse(j.stringify()), j);
+}
+
+TEST(SerializationTest, RetainedStringReferenceCannotStaleHints) {
+    // 引用在 dump() 之前取得, 之后才写入需要转义的内容
+    auto doc = json::parse(R"({"name":"plain"})");
+    auto& s = doc["name"].as_string();
+    EXPECT_EQ(doc.stringify(), R"({"name":"plain"})");
+    s = "a\"b\n";
+    EXPECT_EQ(doc.stringify(), R"({"name":"a\"b\n"})");
+
+    json built;
+    built["k"] = "clean";
+    auto& t = built["k"].as_string();
+    EXPECT_EQ(built.stringify(), R"({"k":"clean"})");
+    t = "</\x01>";
+    EXPECT_EQ(built.stringify(), R"({"k":"</\u0001>"})");
+    EXPECT_EQ(json::parse(built.stringify()), built);
+}
+
+TEST(SerializationTest, CleanHintsIgnoredWhenEscapingForwardSlash) {
+    auto j = json::parse(R"({"url/path":"a/b"})");
+    EXPECT_EQ(j.stringify(), R"({"url/path":"a/b"})");
+
+    std::string out;
+    details::StringSerializeHandler ssh(out);
+    details::JsonSerializer<json, details::StringSerializeHandler> serializer(ssh, true);
+    serializer.dump(j);
+    EXPECT_EQ(out, R"({"url\/path":"a\/b"})");
+}
+
+TEST(SerializationTest, IncrementalDumpReusesUnchangedSource) {
+    std::string const source = R"({ "name" : "cfg",  "limits": {"cpu": 2,  "mem": 1.50e3},
+        "servers": [ {"host": "aA", "port": 80}, {"host": "b", "port": 81} ], "tags": [] })";
+    SourceSpans spans;
+    ParseOptions options;
+    options.source_spans = &spans;
+    auto doc = json::parse(source, options);
+
+    // 未修改: 整个文档按原样复制
+    std::string out;
+    doc.dump_incremental(out, source, spans);
+    EXPECT_EQ(out, source);
+
+    // 修改一个深层的键: 只有沿途的容器被重新序列化, 其余子树保留源格式
+    doc["servers"][1]["port"] = 8081;
+    out.clear();
+    doc.dump_incremental(out, source, spans);
+    EXPECT_EQ(out, R"({"limits":{"cpu": 2,  "mem": 1.50e3},"name":"cfg","servers":[{"host": "aA", "port": 80},{"host":"b","port":8081}],"tags":[]})");
+    EXPECT_EQ(json::parse(out), doc);
+
+    // push_back / 赋值同样使所在容器失效
+    doc["tags"].push_back("new");
+    doc["limits"] = json::parse(source).as_object().at("limits"); // 无源区间的新值
+    out.clear();
+    doc.dump_incremental(out, source, spans);
+    EXPECT_EQ(json::parse(out), doc);
+    EXPECT_NE(out.find(R"("tags":["new"])"), std::string::npos);
+    EXPECT_NE(out.find(R"("limits":{"cpu":2,"mem":1500.0})"), std::string::npos);
+
+    // 普通 dump 不受源区间影响
+    EXPECT_EQ(doc.stringify(), json::parse(out).stringify());
+}
+
+TEST(SerializationTest, IncrementalDumpCopiesAndPrettyPrint) {
+    std::string const source = R"({"a": [1,  2], "b": {"c": true}})";
+    SourceSpans spans;
+    ParseOptions options;
+    options.source_spans = &spans;
+    auto doc = json::parse(source, options);
+
+    json copy = doc; // 拷贝保留源区间编号, 对同一源文本仍然有效
+    copy["b"]["c"] = false;
+    std::string out;
+    copy.dump_incremental(out, source, spans, true, "  ");
+    EXPECT_EQ(out, "{\n  \"a\": [1,  2],\n  \"b\": {\n    \"c\": false\n  }\n}");
+
+    // 没有记录源区间的文档: 与 dump() 相同
+    auto plain = json::parse(source);
+    std::string incremental;
+    plain.dump_incremental(incremental, source, spans);
+    EXPECT_EQ(incremental, plain.stringify());
+}
+
+TEST(SerializationTest, IncrementalDumpIgnoresSpansOfOtherDocuments) {
+    std::string const source_a = R"({"x": {"k": [1, 2, 3], "s": "long string from a"}})";
+    std::string const source_b = R"({"p": 1,   "q": null, "r": {"t": "b"}})";
+    SourceSpans spans_a, spans_b;
+    ParseOptions options_a, options_b;
+    options_a.source_spans = &spans_a;
+    options_b.source_spans = &spans_b;
+    auto a = json::parse(source_a, options_a);
+    auto b = json::parse(source_b, options_b);
+
+    // 拷贝或移动到另一个文档的值 (包括其中的子节点) 不能按另一个源文本的区间复制
+    b["q"] = a["x"];
+    b["r"] = std::move(a.as_object().at("x")); // 移动容器时子节点本身不被移动
+    std::string out;
+    b.dump_incremental(out, source_b, spans_b);
+    EXPECT_EQ(json::parse(out), b);
+    EXPECT_EQ(out, R"({"p":1,"q":{"k":[1,2,3],"s":"long string from a"},"r":{"k":[1,2,3],"s":"long string from a"}})");
+
+    // 再次解析到同一个表后, 旧文档的区间失效
+    auto b2 = json::parse(source_b, options_b);
+    out.clear();
+    b.dump_incremental(out, source_b, spans_b);
+    EXPECT_EQ(json::parse(out), b);
+    out.clear();
+    b2.dump_incremental(out, source_b, spans_b);
+    EXPECT_EQ(out, source_b);
+
+    // 源区间表不占用节点本身的空间
+    EXPECT_LE(sizeof(json), 64u);
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "jsonpp.hpp"
+
+using namespace jsonpp;
+
+namespace rpc
+{
+    struct point
+    {
+        double x = 0;
+        double y = 0;
+
+        bool operator==(point const& other) const { return x == other.x && y == other.y; }
+    };
+    JSONPP_FIELDS(point, x, y)
+
+    struct shape
+    {
+        std::string name;
+        std::vector<point> points;
+        std::optional<std::uint32_t> color;
+        std::map<std::string, bool> flags;
+        bool visible = false;
+        json extra;
+    };
+    JSONPP_FIELDS(shape, name, points, color, flags, visible, extra)
+
+    // 不注册成员, 通过 ADL 提供转换
+    struct celsius
+    {
+        double degrees = 0;
+    };
+
+    struct wide
+    {
+        int f0 = 0, f1 = 0, f2 = 0, f3 = 0, f4 = 0, f5 = 0, f6 = 0, f7 = 0, f8 = 0, f9 = 0, f10 = 0, f11 = 0, f12 = 0, f13 = 0, f14 = 0, f15 = 0, f16 = 0, f17 = 0, f18 = 0, f19 = 0, f20 = 0, f21 = 0, f22 = 0, f23 = 0, f24 = 0, f25 = 0, f26 = 0, f27 = 0, f28 = 0, f29 = 0, f30 = 0, f31 = 0, f32 = 0, f33 = 0, f34 = 0, f35 = 0, f36 = 0, f37 = 0, f38 = 0, f39 = 0;
+        std::string tail;
+    };
+    JSONPP_FIELDS(wide, f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15, f16, f17, f18, f19, f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31, f32, f33, f34, f35, f36, f37, f38, f39, tail)
+
+    inline void to_json(json& j, celsius const& c) { j = json(std::to_string(c.degrees) + "C"); }
+    inline void from_json(json const& j, celsius& c) { c.degrees = std::stod(j.as_string()); }
+}
+
+TEST(TypedParseTest, ParsesRegisteredStructs) {
+    auto const s = parse_into<rpc::shape>(R"({
+        "name": "tri", "unknown": {"deep": [1, 2, {"x": 3}]},
+        "points": [{"x": 1, "y": 2.5}, {"y": -1, "x": 0}, {}],
+        "color": 255, "flags": {"filled": true, "dashed": false},
+        "visible": true, "extra": {"any": ["json"]}})");
+    EXPECT_EQ(s.name, "tri");
+    ASSERT_EQ(s.points.size(), 3u);
+    EXPECT_EQ(s.points[0], (rpc::point{1, 2.5}));
+    EXPECT_EQ(s.points[1], (rpc::point{0, -1}));
+    EXPECT_EQ(s.points[2], (rpc::point{0, 0}));
+    EXPECT_EQ(s.color, 255u);
+    EXPECT_EQ(s.flags.at("filled"), true);
+    EXPECT_TRUE(s.visible);
+    EXPECT_EQ(s.extra, json::parse(R"({"any":["json"]})"));
+
+    auto const t = parse_into<rpc::shape>(R"({"name":"x","color":null})");
+    EXPECT_FALSE(t.color.has_value());
+
+    std::istringstream is(R"([[1, 2], [3]])");
+    std::vector<std::vector<int>> nested;
+    parse_into(is, nested);
+    EXPECT_EQ(nested, (std::vector<std::vector<int>>{{1, 2}, {3}}));
+    EXPECT_EQ(parse_into<std::vector<bool>>("[true,false]"), (std::vector<bool>{true, false}));
+    EXPECT_EQ(parse_into<std::int64_t>("1e3"), 1000);
+}
+
+TEST(TypedParseTest, RejectsMismatchedAndMalformedInput) {
+    EXPECT_THROW(parse_into<rpc::point>(R"({"x":"1"})"), JsonTypeError);
+    EXPECT_THROW(parse_into<rpc::point>("[1,2]"), JsonTypeError);
+    EXPECT_THROW(parse_into<std::uint8_t>("256"), JsonTypeError);
+    EXPECT_THROW(parse_into<int>("1.5"), JsonTypeError);
+    EXPECT_THROW(parse_into<rpc::point>(R"({"x":1,})"), JsonParseError);
+    EXPECT_THROW(parse_into<rpc::point>(R"({"x":1} x)"), JsonParseError);
+    EXPECT_THROW(parse_into<rpc::shape>(R"({"unknown":[1,}])"), JsonParseError);
+    EXPECT_THROW(parse_into<std::vector<int>>("[1,2"), JsonParseError);
+}
+
+TEST(TypedParseTest, AdlSerializerRoundTrip) {
+    rpc::shape s;
+    s.name = "sq";
+    s.points = {{0, 0}, {1, 1}};
+    s.color = 7;
+    s.flags = {{"filled", true}};
+    s.extra = json::parse("[null]");
+
+    json const j = s;
+    EXPECT_EQ(j["points"][1]["x"].as_float(), 1.0);
+    EXPECT_EQ(j["color"].as_int(), 7);
+    EXPECT_EQ(j["extra"], s.extra);
+
+    auto const back = j.get<rpc::shape>();
+    EXPECT_EQ(back.points, s.points);
+    EXPECT_EQ(back.color, s.color);
+    EXPECT_EQ(back.flags, s.flags);
+    EXPECT_EQ(parse_into<rpc::shape>(j.stringify()).points, s.points);
+
+    json const t = rpc::celsius{21.5};
+    EXPECT_EQ(t.get<rpc::celsius>().degrees, 21.5);
+    EXPECT_EQ(parse_into<rpc::celsius>(R"("-3.5C")").degrees, -3.5);
+    EXPECT_EQ(json::parse(R"({"p":{"x":2,"y":3}})").value("p", rpc::point{}), (rpc::point{2, 3}));
+    EXPECT_EQ((json(std::vector<int>{1, 2})), json::parse("[1,2]"));
+}
+
+TEST(TypedParseTest, FromJsonReadsRawNodes) {
+    ParseOptions options;
+    options.raw_depth = 1;
+    auto const j = json::parse(R"({"p": {"x": 1, "y": 2.5}, "flags": {"a": true}, "list": [3, 4]})", options);
+    ASSERT_TRUE(j.at("p").is_raw());
+    EXPECT_EQ(j.at("p").get<rpc::point>(), (rpc::point{1, 2.5}));
+    EXPECT_EQ((j.at("flags").get<std::map<std::string, bool>>()), (std::map<std::string, bool>{{"a", true}}));
+    EXPECT_EQ(j.at("list").get<std::vector<int>>(), (std::vector<int>{3, 4}));
+    EXPECT_FALSE(json::from_raw("null").get<std::optional<int>>().has_value());
+    EXPECT_EQ(json::from_raw("5").get<std::optional<int>>(), 5);
+
+    EXPECT_THROW(j.at("list").get<rpc::point>(), JsonTypeError);
+    EXPECT_THROW(j.at("p").get<std::vector<int>>(), JsonTypeError);
+    EXPECT_TRUE(j.at("p").is_raw()); // const 读取不改变节点
+}
+
+TEST(TypedParseTest, PerfectHashKeyDispatch) {
+    constexpr details::PerfectHashTable<4> table({"id", "name", "d", "di"});
+    static_assert(table.valid());
+    static_assert(table.find("name") == 1 && table.find("di") == 3);
+    static_assert(table.find("nam") == 4 && table.find("") == 4);
+    static_assert(!details::PerfectHashTable<2>({"a", "a"}).valid());
+
+    std::string doc = "{";
+    for (int i = 39; i >= 0; --i)
+        doc += "\"f" + std::to_string(i) + "\":" + std::to_string(i * 3) + ",\"x" + std::to_string(i) + "\":[{}],";
+    doc += R"("t\u0061il":"end"})";
+
+    auto const w = parse_into<rpc::wide>(doc);
+    EXPECT_EQ(w.f0, 0);
+    EXPECT_EQ(w.f17, 51);
+    EXPECT_EQ(w.f39, 117);
+    EXPECT_EQ(w.tail, "end");
+
+    std::istringstream is(doc);
+    rpc::wide v;
+    parse_into(is, v);
+    EXPECT_EQ(v.f38, 114);
+    EXPECT_EQ(v.tail, "end");
+}
@@ -1,4 +1,14 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#if __has_include(<execution>)
+#include <execution>
+#endif
+#include <memory>
+#include <thread>
+#include <numeric>
+#include <unordered_set>
+#include <utility>
 
 #include "jsonpp.hpp"
 using namespace jsonpp;
@@ -299,4 +309,571 @@ TEST(JsonUsageTest, ADLSwap) {
 
     EXPECT_EQ(j1.as_int(), 20);
     EXPECT_EQ(j2.as_int(), 10);
-}
\ No newline at end of file
+}
+TEST(JsonUsageTest, StructuralHash) {
+    auto a = json::parse(R"({"x":[1,2,{"y":"z"}],"flag":true,"pi":3.5})");
+    auto b = json::parse(R"({"pi":3.5,"flag":true,"x":[1,2,{"y":"z"}]})");
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(std::hash<json>{}(a), a.hash());
+
+    // 无序容器: 成员顺序不影响哈希
+    auto ua = unordered_json::parse(R"({"a":1,"b":2,"c":3})");
+    auto ub = unordered_json::parse(R"({"c":3,"b":2,"a":1})");
+    EXPECT_EQ(ua.hash(), ub.hash());
+
+    // 数组顺序与值类型会影响哈希
+    EXPECT_NE(json::parse("[1,2]").hash(), json::parse("[2,1]").hash());
+    EXPECT_NE(json(1).hash(), json(1.0).hash());
+    EXPECT_NE(json::parse(R"({"a":1,"b":2})").hash(), json::parse(R"({"a":2,"b":1})").hash());
+}
+
+TEST(JsonUsageTest, HashFollowsMutations) {
+    auto a = json::parse(R"({"items":[1,2,3],"name":"n"})");
+    auto b = a;
+    auto const original = a.hash();
+    EXPECT_EQ(b.hash(), original);
+    EXPECT_TRUE(a == b);
+
+    // 修改深层节点后哈希随之改变
+    b["items"][1] = 20;
+    EXPECT_NE(b.hash(), original);
+    EXPECT_FALSE(a == b);
+
+    b["items"][1] = 2;
+    EXPECT_EQ(b.hash(), original);
+    EXPECT_TRUE(a == b);
+
+    b["name"].as_string() += "!";
+    EXPECT_FALSE(a == b);
+    b.as_object().erase("name");
+    b["name"] = "n";
+    EXPECT_TRUE(a == b);
+
+    std::unordered_set<json> set{a, b, json::parse("[1]")};
+    EXPECT_EQ(set.size(), 2u);
+
+    // 在 hash() 之前取得的引用, 之后写入的修改同样可见
+    auto& items = b["items"].as_array();
+    EXPECT_EQ(b.hash(), original);
+    EXPECT_TRUE(a == b);
+    items.push_back(4);
+    EXPECT_NE(b.hash(), original);
+    EXPECT_FALSE(a == b);
+    items.pop_back();
+    EXPECT_TRUE(a == b);
+
+    if constexpr (sizeof(std::size_t) == 8) // 哈希使用 size_t 的全部位数
+    {
+        std::size_t high = 0;
+        for (int i = 0; i < 16; ++i)
+            high |= json(i).hash() >> 32;
+        EXPECT_NE(high, 0u);
+    }
+}
+
+TEST(JsonRawTest, ParseKeepsDeepContainersRaw) {
+    std::string const doc = R"({"id": 7, "payload": {"a": [1, 2,  3], "b": "x\ty"}, "list": [[1], {"k": null}]})";
+    ParseOptions options;
+    options.raw_depth = 1;
+    auto j = json::parse(doc, options);
+
+    EXPECT_TRUE(j.is_object());
+    EXPECT_TRUE(j["id"].is_int());
+    auto const& cj = j;
+    EXPECT_TRUE(cj.at("payload").is_raw());
+    EXPECT_TRUE(cj.at("list").is_raw());
+
+    // raw 片段按源文本原样写出, 包括其中的空白
+    EXPECT_EQ(j.stringify(), R"({"id":7,"list":[[1], {"k": null}],"payload":{"a": [1, 2,  3], "b": "x\ty"}})");
+    EXPECT_EQ(j, json::parse(doc));
+    EXPECT_EQ(j.hash(), json::parse(doc).hash());
+}
+
+TEST(JsonRawTest, ParseKeepsPointerPathsRaw) {
+    ParseOptions options;
+    options.raw_paths = {"/data/blob", "/items/1", "/a~1b"};
+    auto j = json::parse(R"({"data":{"blob":[true, false],"keep":[1]},"items":[0,"one",{"x":2}],"a/b":{}})", options);
+    auto const& cj = j;
+
+    EXPECT_TRUE(cj.at("data").is_object());
+    EXPECT_TRUE(cj.at("data").at("blob").is_raw());
+    EXPECT_TRUE(cj.at("data").at("keep").is_array());
+    EXPECT_TRUE(cj.at("items").at(1).is_raw());
+    EXPECT_TRUE(cj.at("items").at(2).is_object());
+    EXPECT_TRUE(cj.at("a/b").is_raw());
+
+    options.raw_paths = {""};
+    EXPECT_TRUE(json::parse(" [1, 2] ", options).is_raw());
+
+    options.raw_paths = {"missing-slash"};
+    EXPECT_THROW(json::parse("{}", options), JsonException);
+}
+
+TEST(JsonRawTest, RawFragmentsAreValidated) {
+    ParseOptions options;
+    options.raw_depth = 1;
+    EXPECT_THROW(json::parse(R"({"a": [1, 2,]})", options), JsonParseError);
+    EXPECT_THROW(json::parse(R"({"a": {"k" 1}})", options), JsonParseError);
+    EXPECT_THROW(json::parse(R"({"a": ["\x"]})", options), JsonParseError);
+    EXPECT_THROW(json::parse(R"({"a": [1)", options), JsonParseError);
+
+    EXPECT_THROW(json::from_raw("[1, 2"), JsonParseError);
+    EXPECT_THROW(json::from_raw("1 2"), JsonParseError);
+    EXPECT_THROW(json::from_raw(""), JsonParseError);
+    EXPECT_THROW(json::from_raw("{1: 2}"), JsonParseError);
+}
+
+TEST(JsonRawTest, MutableAccessMaterializes) {
+    json j;
+    j["meta"] = json::from_raw(R"({"v": [1, 2]})");
+    EXPECT_EQ(j.stringify(), R"({"meta":{"v": [1, 2]}})");
+    EXPECT_EQ(j.size(), 1u);
+    EXPECT_EQ(static_cast<json const&>(j).at("meta").size(), 1u);
+
+    // const 访问不改变节点类型
+    EXPECT_TRUE(static_cast<json const&>(j).at("meta").is_raw());
+    EXPECT_EQ(static_cast<json const&>(j).at("meta").materialized()["v"][1].as_int(), 2);
+
+    j["meta"]["v"].push_back(3);
+    EXPECT_TRUE(j["meta"].is_object());
+    EXPECT_EQ(j.stringify(), R"({"meta":{"v":[1,2,3]}})");
+
+    json s = json::from_raw(R"("text")");
+    s.materialize();
+    EXPECT_TRUE(s.is_string());
+    EXPECT_EQ(s.as_string(), "text");
+}
+
+TEST(JsonRawTest, ConstAccessReadsCachedParse) {
+    ParseOptions options;
+    options.raw_depth = 1;
+    auto j = json::parse(R"({"list": [3, 1, 2], "obj": {"k": "v"}, "n": 1})", options);
+    json const& cj = j;
+    auto const& list = cj.at("list");
+    ASSERT_TRUE(list.is_raw());
+
+    // const 访问透明地读取解析结果, 且只解析一次
+    EXPECT_EQ(list.size(), 3u);
+    auto const* first = &list.as_array();
+    EXPECT_EQ(&list.as_array(), first);
+    EXPECT_EQ(list.get_if_array(), first);
+    EXPECT_EQ(list[1].as_int(), 1);
+    std::int64_t sum = 0;
+    for (auto const& v : list)
+        sum += v.as_int();
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(cj.at("obj").at("k").as_string(), "v");
+    EXPECT_TRUE(cj.at("obj").contains("k"));
+    EXPECT_NE(cj.at("obj").find("k"), cj.at("obj").end());
+    EXPECT_EQ(cj.at("obj").value("k", "d"), "v");
+    EXPECT_EQ(cj.at("obj").value("missing", 0), 0);
+    EXPECT_THROW(list.value("k", 0), JsonTypeError);
+    EXPECT_TRUE(list.is_raw());
+    EXPECT_EQ(list.stringify(), "[3, 1, 2]");
+
+    // 拷贝不共享缓存; 可变访问沿用缓存的结果
+    json copy = list;
+    EXPECT_EQ(copy, list);
+    j["list"].push_back(4);
+    EXPECT_TRUE(j["list"].is_array());
+    EXPECT_EQ(j["list"].stringify(), "[3,1,2,4]");
+    EXPECT_EQ(copy.stringify(), "[3, 1, 2]");
+}
+
+TEST(JsonRawTest, ParsedStringsDoNotReserveDocumentSize) {
+    std::string doc = "[\"a\",\"" + std::string(4096, 'b') + "\"]";
+    auto j = json::parse(doc);
+    EXPECT_LT(j[0].as_string().capacity(), doc.size());
+}
+
+TEST(JsonIteratorTest, ArrayIteratorArithmetic) {
+    auto j = json::parse("[5, 3, 9, 1, 7]");
+    // 数组与对象共用一种迭代器, 因此只声明为双向; 数组上的随机访问运算仍是 O(1)
+    static_assert(std::is_same_v<std::iterator_traits<json::iterator>::iterator_category, std::bidirectional_iterator_tag>);
+
+    EXPECT_EQ(j.end() - j.begin(), 5);
+    EXPECT_EQ(j.begin()[2].as_int(), 9);
+    EXPECT_EQ((j.end() - 1)->as_int(), 7);
+    EXPECT_EQ((--j.end())->as_int(), 7);
+    EXPECT_TRUE(j.begin() < j.end());
+    auto const first = j.cbegin(), last = j.cend();
+    static_assert(noexcept(first == last) && noexcept(first != last));
+
+    std::sort(j.as_array().begin(), j.as_array().end(), [](json const& a, json const& b) { return a.as_int() < b.as_int(); });
+    EXPECT_EQ(j.stringify(), "[1,3,5,7,9]");
+
+    std::vector<std::int64_t> reversed;
+    for (auto it = j.crbegin(); it != j.crend(); ++it)
+        reversed.push_back(it->as_int());
+    EXPECT_EQ(reversed, (std::vector<std::int64_t>{9, 7, 5, 3, 1}));
+
+    json const& cj = j;
+    auto const sum = std::transform_reduce(cj.begin(), cj.end(), std::int64_t{0}, std::plus<>(),
+                                           [](json const& v) { return v.as_int(); });
+    EXPECT_EQ(sum, 25);
+
+    json::const_iterator converted = j.begin(); // iterator -> const_iterator
+    EXPECT_EQ(converted, cj.begin());
+}
+
+TEST(JsonIteratorTest, ExecutionPolicyAlgorithms) {
+#if !defined(__cpp_lib_execution)
+    GTEST_SKIP() << "<execution> is not available";
+#else
+    // libstdc++ 的并行策略依赖 TBB; 没有找到 TBB 时 CMake 不定义 JSONPP_TEST_HAS_TBB, 改用顺序策略
+#if JSONPP_TEST_HAS_TBB
+    auto const& policy = std::execution::par_unseq;
+#else
+    auto const& policy = std::execution::seq;
+#endif
+    json j = json::array{};
+    for (int i = 1; i <= 10000; ++i)
+        j.push_back(i);
+    auto const as_int = [](json const& v) { return v.as_int(); };
+
+    // as_array() 的随机访问迭代器可被切分到多个线程
+    auto& arr = j.as_array();
+    std::for_each(policy, arr.begin(), arr.end(), [](json& v) { v.as_int() *= 2; });
+    EXPECT_EQ(std::transform_reduce(policy, arr.cbegin(), arr.cend(), std::int64_t{0}, std::plus<>(), as_int),
+              10000LL * 10001);
+
+    // basic_json 自身的双向迭代器同样满足算法的要求
+    json const& cj = j;
+    EXPECT_EQ(std::transform_reduce(policy, cj.begin(), cj.end(), std::int64_t{0}, std::plus<>(), as_int),
+              10000LL * 10001);
+    auto obj = unordered_json::parse(R"({"a":1,"b":2,"c":3})");
+    std::for_each(policy, obj.begin(), obj.end(), [](unordered_json& v) { v.as_int() += 1; });
+    EXPECT_EQ(std::count_if(policy, obj.cbegin(), obj.cend(), [](unordered_json const& v) { return v.as_int() > 2; }), 2);
+#endif
+}
+
+TEST(JsonIteratorTest, ObjectIteratorsExposeKeys) {
+    auto j = json::parse(R"({"b":2,"a":1,"c":3})");
+    std::string keys;
+    std::int64_t total = 0;
+    for (auto it = j.begin(); it != j.end(); ++it)
+    {
+        keys += it.key();
+        total += it.value().as_int();
+    }
+    EXPECT_EQ(keys, "abc");
+    EXPECT_EQ(total, 6);
+
+    EXPECT_EQ(j.end() - j.begin(), 3);
+    EXPECT_EQ(j.begin() - j.end(), -3);
+    EXPECT_EQ((j.begin() + 2).key(), "c");
+    EXPECT_EQ((j.end() - 3).key(), "a");
+    EXPECT_EQ(j.rbegin()->as_int(), 3);
+
+    for (auto& member : j)
+        member.as_int() += 10;
+    EXPECT_EQ(j.stringify(), R"({"a":11,"b":12,"c":13})");
+
+    // 无序对象的底层迭代器是单向的: 第一次向后移动时记录成员顺序, 之后的 -- 为 O(1)
+    auto u = unordered_json::parse(R"({"x":1,"y":2,"z":3})");
+    auto last = u.end();
+    --last;
+    EXPECT_EQ(std::distance(u.begin(), last), 2);
+    EXPECT_EQ((last - 2), u.begin());
+
+    unordered_json big = unordered_json::object{};
+    for (int i = 0; i < 20000; ++i)
+        big["k" + std::to_string(i)] = i;
+    std::vector<std::string> forward, backward;
+    for (auto it = big.begin(); it != big.end(); ++it)
+        forward.push_back(it.key());
+    for (auto it = big.end(); it != big.begin();)
+        backward.push_back((--it).key());
+    std::reverse(backward.begin(), backward.end());
+    EXPECT_EQ(forward, backward);
+    std::int64_t reverse_sum = 0;
+    for (auto it = big.crbegin(); it != big.crend(); ++it)
+        reverse_sum += it->as_int();
+    EXPECT_EQ(reverse_sum, 19999LL * 20000 / 2);
+
+    // 标量与 null 是空区间
+    json scalar = 5;
+    EXPECT_EQ(scalar.begin(), scalar.end());
+    EXPECT_THROW(j["a"].begin().key(), JsonTypeError);
+}
+
+TEST(JsonIteratorTest, FindInsertAndErase) {
+    auto j = json::parse(R"({"keep":1,"drop":2,"also":3})");
+    auto it = j.find("drop");
+    ASSERT_NE(it, j.end());
+    EXPECT_EQ(it->as_int(), 2);
+    EXPECT_EQ(j.find("missing"), j.end());
+    EXPECT_EQ(j.count("keep"), 1u);
+
+    auto next = j.erase(it);
+    EXPECT_EQ(next.key(), "keep");
+    EXPECT_EQ(j.erase("also"), 1u);
+    EXPECT_EQ(j.stringify(), R"({"keep":1})");
+
+    auto arr = json::parse("[1,2,3,4,5]");
+    auto pos = arr.insert(arr.begin() + 1, json("x"));
+    EXPECT_EQ(pos->as_string(), "x");
+    arr.erase(arr.begin() + 3, arr.end() - 1);
+    EXPECT_EQ(arr.stringify(), R"([1,"x",2,5])");
+    arr.erase(0);
+    EXPECT_EQ(arr.stringify(), R"(["x",2,5])");
+
+    json other = json::array{1};
+    EXPECT_THROW(arr.erase(other.begin()), JsonException);
+}
+
+TEST(JsonLookupTest, StringViewKeys) {
+    static_assert(jsonpp::traits::has_transparent_find_v<json::object>);
+
+    auto j = json::parse(R"({"name":"jsonpp","port":8080,"ratio":0.5,"debug":true})");
+    std::string_view const name = "name";
+    EXPECT_EQ(j[name].as_string(), "jsonpp");
+    EXPECT_EQ(j.at(std::string_view("port")).as_int(), 8080);
+    EXPECT_TRUE(j.contains(std::string_view("debug")));
+    EXPECT_EQ(j.count(std::string_view("missing")), 0u);
+    EXPECT_NE(j.find(std::string_view("ratio")), j.end());
+
+    EXPECT_EQ(j.value("port", 0), 8080);
+    EXPECT_DOUBLE_EQ(j.value("ratio", 1.0), 0.5);
+    EXPECT_EQ(j.value("debug", false), true);
+    EXPECT_EQ(j.value("name", std::string("x")), "jsonpp");
+    EXPECT_EQ(j.value("missing", "fallback"), "fallback");
+    EXPECT_EQ(j.value("missing", 42), 42);
+    EXPECT_THROW(j.value("name", 0), JsonTypeError);
+
+    j[std::string_view("new")] = 1;
+    EXPECT_EQ(j.erase(std::string_view("new")), 1u);
+    EXPECT_EQ(j.erase(std::string_view("new")), 0u);
+
+    json const& cj = j;
+    EXPECT_THROW(cj[std::string_view("missing")], JsonOutOfRange);
+}
+
+TEST(JsonLookupTest, UnorderedStringViewKeys) {
+    auto u = unordered_json::parse(R"({"alpha":1,"beta":2})");
+    std::string_view const key = "beta";
+    EXPECT_EQ(u[key].as_int(), 2);
+    EXPECT_EQ(u.at("alpha").as_int(), 1);
+    EXPECT_TRUE(u.contains(key));
+    EXPECT_FALSE(u.contains("gamma"));
+    EXPECT_EQ(u.value("gamma", 3), 3);
+
+    // 同一字符串内容的 string 与 string_view 哈希一致
+    jsonpp::details::TransparentStringHash hash;
+    EXPECT_EQ(hash(std::string("beta")), hash(key));
+    EXPECT_TRUE(jsonpp::details::TransparentStringEqual{}(std::string("beta"), key));
+
+    u["gamma"] = 3;
+    EXPECT_EQ(u.size(), 3u);
+    EXPECT_EQ(u.erase("alpha"), 1u);
+    EXPECT_FALSE(u.contains("alpha"));
+}
+
+TEST(JsonPointerTest, ParseAndFormat) {
+    json_pointer const ptr("/a~1b/~0c/12/-");
+    ASSERT_EQ(ptr.size(), 4u);
+    EXPECT_EQ(ptr[0].key, "a/b");
+    EXPECT_EQ(ptr[1].key, "~c");
+    EXPECT_TRUE(ptr[2].is_index);
+    EXPECT_EQ(ptr[2].index, 12u);
+    EXPECT_TRUE(ptr[3].is_append);
+    EXPECT_FALSE(json_pointer("/01")[0].is_index);
+    EXPECT_EQ(ptr[0].hash, std::hash<std::string_view>{}("a/b"));
+    EXPECT_EQ(ptr.to_string(), "/a~1b/~0c/12/-");
+    EXPECT_EQ(ptr.parent().to_string(), "/a~1b/~0c/12");
+    EXPECT_EQ((json_pointer() / "x" / std::size_t(3)).to_string(), "/x/3");
+    EXPECT_TRUE(json_pointer("").empty());
+    EXPECT_THROW(json_pointer("a"), JsonException);
+    EXPECT_THROW(json_pointer("/~2"), JsonException);
+}
+
+TEST(JsonPointerTest, ResolveAndDefaults) {
+    auto j = json::parse(R"({"server":{"ports":[80,443],"name":"edge","a/b":{"~":true}},"ratio":0.25})");
+    json_pointer const port("/server/ports/1");
+    json_pointer const name("/server/name");
+    json_pointer const missing("/server/timeout");
+
+    json const& cj = j;
+    EXPECT_EQ(cj.at(port).as_int(), 443);
+    EXPECT_TRUE(cj.at(json_pointer("/server/a~1b/~0")).as_bool());
+    EXPECT_EQ(&cj.at(json_pointer()), &cj);
+    EXPECT_EQ(cj.value(name, "none"), "edge");
+    EXPECT_EQ(cj.value(missing, 30), 30);
+    EXPECT_EQ(cj.value(json_pointer("/server/ports/7"), -1), -1);
+    EXPECT_DOUBLE_EQ(cj.value(json_pointer("/ratio"), 1.0), 0.25);
+    EXPECT_TRUE(cj.contains(port));
+    EXPECT_FALSE(cj.contains(missing));
+    EXPECT_FALSE(cj.contains(json_pointer("/ratio/x")));
+
+    EXPECT_THROW(cj.at(missing), JsonOutOfRange);
+    EXPECT_THROW(cj.at(json_pointer("/server/ports/-")), JsonOutOfRange);
+    EXPECT_THROW(cj.at(json_pointer("/ratio/x")), JsonTypeError);
+
+    j.at(port) = 8443;
+    EXPECT_EQ(j["server"]["ports"][1].as_int(), 8443);
+
+    // 共享存储: 通过指针的可变访问只复制路径上的容器
+    j.share();
+    json copy = j;
+    copy.at(name) = "copy";
+    EXPECT_EQ(cj.at(name).as_string(), "edge");
+    EXPECT_EQ(std::as_const(copy).at(name).as_string(), "copy");
+
+    auto u = unordered_json::parse(R"({"k":{"n":[1,2,3]}})");
+    EXPECT_EQ(std::as_const(u).at(json_pointer("/k/n/2")).as_int(), 3);
+}
+
+TEST(JsonSharedTest, CopiesShareUntilMutated) {
+    auto base = json::parse(R"({"server":{"host":"a","ports":[80,443]},"features":{"x":true,"y":false},"list":[1,2,3]})");
+    base.share();
+    EXPECT_TRUE(base.is_shared());
+    EXPECT_TRUE(base["server"].is_shared());
+    EXPECT_EQ(base.type(), Type::object);
+    EXPECT_TRUE(base.is_object());
+
+    json const& cbase = base;
+    json copy = cbase;
+    EXPECT_TRUE(copy.shares_storage_with(cbase));
+    EXPECT_EQ(copy, cbase);
+
+    copy["server"]["host"] = "b";
+    EXPECT_EQ(cbase["server"]["host"].as_string(), "a");
+    EXPECT_EQ(copy["server"]["host"].as_string(), "b");
+    EXPECT_FALSE(copy.shares_storage_with(cbase));
+    // 只有修改路径上的容器被复制, 其余子树仍然共享
+    json const& ccopy = copy;
+    EXPECT_TRUE(ccopy["features"].shares_storage_with(cbase["features"]));
+    EXPECT_TRUE(ccopy["server"]["ports"].shares_storage_with(cbase["server"]["ports"]));
+    EXPECT_FALSE(ccopy["server"].shares_storage_with(cbase["server"]));
+
+    copy["list"].push_back(4);
+    EXPECT_EQ(cbase["list"].size(), 3u);
+    EXPECT_EQ(ccopy["list"].size(), 4u);
+    EXPECT_EQ(cbase.stringify(), R"({"features":{"x":true,"y":false},"list":[1,2,3],"server":{"host":"a","ports":[80,443]}})");
+    EXPECT_EQ(cbase.hash(), json::parse(cbase.stringify()).hash());
+    EXPECT_NE(ccopy, cbase);
+}
+
+TEST(JsonSharedTest, IteratorsAndErase) {
+    auto base = json::parse(R"({"a":[1,2,3,4],"b":{"k1":1,"k2":2,"k3":3}})");
+    base.share();
+    json copy = base;
+
+    // 从 const 视图取得的迭代器, 修改时会换算到复制出的容器
+    auto& arr = copy["a"];
+    json shared_arr = arr; // 让数组再次被共享
+    json const& cview = arr;
+    arr.erase(cview.begin() + 1, cview.begin() + 3);
+    EXPECT_EQ(arr.stringify(), "[1,4]");
+    EXPECT_EQ(shared_arr.stringify(), "[1,2,3,4]");
+
+    auto& obj = copy["b"];
+    json shared_obj = obj;
+    json const& cobj = obj;
+    obj.erase(cobj.find("k2"));
+    EXPECT_EQ(obj.stringify(), R"({"k1":1,"k3":3})");
+    EXPECT_EQ(shared_obj.stringify(), R"({"k1":1,"k2":2,"k3":3})");
+
+    std::int64_t sum = 0;
+    for (auto const& v : std::as_const(shared_arr))
+        sum += v.as_int();
+    EXPECT_EQ(sum, 10);
+    EXPECT_EQ(base.stringify(), R"({"a":[1,2,3,4],"b":{"k1":1,"k2":2,"k3":3}})");
+}
+
+TEST(JsonSharedTest, DeduplicateMergesEqualSubtrees) {
+    auto j = json::parse(R"({"a":{"x":[1,2],"y":"s"},"b":{"x":[1,2],"y":"s"},"c":[[1,2],[1,2],[3]]})");
+    auto const expected = j.stringify();
+    j.deduplicate();
+    json const& cj = j;
+    EXPECT_TRUE(cj["a"].shares_storage_with(cj["b"]));
+    EXPECT_TRUE(cj["c"][0].shares_storage_with(cj["c"][1]));
+    EXPECT_TRUE(cj["c"][0].shares_storage_with(cj["a"]["x"]));
+    EXPECT_FALSE(cj["c"][0].shares_storage_with(cj["c"][2]));
+    EXPECT_EQ(cj.stringify(), expected);
+
+    j["a"]["x"].push_back(3);
+    EXPECT_EQ(cj["b"]["x"].size(), 2u);
+    EXPECT_EQ(cj["c"][1].size(), 2u);
+
+    // 共享存储的差异计算可以直接跳过相同的子树
+    json copy = cj;
+    copy["c"][2] = 4;
+    EXPECT_EQ(json::diff(cj, copy), json::parse(R"([{"op":"replace","path":"/c/2","value":4}])"));
+}
+
+TEST(JsonSnapshotHolderTest, PublishAndPin) {
+    json_snapshot_holder<json> holder(json::parse(R"({"v":0})"));
+    EXPECT_EQ(holder.version(), 0u);
+    {
+        auto pinned = holder.read();
+        EXPECT_EQ((*pinned)["v"].as_int(), 0);
+
+        holder.publish(json::parse(R"({"v":1})"));
+        EXPECT_EQ(holder.version(), 1u);
+        EXPECT_EQ(holder.read()->at("v").as_int(), 1);
+        EXPECT_EQ(pinned->at("v").as_int(), 0); // 旧版本在读者离开前保持有效
+        EXPECT_EQ(pinned.version(), 0u);
+    }
+
+    // 最后一个读者离开后旧版本被释放
+    std::weak_ptr<json const> old = holder.load();
+    holder.publish(json::parse(R"({"v":2})"));
+    holder.synchronize();
+    EXPECT_TRUE(old.expired());
+
+    // load() 返回的指针可以长期持有, 不阻塞回收
+    auto kept = holder.load();
+    holder.update([](json& doc) { doc["v"] = 3; });
+    holder.synchronize();
+    EXPECT_EQ(kept->at("v").as_int(), 2);
+    EXPECT_EQ(holder.read()->at("v").as_int(), 3);
+}
+
+TEST(JsonSnapshotHolderTest, ConcurrentReadersSeeConsistentVersions) {
+    json initial = json::object{};
+    initial["a"] = 0;
+    initial["b"] = 0;
+    initial["payload"] = json::parse(R"({"list":[1,2,3],"name":"config"})");
+    initial.share();
+    json_snapshot_holder<json> holder(std::move(initial));
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<std::int64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]
+        {
+            std::int64_t last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                auto doc = holder.read();
+                auto const a = doc->at("a").as_int();
+                if (a != doc->at("b").as_int() || a < last || doc->at("payload").at("list").size() != 3)
+                    inconsistent.fetch_add(1);
+                last = a;
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (int i = 1; i <= 2000; ++i)
+    {
+        holder.update([i](json& doc)
+        {
+            doc["a"] = i;
+            doc["b"] = i;
+        });
+    }
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+    holder.synchronize();
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+    EXPECT_EQ(holder.read()->at("a").as_int(), 2000);
+    EXPECT_EQ(holder.version(), 2000u);
+}